@@ -25,10 +25,18 @@ CREATE OR REPLACE FUNCTION add_drop_chunks_policy(hypertable REGCLASS, older_tha
 AS '@MODULE_PATHNAME@', 'ts_add_drop_chunks_policy'
 LANGUAGE C VOLATILE STRICT;
 
-CREATE OR REPLACE FUNCTION add_reorder_policy(hypertable REGCLASS, index_name NAME, if_not_exists BOOL = false) RETURNS INTEGER
+CREATE OR REPLACE FUNCTION add_reorder_policy(hypertable REGCLASS, index_name NAME, if_not_exists BOOL = false, max_workers INTEGER = 1) RETURNS INTEGER
 AS '@MODULE_PATHNAME@', 'ts_add_reorder_policy'
 LANGUAGE C VOLATILE STRICT;
 
+CREATE OR REPLACE FUNCTION add_move_chunks_policy(hypertable REGCLASS, older_than INTERVAL, destination_tablespace NAME, index_destination_tablespace NAME = NULL, reorder_index_name NAME = NULL, if_not_exists BOOL = false) RETURNS INTEGER
+AS '@MODULE_PATHNAME@', 'ts_add_move_chunks_policy'
+LANGUAGE C VOLATILE;
+
+CREATE OR REPLACE FUNCTION add_deferred_indexes_policy(hypertable REGCLASS, if_not_exists BOOL = false) RETURNS INTEGER
+AS '@MODULE_PATHNAME@', 'ts_add_deferred_indexes_policy'
+LANGUAGE C VOLATILE STRICT;
+
 CREATE OR REPLACE FUNCTION remove_drop_chunks_policy(hypertable REGCLASS, if_exists BOOL = false) RETURNS VOID
 AS '@MODULE_PATHNAME@', 'ts_remove_drop_chunks_policy'
 LANGUAGE C VOLATILE STRICT;
@@ -37,6 +45,14 @@ CREATE OR REPLACE FUNCTION remove_reorder_policy(hypertable REGCLASS, if_exists
 AS '@MODULE_PATHNAME@', 'ts_remove_reorder_policy'
 LANGUAGE C VOLATILE STRICT;
 
+CREATE OR REPLACE FUNCTION remove_move_chunks_policy(hypertable REGCLASS, if_exists BOOL = false) RETURNS VOID
+AS '@MODULE_PATHNAME@', 'ts_remove_move_chunks_policy'
+LANGUAGE C VOLATILE STRICT;
+
+CREATE OR REPLACE FUNCTION remove_deferred_indexes_policy(hypertable REGCLASS, if_exists BOOL = false) RETURNS VOID
+AS '@MODULE_PATHNAME@', 'ts_remove_deferred_indexes_policy'
+LANGUAGE C VOLATILE STRICT;
+
 -- Returns the updated job schedule values
 CREATE OR REPLACE FUNCTION alter_job_schedule(
     job_id INTEGER,
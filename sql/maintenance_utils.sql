@@ -10,3 +10,17 @@ CREATE OR REPLACE FUNCTION reorder_chunk(
     index REGCLASS=NULL,
     verbose BOOLEAN=FALSE
 ) RETURNS VOID AS '@MODULE_PATHNAME@', 'ts_reorder_chunk' LANGUAGE C VOLATILE;
+
+-- chunk - the OID of the chunk to be moved
+-- destination_tablespace - the tablespace to move the chunk to
+-- index_destination_tablespace - the tablespace to move the chunk's indexes
+--         to, or NULL to move them to destination_tablespace
+-- reorder_index - the OID of the index to reorder the chunk on while it is
+--         moved, or NULL to move the chunk without reordering it
+CREATE OR REPLACE FUNCTION move_chunk(
+    chunk REGCLASS,
+    destination_tablespace NAME,
+    index_destination_tablespace NAME=NULL,
+    reorder_index REGCLASS=NULL,
+    verbose BOOLEAN=FALSE
+) RETURNS VOID AS '@MODULE_PATHNAME@', 'ts_move_chunk' LANGUAGE C VOLATILE;
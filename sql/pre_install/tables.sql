@@ -148,6 +148,31 @@ CREATE INDEX IF NOT EXISTS chunk_index_hypertable_id_hypertable_index_name_idx
 ON _timescaledb_catalog.chunk_index(hypertable_id, hypertable_index_name);
 SELECT pg_catalog.pg_extension_config_dump('_timescaledb_catalog.chunk_index', '');
 
+-- Hypertable indexes that are not created on new chunks. They are built on
+-- chunks by the deferred_indexes policy once the chunks fall behind the
+-- write frontier.
+CREATE TABLE IF NOT EXISTS _timescaledb_catalog.deferred_index (
+    hypertable_id         INTEGER NOT NULL REFERENCES _timescaledb_catalog.hypertable(id) ON DELETE CASCADE,
+    hypertable_index_name NAME NOT NULL,
+    PRIMARY KEY(hypertable_id, hypertable_index_name)
+);
+SELECT pg_catalog.pg_extension_config_dump('_timescaledb_catalog.deferred_index', '');
+
+-- Statistics of the data in a chunk, refreshed on ANALYZE and by policies.
+-- min_time and max_time are the range of the time dimension's values in the
+-- chunk, in the same internal representation as dimension slice ranges, or
+-- NULL if the chunk is empty.
+CREATE TABLE IF NOT EXISTS _timescaledb_catalog.chunk_statistics (
+    chunk_id        INTEGER PRIMARY KEY REFERENCES _timescaledb_catalog.chunk(id) ON DELETE CASCADE,
+    min_time        BIGINT NULL,
+    max_time        BIGINT NULL,
+    row_count       BIGINT NOT NULL,
+    total_bytes     BIGINT NOT NULL,
+    last_modified   TIMESTAMPTZ NOT NULL,
+    last_updated    TIMESTAMPTZ NOT NULL
+);
+SELECT pg_catalog.pg_extension_config_dump('_timescaledb_catalog.chunk_statistics', '');
+
 -- Default jobs are given the id space [1,1000). User-installed jobs and any jobs created inside tests
 -- are given the id space [1000, INT_MAX). That way, we do not pg_dump jobs that are always default-installed
 -- inside other .sql scripts. This avoids insertion conflicts during pg_restore.
@@ -163,7 +188,7 @@ CREATE TABLE IF NOT EXISTS _timescaledb_config.bgw_job (
     max_runtime         INTERVAL    NOT NULL,
     max_retries         INT         NOT NULL,
     retry_period        INTERVAL    NOT NULL,
-    CONSTRAINT  valid_job_type CHECK (job_type IN ('telemetry_and_version_check_if_enabled', 'reorder', 'drop_chunks'))
+    CONSTRAINT  valid_job_type CHECK (job_type IN ('telemetry_and_version_check_if_enabled', 'reorder', 'drop_chunks', 'move_chunks', 'deferred_indexes'))
 );
 ALTER SEQUENCE _timescaledb_config.bgw_job_id_seq OWNED BY _timescaledb_config.bgw_job.id;
 
@@ -190,7 +215,8 @@ CREATE TABLE IF NOT EXISTS _timescaledb_internal.bgw_job_stat (
 CREATE TABLE IF NOT EXISTS _timescaledb_config.bgw_policy_reorder (
     job_id          		INTEGER     PRIMARY KEY REFERENCES _timescaledb_config.bgw_job(id) ON DELETE CASCADE,
     hypertable_id   		INTEGER     UNIQUE NOT NULL    REFERENCES _timescaledb_catalog.hypertable(id) ON DELETE CASCADE,
-	hypertable_index_name	NAME		NOT NULL
+	hypertable_index_name	NAME		NOT NULL,
+	max_workers				INTEGER		NOT NULL DEFAULT 1 CHECK (max_workers > 0)
 );
 SELECT pg_catalog.pg_extension_config_dump('_timescaledb_config.bgw_policy_reorder', '');
 
@@ -202,6 +228,22 @@ CREATE TABLE IF NOT EXISTS _timescaledb_config.bgw_policy_drop_chunks (
 );
 SELECT pg_catalog.pg_extension_config_dump('_timescaledb_config.bgw_policy_drop_chunks', '');
 
+CREATE TABLE IF NOT EXISTS _timescaledb_config.bgw_policy_move_chunks (
+    job_id                          INTEGER     PRIMARY KEY REFERENCES _timescaledb_config.bgw_job(id) ON DELETE CASCADE,
+    hypertable_id                   INTEGER     UNIQUE NOT NULL REFERENCES _timescaledb_catalog.hypertable(id) ON DELETE CASCADE,
+    older_than                      INTERVAL    NOT NULL,
+    destination_tablespace          NAME        NOT NULL,
+    index_destination_tablespace    NAME        NOT NULL,
+    reorder_index_name              NAME
+);
+SELECT pg_catalog.pg_extension_config_dump('_timescaledb_config.bgw_policy_move_chunks', '');
+
+CREATE TABLE IF NOT EXISTS _timescaledb_config.bgw_policy_deferred_indexes (
+    job_id          INTEGER     PRIMARY KEY REFERENCES _timescaledb_config.bgw_job(id) ON DELETE CASCADE,
+    hypertable_id   INTEGER     UNIQUE NOT NULL REFERENCES _timescaledb_catalog.hypertable(id) ON DELETE CASCADE
+);
+SELECT pg_catalog.pg_extension_config_dump('_timescaledb_config.bgw_policy_deferred_indexes', '');
+
 ----- End BGW policy table definitions
 
 -- Now we define a special stats table for each job/chunk pair. This will be used by the scheduler
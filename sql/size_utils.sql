@@ -24,50 +24,7 @@ RETURNS TABLE (table_bytes BIGINT,
                index_bytes BIGINT,
                toast_bytes BIGINT,
                total_bytes BIGINT
-               ) LANGUAGE PLPGSQL STABLE STRICT
-               AS
-$BODY$
-DECLARE
-        table_name       NAME;
-        schema_name      NAME;
-BEGIN
-        SELECT relname, nspname
-        INTO STRICT table_name, schema_name
-        FROM pg_class c
-        INNER JOIN pg_namespace n ON (n.OID = c.relnamespace)
-        WHERE c.OID = main_table;
-
-        RETURN QUERY EXECUTE format(
-        $$
-        SELECT table_bytes,
-               index_bytes,
-               toast_bytes,
-               total_bytes
-               FROM (
-               SELECT *, total_bytes-index_bytes-COALESCE(toast_bytes,0) AS table_bytes FROM (
-                      SELECT
-                      sum(pg_total_relation_size(format('%%I.%%I', c.schema_name, c.table_name)))::bigint as total_bytes,
-                      sum(pg_indexes_size(format('%%I.%%I', c.schema_name, c.table_name)))::bigint AS index_bytes,
-                      sum(pg_total_relation_size(reltoastrelid))::bigint AS toast_bytes
-                      FROM
-                      _timescaledb_catalog.hypertable h,
-                      _timescaledb_catalog.chunk c,
-                      pg_class pgc,
-                      pg_namespace pns
-                      WHERE h.schema_name = %L
-                      AND h.table_name = %L
-                      AND c.hypertable_id = h.id
-                      AND pgc.relname = h.table_name
-                      AND pns.oid = pgc.relnamespace
-                      AND pns.nspname = h.schema_name
-                      AND relkind = 'r'
-                      ) sub1
-               ) sub2;
-        $$,
-        schema_name, table_name);
-
-END;
-$BODY$;
+               ) AS '@MODULE_PATHNAME@', 'ts_hypertable_relation_size' LANGUAGE C STABLE STRICT;
 
 CREATE OR REPLACE FUNCTION _timescaledb_internal.range_value_to_pretty(
     time_value      BIGINT,
@@ -181,71 +138,7 @@ RETURNS TABLE (chunk_id INT,
                index_bytes BIGINT,
                toast_bytes BIGINT,
                total_bytes BIGINT)
-               LANGUAGE PLPGSQL STABLE STRICT
-               AS
-$BODY$
-DECLARE
-        table_name       NAME;
-        schema_name      NAME;
-BEGIN
-        SELECT relname, nspname
-        INTO STRICT table_name, schema_name
-        FROM pg_class c
-        INNER JOIN pg_namespace n ON (n.OID = c.relnamespace)
-        WHERE c.OID = main_table;
-
-        RETURN QUERY EXECUTE format(
-        $$
-
-        SELECT chunk_id,
-        chunk_table,
-        partitioning_columns,
-        partitioning_column_types,
-        partitioning_hash_functions,
-        ranges,
-        table_bytes,
-        index_bytes,
-        toast_bytes,
-        total_bytes
-        FROM (
-        SELECT *,
-              total_bytes-index_bytes-COALESCE(toast_bytes,0) AS table_bytes
-              FROM (
-               SELECT c.id as chunk_id,
-               format('%%I.%%I', c.schema_name, c.table_name) as chunk_table,
-               pg_total_relation_size(format('%%I.%%I', c.schema_name, c.table_name)) AS total_bytes,
-               pg_indexes_size(format('%%I.%%I', c.schema_name, c.table_name)) AS index_bytes,
-               pg_total_relation_size(reltoastrelid) AS toast_bytes,
-               array_agg(d.column_name ORDER BY d.interval_length, d.column_name ASC) as partitioning_columns,
-               array_agg(d.column_type ORDER BY d.interval_length, d.column_name ASC) as partitioning_column_types,
-               array_agg(d.partitioning_func_schema || '.' || d.partitioning_func ORDER BY d.interval_length, d.column_name ASC) as partitioning_hash_functions,
-               array_agg(int8range(range_start, range_end) ORDER BY d.interval_length, d.column_name ASC) as ranges
-               FROM
-               _timescaledb_catalog.hypertable h,
-               _timescaledb_catalog.chunk c,
-               _timescaledb_catalog.chunk_constraint cc,
-               _timescaledb_catalog.dimension d,
-               _timescaledb_catalog.dimension_slice ds,
-               pg_class pgc,
-               pg_namespace pns
-               WHERE h.schema_name = %L
-                     AND h.table_name = %L
-                     AND pgc.relname = c.table_name
-                     AND pns.oid = pgc.relnamespace
-                     AND pns.nspname = c.schema_name
-                     AND relkind = 'r'
-                     AND c.hypertable_id = h.id
-                     AND c.id = cc.chunk_id
-                     AND cc.dimension_slice_id = ds.id
-                     AND ds.dimension_id = d.id
-               GROUP BY c.id, pgc.reltoastrelid, pgc.oid ORDER BY c.id
-               ) sub1
-        ) sub2;
-        $$,
-        schema_name, table_name);
-
-END;
-$BODY$;
+               AS '@MODULE_PATHNAME@', 'ts_chunk_relation_size' LANGUAGE C STABLE STRICT;
 
 -- Get relation size of the chunks of an hypertable
 -- like pg_relation_size
@@ -283,68 +176,23 @@ RETURNS TABLE (chunk_id INT,
                LANGUAGE PLPGSQL STABLE STRICT
                AS
 $BODY$
-DECLARE
-        table_name       NAME;
-        schema_name      NAME;
 BEGIN
-        SELECT relname, nspname
-        INTO STRICT table_name, schema_name
-        FROM pg_class c
-        INNER JOIN pg_namespace n ON (n.OID = c.relnamespace)
-        WHERE c.OID = main_table;
-
-        RETURN QUERY EXECUTE format(
-        $$
-
-        SELECT chunk_id,
-        chunk_table,
-        partitioning_columns,
-        partitioning_column_types,
-        partitioning_functions,
-        ranges,
-        pg_size_pretty(table_bytes) AS table,
-        pg_size_pretty(index_bytes) AS index,
-        pg_size_pretty(toast_bytes) AS toast,
-        pg_size_pretty(total_bytes) AS total
-        FROM (
-        SELECT *,
-              total_bytes-index_bytes-COALESCE(toast_bytes,0) AS table_bytes
-              FROM (
-               SELECT c.id as chunk_id,
-               format('%%I.%%I', c.schema_name, c.table_name) as chunk_table,
-               pg_total_relation_size(format('%%I.%%I', c.schema_name, c.table_name)) AS total_bytes,
-               pg_indexes_size(format('%%I.%%I', c.schema_name, c.table_name)) AS index_bytes,
-               pg_total_relation_size(reltoastrelid) AS toast_bytes,
-               array_agg(d.column_name ORDER BY d.interval_length, d.column_name ASC) as partitioning_columns,
-               array_agg(d.column_type ORDER BY d.interval_length, d.column_name ASC) as partitioning_column_types,
-               array_agg(d.partitioning_func_schema || '.' || d.partitioning_func ORDER BY d.interval_length, d.column_name ASC) as partitioning_functions,
-               array_agg('[' || _timescaledb_internal.range_value_to_pretty(range_start, column_type) ||
-                         ',' ||
-                         _timescaledb_internal.range_value_to_pretty(range_end, column_type) || ')' ORDER BY d.interval_length, d.column_name ASC) as ranges
-               FROM
-               _timescaledb_catalog.hypertable h,
-               _timescaledb_catalog.chunk c,
-               _timescaledb_catalog.chunk_constraint cc,
-               _timescaledb_catalog.dimension d,
-               _timescaledb_catalog.dimension_slice ds,
-               pg_class pgc,
-               pg_namespace pns
-               WHERE h.schema_name = %L
-                     AND h.table_name = %L
-                     AND pgc.relname = c.table_name
-                     AND pns.oid = pgc.relnamespace
-                     AND pns.nspname = c.schema_name
-                     AND relkind = 'r'
-                     AND c.hypertable_id = h.id
-                     AND c.id = cc.chunk_id
-                     AND cc.dimension_slice_id = ds.id
-                     AND ds.dimension_id = d.id
-               GROUP BY c.id, pgc.reltoastrelid, pgc.oid ORDER BY c.id
-               ) sub1
-        ) sub2;
-        $$,
-        schema_name, table_name);
-
+        RETURN QUERY
+        SELECT s.chunk_id,
+               s.chunk_table,
+               s.partitioning_columns,
+               s.partitioning_column_types,
+               s.partitioning_hash_functions,
+               (SELECT array_agg('[' || _timescaledb_internal.range_value_to_pretty(lower(r.slice_range), r.column_type) ||
+                                 ',' ||
+                                 _timescaledb_internal.range_value_to_pretty(upper(r.slice_range), r.column_type) || ')'
+                                 ORDER BY r.ord)
+                FROM unnest(s.ranges, s.partitioning_column_types) WITH ORDINALITY AS r(slice_range, column_type, ord)),
+               pg_size_pretty(s.table_bytes),
+               pg_size_pretty(s.index_bytes),
+               pg_size_pretty(s.toast_bytes),
+               pg_size_pretty(s.total_bytes)
+        FROM @extschema@.chunk_relation_size(main_table) s;
 END;
 $BODY$;
 
@@ -362,39 +210,7 @@ CREATE OR REPLACE FUNCTION indexes_relation_size(
 )
 RETURNS TABLE (index_name TEXT,
                total_bytes BIGINT)
-               LANGUAGE PLPGSQL STABLE STRICT
-               AS
-$BODY$
-<<main>>
-DECLARE
-        table_name       NAME;
-        schema_name      NAME;
-BEGIN
-        SELECT relname, nspname
-        INTO STRICT table_name, schema_name
-        FROM pg_class c
-        INNER JOIN pg_namespace n ON (n.OID = c.relnamespace)
-        WHERE c.OID = main_table;
-
-        RETURN QUERY
-        SELECT format('%I.%I', h.schema_name, ci.hypertable_index_name),
-               sum(pg_relation_size(c.oid))::bigint
-        FROM
-        pg_class c,
-        pg_namespace n,
-        _timescaledb_catalog.hypertable h,
-        _timescaledb_catalog.chunk ch,
-        _timescaledb_catalog.chunk_index ci
-        WHERE ch.schema_name = n.nspname
-            AND c.relnamespace = n.oid
-            AND c.relname = ci.index_name
-            AND ch.id = ci.chunk_id
-            AND h.id = ci.hypertable_id
-            AND h.schema_name = main.schema_name
-            AND h.table_name = main.table_name
-        GROUP BY h.schema_name, ci.hypertable_index_name;
-END;
-$BODY$;
+               AS '@MODULE_PATHNAME@', 'ts_indexes_relation_size' LANGUAGE C STABLE STRICT;
 
 
 -- Get sizes of indexes on a hypertable
@@ -436,38 +252,4 @@ CREATE OR REPLACE FUNCTION hypertable_approximate_row_count(
     RETURNS TABLE (schema_name NAME,
                    table_name NAME,
                    row_estimate BIGINT
-                  ) LANGUAGE PLPGSQL VOLATILE
-    AS
-$BODY$
-<<main>>
-DECLARE
-        table_name       NAME;
-        schema_name      NAME;
-BEGIN
-        IF main_table IS NOT NULL THEN
-            SELECT relname, nspname
-            INTO STRICT table_name, schema_name
-            FROM pg_class c
-            INNER JOIN pg_namespace n ON (n.OID = c.relnamespace)
-            WHERE c.OID = main_table;
-        END IF;
-
--- Thanks to @fvannee on Github for providing the initial draft
--- of this query
-        RETURN QUERY
-        SELECT h.schema_name,
-            h.table_name,
-            row_estimate.row_estimate
-        FROM _timescaledb_catalog.hypertable h
-        CROSS JOIN LATERAL (
-            SELECT sum(cl.reltuples)::BIGINT AS row_estimate
-            FROM _timescaledb_catalog.chunk c
-            JOIN pg_class cl ON cl.relname = c.table_name
-            WHERE c.hypertable_id = h.id
-            GROUP BY h.schema_name, h.table_name
-        ) row_estimate
-        WHERE (main.table_name IS NULL OR h.table_name = main.table_name)
-        AND (main.schema_name IS NULL OR h.schema_name = main.schema_name)
-        ORDER BY h.schema_name, h.table_name;
-END
-$BODY$;
+                  ) AS '@MODULE_PATHNAME@', 'ts_hypertable_approximate_row_count' LANGUAGE C VOLATILE;
@@ -0,0 +1,15 @@
+-- This file and its contents are licensed under the Apache License 2.0.
+-- Please see the included NOTICE for copyright information and
+-- LICENSE-APACHE for a copy of the license.
+
+-- Counters of the current backend for chunk routing, chunk creation,
+-- catalog scans and chunk exclusion. See timescaledb_information.stats.
+CREATE OR REPLACE FUNCTION _timescaledb_internal.stats(
+    OUT name TEXT,
+    OUT calls BIGINT,
+    OUT total_time DOUBLE PRECISION
+) RETURNS SETOF RECORD AS '@MODULE_PATHNAME@', 'ts_stats_get' LANGUAGE C VOLATILE;
+
+-- Reset the counters of the current backend
+CREATE OR REPLACE FUNCTION _timescaledb_internal.stats_reset() RETURNS VOID
+AS '@MODULE_PATHNAME@', 'ts_stats_reset' LANGUAGE C VOLATILE;
@@ -2,3 +2,56 @@
 -- we add an addition optional argument to locf
 DROP FUNCTION IF EXISTS locf(ANYELEMENT,ANYELEMENT);
 
+-- reorder policies can reorder several chunks concurrently
+ALTER TABLE _timescaledb_config.bgw_policy_reorder
+    ADD COLUMN max_workers INTEGER NOT NULL DEFAULT 1 CHECK (max_workers > 0);
+DROP FUNCTION IF EXISTS add_reorder_policy(REGCLASS, NAME, BOOL);
+
+-- move_chunks policies relocate old chunks to another tablespace
+ALTER TABLE _timescaledb_config.bgw_job DROP CONSTRAINT valid_job_type;
+ALTER TABLE _timescaledb_config.bgw_job ADD CONSTRAINT valid_job_type
+    CHECK (job_type IN ('telemetry_and_version_check_if_enabled', 'reorder', 'drop_chunks', 'move_chunks'));
+
+CREATE TABLE IF NOT EXISTS _timescaledb_config.bgw_policy_move_chunks (
+    job_id                          INTEGER     PRIMARY KEY REFERENCES _timescaledb_config.bgw_job(id) ON DELETE CASCADE,
+    hypertable_id                   INTEGER     UNIQUE NOT NULL REFERENCES _timescaledb_catalog.hypertable(id) ON DELETE CASCADE,
+    older_than                      INTERVAL    NOT NULL,
+    destination_tablespace          NAME        NOT NULL,
+    index_destination_tablespace    NAME        NOT NULL,
+    reorder_index_name              NAME
+);
+SELECT pg_catalog.pg_extension_config_dump('_timescaledb_config.bgw_policy_move_chunks', '');
+GRANT SELECT ON _timescaledb_config.bgw_policy_move_chunks TO PUBLIC;
+
+-- per-chunk statistics
+CREATE TABLE IF NOT EXISTS _timescaledb_catalog.chunk_statistics (
+    chunk_id        INTEGER PRIMARY KEY REFERENCES _timescaledb_catalog.chunk(id) ON DELETE CASCADE,
+    min_time        BIGINT NULL,
+    max_time        BIGINT NULL,
+    row_count       BIGINT NOT NULL,
+    total_bytes     BIGINT NOT NULL,
+    last_modified   TIMESTAMPTZ NOT NULL,
+    last_updated    TIMESTAMPTZ NOT NULL
+);
+SELECT pg_catalog.pg_extension_config_dump('_timescaledb_catalog.chunk_statistics', '');
+GRANT SELECT ON _timescaledb_catalog.chunk_statistics TO PUBLIC;
+
+-- deferred indexes are built on chunks behind the write frontier by a policy
+ALTER TABLE _timescaledb_config.bgw_job DROP CONSTRAINT valid_job_type;
+ALTER TABLE _timescaledb_config.bgw_job ADD CONSTRAINT valid_job_type
+    CHECK (job_type IN ('telemetry_and_version_check_if_enabled', 'reorder', 'drop_chunks', 'move_chunks', 'deferred_indexes'));
+
+CREATE TABLE IF NOT EXISTS _timescaledb_catalog.deferred_index (
+    hypertable_id         INTEGER NOT NULL REFERENCES _timescaledb_catalog.hypertable(id) ON DELETE CASCADE,
+    hypertable_index_name NAME NOT NULL,
+    PRIMARY KEY(hypertable_id, hypertable_index_name)
+);
+SELECT pg_catalog.pg_extension_config_dump('_timescaledb_catalog.deferred_index', '');
+GRANT SELECT ON _timescaledb_catalog.deferred_index TO PUBLIC;
+
+CREATE TABLE IF NOT EXISTS _timescaledb_config.bgw_policy_deferred_indexes (
+    job_id          INTEGER     PRIMARY KEY REFERENCES _timescaledb_config.bgw_job(id) ON DELETE CASCADE,
+    hypertable_id   INTEGER     UNIQUE NOT NULL REFERENCES _timescaledb_catalog.hypertable(id) ON DELETE CASCADE
+);
+SELECT pg_catalog.pg_extension_config_dump('_timescaledb_config.bgw_policy_deferred_indexes', '');
+GRANT SELECT ON _timescaledb_config.bgw_policy_deferred_indexes TO PUBLIC;
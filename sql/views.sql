@@ -43,15 +43,38 @@ CREATE OR REPLACE VIEW timescaledb_information.reorder_policies as
     INNER JOIN _timescaledb_catalog.hypertable ht ON p.hypertable_id = ht.id
     INNER JOIN _timescaledb_config.bgw_job j ON p.job_id = j.id;
 
+CREATE OR REPLACE VIEW timescaledb_information.move_chunks_policies as 
+  SELECT format('%1$I.%2$I', ht.schema_name, ht.table_name)::regclass as hypertable, p.older_than, p.destination_tablespace,
+    p.index_destination_tablespace, p.reorder_index_name, p.job_id, j.schedule_interval,
+    j.max_runtime, j.max_retries, j.retry_period
+  FROM _timescaledb_config.bgw_policy_move_chunks p
+    INNER JOIN _timescaledb_catalog.hypertable ht ON p.hypertable_id = ht.id
+    INNER JOIN _timescaledb_config.bgw_job j ON p.job_id = j.id;
+
+CREATE OR REPLACE VIEW timescaledb_information.deferred_indexes_policies as
+  SELECT format('%1$I.%2$I', ht.schema_name, ht.table_name)::regclass as hypertable, p.job_id, j.schedule_interval,
+    j.max_runtime, j.max_retries, j.retry_period
+  FROM _timescaledb_config.bgw_policy_deferred_indexes p
+    INNER JOIN _timescaledb_catalog.hypertable ht ON p.hypertable_id = ht.id
+    INNER JOIN _timescaledb_config.bgw_job j ON p.job_id = j.id;
+
 CREATE OR REPLACE VIEW timescaledb_information.policy_stats as 
   SELECT format('%1$I.%2$I', ht.schema_name, ht.table_name)::regclass as hypertable, p.job_id, j.job_type, js.last_run_success, js.last_finish, js.last_start, js.next_start, 
     js.total_runs, js.total_failures 
   FROM (SELECT job_id, hypertable_id FROM _timescaledb_config.bgw_policy_reorder 
-        UNION SELECT job_id, hypertable_id FROM _timescaledb_config.bgw_policy_drop_chunks) p  
+        UNION SELECT job_id, hypertable_id FROM _timescaledb_config.bgw_policy_drop_chunks
+        UNION SELECT job_id, hypertable_id FROM _timescaledb_config.bgw_policy_move_chunks
+        UNION SELECT job_id, hypertable_id FROM _timescaledb_config.bgw_policy_deferred_indexes) p  
     INNER JOIN _timescaledb_catalog.hypertable ht ON p.hypertable_id = ht.id
     INNER JOIN _timescaledb_config.bgw_job j ON p.job_id = j.id
     INNER JOIN _timescaledb_internal.bgw_job_stat js on p.job_id = js.job_id
   ORDER BY ht.schema_name, ht.table_name;
 
+-- Hot path counters of the current backend. total_time is in milliseconds
+-- and only set for timed counters. Reset with _timescaledb_internal.stats_reset().
+CREATE OR REPLACE VIEW timescaledb_information.stats as
+  SELECT name, calls, total_time
+  FROM _timescaledb_internal.stats();
+
 GRANT USAGE ON SCHEMA timescaledb_information TO PUBLIC;
 GRANT SELECT ON ALL TABLES IN SCHEMA timescaledb_information TO PUBLIC;
@@ -18,11 +18,14 @@
 #include "extension.h"
 #include "compat.h"
 #include "job_stat.h"
+#include "launcher_interface.h"
 #include "license_guc.h"
 #include "utils.h"
 #include "telemetry/telemetry.h"
 #include "bgw_policy/chunk_stats.h"
+#include "bgw_policy/deferred_indexes.h"
 #include "bgw_policy/drop_chunks.h"
+#include "bgw_policy/move_chunks.h"
 #include "bgw_policy/reorder.h"
 
 #include <cross_module_fn.h>
@@ -33,11 +36,14 @@ static const char *job_type_names[_MAX_JOB_TYPE] = {
 	[JOB_TYPE_VERSION_CHECK] = "telemetry_and_version_check_if_enabled",
 	[JOB_TYPE_REORDER] = "reorder",
 	[JOB_TYPE_DROP_CHUNKS] = "drop_chunks",
+	[JOB_TYPE_MOVE_CHUNKS] = "move_chunks",
+	[JOB_TYPE_DEFERRED_INDEXES] = "deferred_indexes",
 	[JOB_TYPE_UNKNOWN] = "unknown",
 };
 
 static unknown_job_type_hook_type unknown_job_type_hook = NULL;
 static char *job_entrypoint_function_name = "ts_bgw_job_entrypoint";
+static char *job_helper_entrypoint_function_name = "ts_bgw_job_helper_entrypoint";
 
 BackgroundWorkerHandle *
 ts_bgw_start_worker(const char *function, const char *name, const char *extra)
@@ -75,6 +81,96 @@ ts_bgw_job_start(BgwJob *job)
 							   job_id_text);
 }
 
+/*
+ * Helpers started by this worker that have not been waited for or terminated
+ * yet. Kept in TopMemoryContext so that the exit callback can still reach
+ * them.
+ */
+static List *running_helpers = NIL;
+static bool helper_exit_callback_registered = false;
+
+/*
+ * Terminate the helpers that are still running when this worker exits and give
+ * their slots back. An ERROR in the job is handled by the caller terminating
+ * its helpers, but a FATAL, e.g., due to the SIGTERM sent when the job
+ * exceeds its max_runtime, exits the worker without returning to the caller.
+ *
+ * We do not wait for the helpers to shut down here, since the postmaster
+ * might not be able to tell us about it while we are exiting. A helper can
+ * therefore run for a short while after its slot was released.
+ */
+static void
+bgw_job_helpers_exit_callback(int code, Datum arg)
+{
+	ListCell *lc;
+
+	foreach (lc, running_helpers)
+	{
+		TerminateBackgroundWorker(lfirst(lc));
+		ts_bgw_worker_release();
+	}
+	running_helpers = NIL;
+}
+
+/*
+ * Start a helper worker that runs one item of a job's work (e.g., one chunk)
+ * next to the job's own worker. Every helper occupies a background worker slot
+ * reserved from the launcher, just like the jobs started by the scheduler, so
+ * helpers never take more workers than timescaledb.max_background_workers.
+ *
+ * Returns NULL if no slot is free or the worker could not be registered. The
+ * caller must end every started helper with ts_bgw_job_wait_helper or
+ * ts_bgw_job_terminate_helper, which give the slot back. Helpers that are
+ * still running when this worker exits are terminated.
+ */
+BackgroundWorkerHandle *
+ts_bgw_job_start_helper(BgwJob *job, int32 item)
+{
+	char extra[BGW_EXTRALEN];
+	BackgroundWorkerHandle *handle;
+	MemoryContext old;
+
+	if (!helper_exit_callback_registered)
+	{
+		before_shmem_exit(bgw_job_helpers_exit_callback, PointerGetDatum(NULL));
+		helper_exit_callback_registered = true;
+	}
+
+	if (!ts_bgw_worker_reserve())
+		return NULL;
+
+	snprintf(extra, BGW_EXTRALEN, "%d %d", job->fd.id, item);
+
+	old = MemoryContextSwitchTo(TopMemoryContext);
+	handle = ts_bgw_start_worker(job_helper_entrypoint_function_name,
+								 NameStr(job->fd.application_name),
+								 extra);
+
+	if (handle == NULL)
+		ts_bgw_worker_release();
+	else
+		running_helpers = lappend(running_helpers, handle);
+	MemoryContextSwitchTo(old);
+
+	return handle;
+}
+
+void
+ts_bgw_job_wait_helper(BackgroundWorkerHandle *handle)
+{
+	WaitForBackgroundWorkerShutdown(handle);
+	running_helpers = list_delete_ptr(running_helpers, handle);
+	ts_bgw_worker_release();
+	pfree(handle);
+}
+
+void
+ts_bgw_job_terminate_helper(BackgroundWorkerHandle *handle)
+{
+	TerminateBackgroundWorker(handle);
+	ts_bgw_job_wait_helper(handle);
+}
+
 static JobType
 get_job_type_from_name(Name job_type_name)
 {
@@ -229,6 +325,8 @@ bgw_job_tuple_delete(TupleInfo *ti, void *data)
 	/* Delete any policy args associated with this job */
 	ts_bgw_policy_reorder_delete_row_only_by_job_id(job_id);
 	ts_bgw_policy_drop_chunks_delete_row_only_by_job_id(job_id);
+	ts_bgw_policy_move_chunks_delete_row_only_by_job_id(job_id);
+	ts_bgw_policy_deferred_indexes_delete_row_only_by_job_id(job_id);
 
 	/* Delete any stats in bgw_policy_chunk_stats related to this job */
 	ts_bgw_policy_chunk_stats_delete_row_only_by_job_id(job_id);
@@ -308,6 +406,8 @@ ts_bgw_job_execute(BgwJob *job)
 		}
 		case JOB_TYPE_REORDER:
 		case JOB_TYPE_DROP_CHUNKS:
+		case JOB_TYPE_MOVE_CHUNKS:
+		case JOB_TYPE_DEFERRED_INDEXES:
 			return ts_cm_functions->bgw_policy_job_execute(job);
 		case JOB_TYPE_UNKNOWN:
 			if (unknown_job_type_hook != NULL)
@@ -358,6 +458,7 @@ static void handle_sigterm(SIGNAL_ARGS)
 }
 
 TS_FUNCTION_INFO_V1(ts_bgw_job_entrypoint);
+TS_FUNCTION_INFO_V1(ts_bgw_job_helper_entrypoint);
 
 static void
 zero_guc(const char *guc_name)
@@ -373,6 +474,22 @@ zero_guc(const char *guc_name)
 				(errcode(ERRCODE_INTERNAL_ERROR), errmsg("could not set \"%s\" guc", guc_name)));
 }
 
+/*
+ * we do not necessarily have a valid parallel worker context in background
+ * workers, so disable parallel execution by default
+ */
+static void
+disable_parallel_execution(void)
+{
+	zero_guc("max_parallel_workers_per_gather");
+#if !PG96
+	zero_guc("max_parallel_workers");
+#endif
+#if !(PG96 || PG10)
+	zero_guc("max_parallel_maintenance_workers");
+#endif
+}
+
 extern Datum
 ts_bgw_job_entrypoint(PG_FUNCTION_ARGS)
 {
@@ -380,7 +497,6 @@ ts_bgw_job_entrypoint(PG_FUNCTION_ARGS)
 	int32 job_id =
 		Int32GetDatum(DirectFunctionCall1(int4in, CStringGetDatum(MyBgworkerEntry->bgw_extra)));
 	BgwJob *job;
-	JobResult res = JOB_FAILURE;
 
 	BackgroundWorkerBlockSignals();
 	/* Setup any signal handlers here */
@@ -407,19 +523,26 @@ ts_bgw_job_entrypoint(PG_FUNCTION_ARGS)
 
 	pgstat_report_appname(NameStr(job->fd.application_name));
 
+	ts_bgw_job_run(job);
+
+	PG_RETURN_VOID();
+}
+
+/*
+ * Run a job in the current background worker and mark its end in the job
+ * stats. This is used both by workers started for a single job and by the
+ * persistent job runners. An error in the job is rethrown after marking the
+ * failure, so the worker exits.
+ */
+void
+ts_bgw_job_run(BgwJob *job)
+{
+	int32 job_id = job->fd.id;
+	JobResult res = JOB_FAILURE;
+
 	PG_TRY();
 	{
-		/*
-		 * we do not necessarily have a valid parallel worker context in
-		 * background workers, so disable parallel execution by default
-		 */
-		zero_guc("max_parallel_workers_per_gather");
-#if !PG96
-		zero_guc("max_parallel_workers");
-#endif
-#if !(PG96 || PG10)
-		zero_guc("max_parallel_maintenance_workers");
-#endif
+		disable_parallel_execution();
 
 		res = ts_bgw_job_execute(job);
 		/* The job is responsible for committing or aborting it's own txns */
@@ -463,6 +586,49 @@ ts_bgw_job_entrypoint(PG_FUNCTION_ARGS)
 	CommitTransactionCommand();
 
 	elog(DEBUG1, "exiting job %d with %s", job_id, (res == JOB_SUCCESS ? "success" : "failure"));
+}
+
+/*
+ * Entrypoint of the helper workers started with ts_bgw_job_start_helper. A
+ * helper runs a single item of the job's work. It does not touch the job's
+ * stats, which are owned by the job's own worker; an error in a helper only
+ * fails that item.
+ */
+extern Datum
+ts_bgw_job_helper_entrypoint(PG_FUNCTION_ARGS)
+{
+	Oid db_oid = DatumGetObjectId(MyBgworkerEntry->bgw_main_arg);
+	int32 job_id;
+	int32 item;
+	BgwJob *job;
+
+	BackgroundWorkerBlockSignals();
+	pqsignal(SIGTERM, handle_sigterm);
+	BackgroundWorkerUnblockSignals();
+
+	if (sscanf(MyBgworkerEntry->bgw_extra, "%d %d", &job_id, &item) != 2)
+		elog(ERROR, "invalid background job helper argument \"%s\"", MyBgworkerEntry->bgw_extra);
+
+	elog(DEBUG1, "started helper for background job %d", job_id);
+
+	BackgroundWorkerInitializeConnectionByOidCompat(db_oid, InvalidOid);
+
+	ts_license_enable_module_loading();
+
+	StartTransactionCommand();
+	job = ts_bgw_job_find(job_id, TopMemoryContext, true);
+	CommitTransactionCommand();
+
+	if (job == NULL)
+		elog(ERROR, "job %d not found", job_id);
+
+	pgstat_report_appname(NameStr(job->fd.application_name));
+
+	disable_parallel_execution();
+
+	ts_cm_functions->bgw_policy_job_execute_helper(job, item);
+
+	elog(DEBUG1, "exiting helper for job %d", job_id);
 
 	PG_RETURN_VOID();
 }
@@ -15,6 +15,8 @@ typedef enum JobType
 	JOB_TYPE_VERSION_CHECK = 0,
 	JOB_TYPE_REORDER,
 	JOB_TYPE_DROP_CHUNKS,
+	JOB_TYPE_MOVE_CHUNKS,
+	JOB_TYPE_DEFERRED_INDEXES,
 	JOB_TYPE_UNKNOWN,
 	_MAX_JOB_TYPE
 } JobType;
@@ -33,6 +35,9 @@ extern BackgroundWorkerHandle *ts_bgw_start_worker(const char *function, const c
 												   const char *extra);
 
 extern BackgroundWorkerHandle *ts_bgw_job_start(BgwJob *job);
+extern TSDLLEXPORT BackgroundWorkerHandle *ts_bgw_job_start_helper(BgwJob *job, int32 item);
+extern TSDLLEXPORT void ts_bgw_job_wait_helper(BackgroundWorkerHandle *handle);
+extern TSDLLEXPORT void ts_bgw_job_terminate_helper(BackgroundWorkerHandle *handle);
 
 extern List *ts_bgw_job_get_all(size_t alloc_size, MemoryContext mctx);
 
@@ -49,8 +54,10 @@ extern TSDLLEXPORT int32 ts_bgw_job_insert_relation(Name application_name, Name
 extern TSDLLEXPORT void ts_bgw_job_update_by_id(int32 job_id, BgwJob *updated_job);
 
 extern bool ts_bgw_job_execute(BgwJob *job);
+extern void ts_bgw_job_run(BgwJob *job);
 
 extern TSDLLEXPORT Datum ts_bgw_job_entrypoint(PG_FUNCTION_ARGS);
+extern TSDLLEXPORT Datum ts_bgw_job_helper_entrypoint(PG_FUNCTION_ARGS);
 extern void ts_bgw_job_set_unknown_job_type_hook(unknown_job_type_hook_type hook);
 extern void ts_bgw_job_set_job_entrypoint_function_name(char *func_name);
 extern bool ts_bgw_job_run_and_set_next_start(BgwJob *job, job_main_func func, int64 initial_runs,
@@ -0,0 +1,485 @@
+/*
+ * This file and its contents are licensed under the Apache License 2.0.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-APACHE for a copy of the license.
+ */
+/*
+ * Persistent job runners.
+ *
+ * Starting a new background worker for every job run pays for the fork,
+ * backend initialization, catalog cache warmup and extension loading on every
+ * run. For jobs with a short schedule interval that cost can be higher than
+ * the job itself. The scheduler can therefore keep a pool of up to
+ * timescaledb.bgw_job_runners workers alive and hand them jobs over a
+ * shm_mq.
+ *
+ * Every runner has its own dynamic shared memory segment with two queues: one
+ * on which the scheduler sends the ID of the job to run, and one on which the
+ * runner reports back the ID of the job it has finished. The runner marks the
+ * start and end of the job in the job stats exactly like a worker started for
+ * a single job, so the scheduler state machine is the same for both. A runner
+ * keeps its background worker slot reserved for as long as it lives.
+ *
+ * A runner exits when
+ *  - the job it runs throws an error (the error is logged and the failure
+ *    marked like for any other job worker),
+ *  - it is terminated by the scheduler (e.g., because the job timed out), or
+ *  - the scheduler detaches from its segment, which happens when the pool
+ *    shrinks or the scheduler exits.
+ * The scheduler notices the dead runner through its background worker handle
+ * and starts a new one the next time it needs one.
+ */
+#include <postgres.h>
+#include <access/xact.h>
+#include <miscadmin.h>
+#include <pgstat.h>
+#include <postmaster/bgworker.h>
+#include <storage/dsm.h>
+#include <storage/ipc.h>
+#include <storage/latch.h>
+#include <storage/proc.h>
+#include <storage/shm_mq.h>
+#include <tcop/tcopprot.h>
+#include <utils/guc.h>
+#include <utils/memutils.h>
+
+#include "compat.h"
+#include "guc.h"
+#include "job.h"
+#include "job_runner.h"
+#include "launcher_interface.h"
+#include "license_guc.h"
+
+#define BGW_JOB_RUNNER_NAME "TimescaleDB Job Runner"
+#define BGW_JOB_RUNNER_QUEUE_SIZE 1024
+#define BGW_JOB_RUNNER_SEGMENT_SIZE (2 * BGW_JOB_RUNNER_QUEUE_SIZE)
+
+/* The assignment queue is first in the segment, followed by the result queue */
+#define ASSIGN_QUEUE(addr) ((shm_mq *) (addr))
+#define RESULT_QUEUE(addr) ((shm_mq *) ((char *) (addr) + BGW_JOB_RUNNER_QUEUE_SIZE))
+
+typedef struct BgwJobRunnerMessage
+{
+	int32 job_id;
+} BgwJobRunnerMessage;
+
+/* Scheduler-side state of a runner */
+struct BgwJobRunner
+{
+	BackgroundWorkerHandle *handle;
+	dsm_segment *seg; /* NULL once the scheduler has detached */
+	shm_mq_handle *assign_mqh;
+	shm_mq_handle *result_mqh;
+	int32 job_id;	 /* job being run, or 0 if idle */
+	bool terminating; /* sent a terminate, never reuse */
+};
+
+TS_FUNCTION_INFO_V1(ts_bgw_job_runner_entrypoint);
+
+static char *job_runner_function_name = "ts_bgw_job_runner_entrypoint";
+
+/* Only exists in the scheduler process */
+static List *runners = NIL;
+
+static volatile sig_atomic_t got_SIGHUP = false;
+
+static BgwJobRunner *
+runner_start(void)
+{
+	BgwJobRunner *runner;
+	BackgroundWorkerHandle *handle;
+	dsm_segment *seg;
+	shm_mq *assign_mq;
+	shm_mq *result_mq;
+	MemoryContext old;
+	char extra[BGW_EXTRALEN];
+
+	if (!ts_bgw_worker_reserve())
+		return NULL;
+
+	/*
+	 * Create the segment in a transaction, since 9.6 requires a resource
+	 * owner, and pin the mapping so that it lives until we detach it.
+	 */
+	StartTransactionCommand();
+	seg = dsm_create(BGW_JOB_RUNNER_SEGMENT_SIZE, DSM_CREATE_NULL_IF_MAXSEGMENTS);
+	if (seg != NULL)
+		dsm_pin_mapping(seg);
+	CommitTransactionCommand();
+
+	if (seg == NULL)
+	{
+		ts_bgw_worker_release();
+		return NULL;
+	}
+
+	assign_mq = shm_mq_create(ASSIGN_QUEUE(dsm_segment_address(seg)), BGW_JOB_RUNNER_QUEUE_SIZE);
+	shm_mq_set_sender(assign_mq, MyProc);
+	result_mq = shm_mq_create(RESULT_QUEUE(dsm_segment_address(seg)), BGW_JOB_RUNNER_QUEUE_SIZE);
+	shm_mq_set_receiver(result_mq, MyProc);
+
+	snprintf(extra, BGW_EXTRALEN, "%u", dsm_segment_handle(seg));
+
+	old = MemoryContextSwitchTo(TopMemoryContext);
+	handle = ts_bgw_start_worker(job_runner_function_name, BGW_JOB_RUNNER_NAME, extra);
+
+	if (handle == NULL)
+	{
+		MemoryContextSwitchTo(old);
+		dsm_detach(seg);
+		ts_bgw_worker_release();
+		return NULL;
+	}
+
+	runner = palloc0(sizeof(BgwJobRunner));
+	runner->handle = handle;
+	runner->seg = seg;
+	/* Passing the handle makes the queues notice if the runner dies */
+	runner->assign_mqh = shm_mq_attach(assign_mq, seg, handle);
+	runner->result_mqh = shm_mq_attach(result_mq, seg, handle);
+	runners = lappend(runners, runner);
+	MemoryContextSwitchTo(old);
+
+	elog(DEBUG1, "started job runner");
+
+	return runner;
+}
+
+static void
+runner_detach(BgwJobRunner *runner)
+{
+	if (runner->seg == NULL)
+		return;
+
+	/* Queue detach happens in dsm detach callback */
+	dsm_detach(runner->seg);
+	runner->seg = NULL;
+	pfree(runner->assign_mqh);
+	pfree(runner->result_mqh);
+	runner->assign_mqh = NULL;
+	runner->result_mqh = NULL;
+}
+
+/*
+ * Stop a runner, wait for it to exit and give back its worker slot. An idle
+ * runner exits by itself once it sees the scheduler detach from its queue.
+ */
+static void
+runner_destroy(BgwJobRunner *runner)
+{
+	if (runner->job_id != 0)
+		TerminateBackgroundWorker(runner->handle);
+
+	runner_detach(runner);
+	WaitForBackgroundWorkerShutdown(runner->handle);
+	ts_bgw_worker_release();
+
+	runners = list_delete_ptr(runners, runner);
+	pfree(runner->handle);
+	pfree(runner);
+}
+
+static bool
+runner_send(BgwJobRunner *runner, int32 job_id)
+{
+	BgwJobRunnerMessage message = { .job_id = job_id };
+
+	/*
+	 * An idle runner has an empty queue, so the (small) message always fits
+	 * without blocking unless the runner has gone away.
+	 */
+	if (shm_mq_send(runner->assign_mqh, sizeof(message), &message, true) != SHM_MQ_SUCCESS)
+		return false;
+
+	runner->job_id = job_id;
+	return true;
+}
+
+/*
+ * Stop idle runners while there are more runners than configured, e.g.,
+ * after timescaledb.bgw_job_runners was lowered. Busy runners are stopped
+ * when they are released.
+ */
+static void
+pool_trim(void)
+{
+	while (list_length(runners) > ts_guc_bgw_job_runners)
+	{
+		BgwJobRunner *idle = NULL;
+		ListCell *lc;
+
+		foreach (lc, runners)
+		{
+			BgwJobRunner *runner = lfirst(lc);
+
+			if (runner->job_id == 0)
+			{
+				idle = runner;
+				break;
+			}
+		}
+
+		if (idle == NULL)
+			break;
+
+		runner_destroy(idle);
+	}
+}
+
+/*
+ * Hand a job to an idle runner, starting a new runner if the pool is not
+ * full. Returns NULL if no runner is available, in which case the caller
+ * should start a background worker for this run only.
+ */
+BgwJobRunner *
+ts_bgw_job_runner_assign(BgwJob *job)
+{
+	BgwJobRunner *runner = NULL;
+	ListCell *lc;
+
+	pool_trim();
+
+	foreach (lc, runners)
+	{
+		BgwJobRunner *candidate = lfirst(lc);
+
+		if (candidate->job_id == 0 && !candidate->terminating && candidate->seg != NULL)
+		{
+			runner = candidate;
+			break;
+		}
+	}
+
+	if (runner == NULL)
+	{
+		if (list_length(runners) >= ts_guc_bgw_job_runners)
+			return NULL;
+
+		runner = runner_start();
+
+		if (runner == NULL)
+			return NULL;
+	}
+
+	if (!runner_send(runner, job->fd.id))
+	{
+		runner_destroy(runner);
+		return NULL;
+	}
+
+	return runner;
+}
+
+void
+ts_bgw_job_runner_set_entrypoint_function_name(char *func_name)
+{
+	job_runner_function_name = func_name;
+}
+
+BackgroundWorkerHandle *
+ts_bgw_job_runner_get_handle(BgwJobRunner *runner)
+{
+	return runner->handle;
+}
+
+/*
+ * Check on the job a runner is running. Returns BGWH_STOPPED once the job has
+ * finished, whether or not the runner is still alive, so that the scheduler
+ * can treat it like a worker started for a single job.
+ */
+BgwHandleStatus
+ts_bgw_job_runner_poll(BgwJobRunner *runner, pid_t *pid)
+{
+	if (runner->job_id != 0 && !runner->terminating && runner->seg != NULL)
+	{
+		BgwJobRunnerMessage *message;
+		Size nbytes;
+
+		if (shm_mq_receive(runner->result_mqh, &nbytes, (void **) &message, true) ==
+			SHM_MQ_SUCCESS)
+		{
+			if (nbytes != sizeof(BgwJobRunnerMessage) || message->job_id != runner->job_id)
+				elog(ERROR, "unexpected message from job runner");
+
+			runner->job_id = 0;
+			*pid = InvalidPid;
+			return BGWH_STOPPED;
+		}
+	}
+
+	return GetBackgroundWorkerPid(runner->handle, pid);
+}
+
+void
+ts_bgw_job_runner_terminate(BgwJobRunner *runner)
+{
+	runner->terminating = true;
+	TerminateBackgroundWorker(runner->handle);
+}
+
+/*
+ * Called when the scheduler is done with the job run by the runner. The runner
+ * goes back to the pool if it is idle and alive, and the pool is not larger
+ * than configured.
+ */
+void
+ts_bgw_job_runner_release(BgwJobRunner *runner)
+{
+	pid_t pid;
+
+	if (runner->job_id != 0 || runner->terminating || runner->seg == NULL ||
+		list_length(runners) > ts_guc_bgw_job_runners ||
+		GetBackgroundWorkerPid(runner->handle, &pid) != BGWH_STARTED)
+		runner_destroy(runner);
+}
+
+/*
+ * Detach from all runners. Runners finish their current job and then exit.
+ */
+void
+ts_bgw_job_runner_pool_detach(void)
+{
+	ListCell *lc;
+
+	foreach (lc, runners)
+		runner_detach(lfirst(lc));
+}
+
+/*
+ * Stop all runners that are left, and wait for them to exit. Called when the
+ * scheduler exits, after all jobs have stopped.
+ */
+void
+ts_bgw_job_runner_pool_shutdown(void)
+{
+	while (runners != NIL)
+		runner_destroy(linitial(runners));
+}
+
+/*
+ * Only used in the scheduler's shmem exit callback. We do not wait for the
+ * runners to exit, and cannot access the database, see
+ * terminate_all_jobs_and_release_workers in scheduler.c.
+ */
+void
+ts_bgw_job_runner_pool_terminate(void)
+{
+	ListCell *lc;
+
+	foreach (lc, runners)
+	{
+		BgwJobRunner *runner = lfirst(lc);
+
+		TerminateBackgroundWorker(runner->handle);
+		ts_bgw_worker_release();
+	}
+	runners = NIL;
+}
+
+static void handle_sigterm(SIGNAL_ARGS)
+{
+	/*
+	 * do not use a level >= ERROR because we don't want to exit here but
+	 * rather only during CHECK_FOR_INTERRUPTS
+	 */
+	ereport(LOG,
+			(errcode(ERRCODE_ADMIN_SHUTDOWN),
+			 errmsg("terminating TimescaleDB job runner due to administrator command")));
+	die(postgres_signal_arg);
+}
+
+static void handle_sighup(SIGNAL_ARGS)
+{
+	int save_errno = errno;
+
+	got_SIGHUP = true;
+	SetLatch(MyLatch);
+
+	errno = save_errno;
+}
+
+extern Datum
+ts_bgw_job_runner_entrypoint(PG_FUNCTION_ARGS)
+{
+	Oid db_oid = DatumGetObjectId(MyBgworkerEntry->bgw_main_arg);
+	dsm_handle handle;
+	dsm_segment *seg;
+	shm_mq_handle *assign_mqh;
+	shm_mq_handle *result_mqh;
+	MemoryContext job_mctx;
+
+	BackgroundWorkerBlockSignals();
+	/* do not use the default `bgworker_die` sigterm handler, see job.c */
+	pqsignal(SIGTERM, handle_sigterm);
+	pqsignal(SIGHUP, handle_sighup);
+	BackgroundWorkerUnblockSignals();
+
+	if (sscanf(MyBgworkerEntry->bgw_extra, "%u", &handle) != 1)
+		elog(ERROR, "invalid job runner argument \"%s\"", MyBgworkerEntry->bgw_extra);
+
+	BackgroundWorkerInitializeConnectionByOidCompat(db_oid, InvalidOid);
+
+	ts_license_enable_module_loading();
+
+	pgstat_report_appname(BGW_JOB_RUNNER_NAME);
+
+	StartTransactionCommand();
+	seg = dsm_attach(handle);
+	if (seg == NULL)
+		ereport(ERROR,
+				(errcode(ERRCODE_OBJECT_NOT_IN_PREREQUISITE_STATE),
+				 errmsg("could not map TimescaleDB job runner dynamic shared memory segment")));
+	dsm_pin_mapping(seg);
+	CommitTransactionCommand();
+
+	shm_mq_set_receiver(ASSIGN_QUEUE(dsm_segment_address(seg)), MyProc);
+	shm_mq_set_sender(RESULT_QUEUE(dsm_segment_address(seg)), MyProc);
+	assign_mqh = shm_mq_attach(ASSIGN_QUEUE(dsm_segment_address(seg)), seg, NULL);
+	result_mqh = shm_mq_attach(RESULT_QUEUE(dsm_segment_address(seg)), seg, NULL);
+
+	job_mctx = AllocSetContextCreate(TopMemoryContext, "Job runner", ALLOCSET_DEFAULT_SIZES);
+
+	elog(DEBUG1, "job runner started");
+
+	for (;;)
+	{
+		BgwJobRunnerMessage *message;
+		BgwJobRunnerMessage result;
+		BgwJob *job;
+		Size nbytes;
+
+		/* Blocks until we get a job, or the scheduler detaches */
+		if (shm_mq_receive(assign_mqh, &nbytes, (void **) &message, false) != SHM_MQ_SUCCESS)
+			break;
+
+		if (nbytes != sizeof(BgwJobRunnerMessage))
+			elog(ERROR, "unexpected message from job scheduler");
+
+		result.job_id = message->job_id;
+
+		if (got_SIGHUP)
+		{
+			got_SIGHUP = false;
+			ProcessConfigFile(PGC_SIGHUP);
+		}
+
+		StartTransactionCommand();
+		job = ts_bgw_job_find(result.job_id, job_mctx, true);
+		CommitTransactionCommand();
+
+		pgstat_report_appname(NameStr(job->fd.application_name));
+
+		/* An error exits the runner, the scheduler will start a new one */
+		ts_bgw_job_run(job);
+
+		pgstat_report_appname(BGW_JOB_RUNNER_NAME);
+		MemoryContextReset(job_mctx);
+
+		if (shm_mq_send(result_mqh, sizeof(result), &result, false) != SHM_MQ_SUCCESS)
+			break;
+	}
+
+	elog(DEBUG1, "job runner exiting");
+
+	PG_RETURN_VOID();
+}
@@ -0,0 +1,31 @@
+/*
+ * This file and its contents are licensed under the Apache License 2.0.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-APACHE for a copy of the license.
+ */
+#ifndef BGW_JOB_RUNNER_H
+#define BGW_JOB_RUNNER_H
+
+#include <postgres.h>
+#include <fmgr.h>
+#include <postmaster/bgworker.h>
+
+#include "export.h"
+#include "job.h"
+
+typedef struct BgwJobRunner BgwJobRunner;
+
+/* called only by the scheduler */
+extern BgwJobRunner *ts_bgw_job_runner_assign(BgwJob *job);
+extern BackgroundWorkerHandle *ts_bgw_job_runner_get_handle(BgwJobRunner *runner);
+extern BgwHandleStatus ts_bgw_job_runner_poll(BgwJobRunner *runner, pid_t *pid);
+extern void ts_bgw_job_runner_terminate(BgwJobRunner *runner);
+extern void ts_bgw_job_runner_release(BgwJobRunner *runner);
+extern void ts_bgw_job_runner_pool_detach(void);
+extern void ts_bgw_job_runner_pool_shutdown(void);
+extern void ts_bgw_job_runner_pool_terminate(void);
+extern void ts_bgw_job_runner_set_entrypoint_function_name(char *func_name);
+
+extern TSDLLEXPORT Datum ts_bgw_job_runner_entrypoint(PG_FUNCTION_ARGS);
+
+#endif /* BGW_JOB_RUNNER_H */
@@ -6,15 +6,23 @@
 /*
  * This is a scheduler that takes background jobs and schedules them appropriately
  *
- * Limitations: For now the jobs are only loaded when the scheduler starts and are not
- * updated if the jobs table changes
+ * Jobs waiting to be started are kept in a min-heap on next_start, so that
+ * finding the next job to start, and rescheduling a job, is O(log n) in the
+ * number of jobs. Jobs that are due are started in ascending next_start order.
+ * Running jobs are kept in a separate list, so that checking for stopped and
+ * timed out jobs only looks at the (few) running jobs.
  *
- * TODO: right now jobs are not prioritized when slots available. Should prioritize in
- * asc next_start order.
+ * Jobs are grouped in classes by job type. A class can have a limit on the
+ * number of its jobs that run concurrently, and a weight. Due jobs of a class
+ * that is at its limit wait until one of the class's jobs stops. Among the
+ * jobs that can be started, the class that has the fewest running jobs
+ * relative to its weight goes first, so that, e.g., long-running drop_chunks
+ * jobs cannot take all workers away from reorder jobs.
  *
  */
 #include <postgres.h>
 
+#include <lib/binaryheap.h>
 #include <miscadmin.h>
 #include <postmaster/bgworker.h>
 #include <storage/ipc.h>
@@ -35,6 +43,7 @@
 #include "guc.h"
 #include "scheduler.h"
 #include "job.h"
+#include "job_runner.h"
 #include "job_stat.h"
 #include "version.h"
 #include "compat.h"
@@ -60,6 +69,24 @@ static bool jobs_list_needs_update;
 /* has to be global to shutdown jobs on exit */
 static List *scheduled_jobs = NIL;
 
+/*
+ * Min-heap, on next_start, of the jobs in JOB_STATE_SCHEDULED, and the list of
+ * jobs in JOB_STATE_STARTED or JOB_STATE_TERMINATING. Both point into
+ * scheduled_jobs and are rebuilt whenever that list is updated. They only
+ * exist in the scheduler process (start_heap is NULL elsewhere).
+ */
+static binaryheap *start_heap = NULL;
+static List *running_jobs = NIL;
+
+/*
+ * Jobs in JOB_STATE_SCHEDULED that are due, but were held back because their
+ * class was at its concurrency limit. They are not in the start heap.
+ */
+static List *waiting_jobs = NIL;
+static MemoryContext scheduler_mctx = NULL;
+
+#define START_HEAP_INITIAL_SIZE 64
+
 /* See the README for a state transition diagram */
 typedef enum JobState
 {
@@ -95,6 +122,12 @@ typedef struct ScheduledBgwJob
 	JobState state;
 	BackgroundWorkerHandle *handle;
 
+	/*
+	 * Set if the job runs in a persistent job runner, in which case handle is
+	 * the runner's and no worker is reserved for the job itself.
+	 */
+	BgwJobRunner *runner;
+
 	bool reserved_worker;
 
 	/*
@@ -102,8 +135,24 @@ typedef struct ScheduledBgwJob
 	 * perform the mark_end
 	 */
 	bool may_need_mark_end;
+
+	/*
+	 * Incremented every time the job is added to the start heap. Entries
+	 * with an older value are stale and skipped when they reach the top.
+	 */
+	uint32 start_heap_seq;
 } ScheduledBgwJob;
 
+/* Entry of the start heap */
+typedef struct StartHeapEntry
+{
+	TimestampTz next_start;
+	ScheduledBgwJob *sjob;
+	uint32 seq;
+} StartHeapEntry;
+
+static void start_heap_push(ScheduledBgwJob *sjob);
+
 static void on_failure_to_start_job(ScheduledBgwJob *sjob);
 
 static volatile sig_atomic_t got_SIGHUP = false;
@@ -144,7 +193,13 @@ worker_state_cleanup(ScheduledBgwJob *sjob)
 	 * This function needs to be safe wrt failures occurring at any point in
 	 * the job starting process.
 	 */
-	if (sjob->handle != NULL)
+	if (sjob->runner != NULL)
+	{
+		ts_bgw_job_runner_release(sjob->runner);
+		sjob->runner = NULL;
+		sjob->handle = NULL;
+	}
+	else if (sjob->handle != NULL)
 	{
 #if USE_ASSERT_CHECKING
 		/* Sanity check: worker has stopped (if it was started) */
@@ -222,7 +277,9 @@ scheduled_bgw_job_transition_state_to(ScheduledBgwJob *sjob, JobState new_state)
 
 			Assert(!sjob->reserved_worker);
 			sjob->next_start = ts_bgw_job_stat_next_start(job_stat, &sjob->job);
-			break;
+			sjob->state = new_state;
+			start_heap_push(sjob);
+			return;
 		case JOB_STATE_STARTED:
 			Assert(prev_state == JOB_STATE_SCHEDULED);
 			Assert(sjob->handle == NULL);
@@ -242,6 +299,17 @@ scheduled_bgw_job_transition_state_to(ScheduledBgwJob *sjob, JobState new_state)
 				sjob->timeout_at = DT_NOEND;
 			CommitTransactionCommand();
 
+			sjob->runner = ts_bgw_job_runner_assign(&sjob->job);
+			if (sjob->runner != NULL)
+			{
+				elog(DEBUG1,
+					 "launching job %d \"%s\" in a job runner",
+					 sjob->job.fd.id,
+					 NameStr(sjob->job.fd.application_name));
+				sjob->handle = ts_bgw_job_runner_get_handle(sjob->runner);
+				break;
+			}
+
 			sjob->reserved_worker = ts_bgw_worker_reserve();
 			if (!sjob->reserved_worker)
 			{
@@ -273,8 +341,11 @@ scheduled_bgw_job_transition_state_to(ScheduledBgwJob *sjob, JobState new_state)
 		case JOB_STATE_TERMINATING:
 			Assert(prev_state == JOB_STATE_STARTED);
 			Assert(sjob->handle != NULL);
-			Assert(sjob->reserved_worker);
-			TerminateBackgroundWorker(sjob->handle);
+			Assert(sjob->reserved_worker || sjob->runner != NULL);
+			if (sjob->runner != NULL)
+				ts_bgw_job_runner_terminate(sjob->runner);
+			else
+				TerminateBackgroundWorker(sjob->handle);
 			break;
 	}
 	sjob->state = new_state;
@@ -322,7 +393,9 @@ scheduled_ts_bgw_job_start(ScheduledBgwJob *sjob,
 		return;
 
 	Assert(sjob->handle != NULL);
-	if (bgw_register != NULL)
+
+	/* A job runner does not exit when the job is done, so it cannot be waited on */
+	if (bgw_register != NULL && sjob->runner == NULL)
 		bgw_register(sjob->handle);
 
 	status = WaitForBackgroundWorkerStartup(sjob->handle, &pid);
@@ -349,7 +422,12 @@ scheduled_ts_bgw_job_start(ScheduledBgwJob *sjob,
 static void
 terminate_and_cleanup_job(ScheduledBgwJob *sjob)
 {
-	if (sjob->handle != NULL)
+	if (sjob->runner != NULL)
+	{
+		ts_bgw_job_runner_terminate(sjob->runner);
+		WaitForBackgroundWorkerShutdown(sjob->handle);
+	}
+	else if (sjob->handle != NULL)
 	{
 		TerminateBackgroundWorker(sjob->handle);
 		WaitForBackgroundWorkerShutdown(sjob->handle);
@@ -453,36 +531,307 @@ ts_populate_scheduled_job_tuple(ScheduledBgwJob *sjob, Datum *values)
 }
 #endif
 
+/*
+ * The heap is a max-heap on the comparator, so order it such that the job
+ * with the earliest next_start comes first. Ties are broken on job ID, to
+ * start jobs that are due at the same time in a stable order.
+ */
+static int
+start_heap_entry_cmp(Datum a, Datum b, void *arg)
+{
+	StartHeapEntry *left = (StartHeapEntry *) DatumGetPointer(a);
+	StartHeapEntry *right = (StartHeapEntry *) DatumGetPointer(b);
+
+	if (left->next_start != right->next_start)
+		return left->next_start < right->next_start ? 1 : -1;
+
+	if (left->sjob->job.fd.id != right->sjob->job.fd.id)
+		return left->sjob->job.fd.id < right->sjob->job.fd.id ? 1 : -1;
+
+	return 0;
+}
+
+static bool
+start_heap_entry_is_valid(StartHeapEntry *entry)
+{
+	return entry->sjob->state == JOB_STATE_SCHEDULED && entry->seq == entry->sjob->start_heap_seq;
+}
+
+/*
+ * Remove all stale entries from the start heap, and grow it if it is still
+ * more than half full after that.
+ */
 static void
-start_scheduled_jobs(register_background_worker_callback_type bgw_register)
+start_heap_compact(void)
+{
+	binaryheap *old_heap = start_heap;
+	int capacity = old_heap->bh_space;
+	int num_valid = 0;
+	int i;
+
+	for (i = 0; i < old_heap->bh_size; i++)
+		if (start_heap_entry_is_valid((StartHeapEntry *) DatumGetPointer(old_heap->bh_nodes[i])))
+			num_valid++;
+
+	if (num_valid >= capacity / 2)
+		capacity *= 2;
+
+	start_heap = binaryheap_allocate(capacity, start_heap_entry_cmp, NULL);
+
+	for (i = 0; i < old_heap->bh_size; i++)
+	{
+		StartHeapEntry *entry = (StartHeapEntry *) DatumGetPointer(old_heap->bh_nodes[i]);
+
+		if (start_heap_entry_is_valid(entry))
+			binaryheap_add_unordered(start_heap, PointerGetDatum(entry));
+		else
+			pfree(entry);
+	}
+
+	binaryheap_build(start_heap);
+	binaryheap_free(old_heap);
+}
+
+static void
+start_heap_push(ScheduledBgwJob *sjob)
+{
+	StartHeapEntry *entry;
+
+	if (start_heap == NULL)
+		return;
+
+	if (start_heap->bh_size >= start_heap->bh_space)
+	{
+		MemoryContext old = MemoryContextSwitchTo(scheduler_mctx);
+
+		start_heap_compact();
+		MemoryContextSwitchTo(old);
+	}
+
+	entry = MemoryContextAlloc(scheduler_mctx, sizeof(StartHeapEntry));
+	entry->next_start = sjob->next_start;
+	entry->sjob = sjob;
+	entry->seq = ++sjob->start_heap_seq;
+	binaryheap_add(start_heap, PointerGetDatum(entry));
+}
+
+/* Returns the first valid entry of the start heap, dropping stale ones */
+static StartHeapEntry *
+start_heap_first(void)
+{
+	while (!binaryheap_empty(start_heap))
+	{
+		StartHeapEntry *entry = (StartHeapEntry *) DatumGetPointer(binaryheap_first(start_heap));
+
+		if (start_heap_entry_is_valid(entry))
+			return entry;
+
+		binaryheap_remove_first(start_heap);
+		pfree(entry);
+	}
+	return NULL;
+}
+
+/*
+ * Drop the start heap and the running jobs list. Must be done before
+ * scheduled_jobs is updated, since that frees the jobs they point to. Jobs
+ * that change state while there is no start heap are picked up by
+ * build_job_queues.
+ */
+static void
+reset_job_queues(void)
+{
+	int i;
+
+	if (start_heap != NULL)
+	{
+		for (i = 0; i < start_heap->bh_size; i++)
+			pfree(DatumGetPointer(start_heap->bh_nodes[i]));
+		binaryheap_free(start_heap);
+		start_heap = NULL;
+	}
+
+	list_free(running_jobs);
+	running_jobs = NIL;
+	list_free(waiting_jobs);
+	waiting_jobs = NIL;
+}
+
+/* Build the start heap and the running jobs list from scheduled_jobs */
+static void
+build_job_queues(void)
 {
+	MemoryContext old = MemoryContextSwitchTo(scheduler_mctx);
 	ListCell *lc;
+	int capacity = START_HEAP_INITIAL_SIZE;
+
+	Assert(start_heap == NULL && running_jobs == NIL);
+
+	while (capacity < list_length(scheduled_jobs))
+		capacity *= 2;
+
+	start_heap = binaryheap_allocate(capacity, start_heap_entry_cmp, NULL);
 
 	foreach (lc, scheduled_jobs)
 	{
 		ScheduledBgwJob *sjob = lfirst(lc);
 
-		if (sjob->state == JOB_STATE_SCHEDULED &&
-			sjob->next_start <= ts_timer_get_current_timestamp())
-			scheduled_ts_bgw_job_start(sjob, bgw_register);
+		switch (sjob->state)
+		{
+			case JOB_STATE_SCHEDULED:
+			{
+				StartHeapEntry *entry = palloc(sizeof(StartHeapEntry));
+
+				entry->next_start = sjob->next_start;
+				entry->sjob = sjob;
+				entry->seq = ++sjob->start_heap_seq;
+				binaryheap_add_unordered(start_heap, PointerGetDatum(entry));
+				break;
+			}
+			case JOB_STATE_STARTED:
+			case JOB_STATE_TERMINATING:
+				running_jobs = lappend(running_jobs, sjob);
+				break;
+			case JOB_STATE_DISABLED:
+				break;
+		}
 	}
+
+	binaryheap_build(start_heap);
+	MemoryContextSwitchTo(old);
 }
 
-/* Returns the earliest time the scheduler should start a job that is waiting to be started */
-static TimestampTz
-earliest_time_to_start_next_job()
+/* Maximum number of concurrently running jobs of a job class, 0 if unlimited */
+static int
+job_class_max_concurrency(JobType type)
 {
+	switch (type)
+	{
+		case JOB_TYPE_REORDER:
+			return ts_guc_bgw_reorder_max_concurrency;
+		case JOB_TYPE_DROP_CHUNKS:
+			return ts_guc_bgw_drop_chunks_max_concurrency;
+		default:
+			return 0;
+	}
+}
+
+static int
+job_class_weight(JobType type)
+{
+	switch (type)
+	{
+		case JOB_TYPE_REORDER:
+			return ts_guc_bgw_reorder_weight;
+		case JOB_TYPE_DROP_CHUNKS:
+			return ts_guc_bgw_drop_chunks_weight;
+		default:
+			return 1;
+	}
+}
+
+/*
+ * Pick the job to start next among the candidates: skip classes that are at
+ * their concurrency limit, and prefer the class with the lowest number of
+ * running jobs per weight. Within a class, jobs are started in next_start
+ * order. Returns NULL if no candidate can be started.
+ */
+static ScheduledBgwJob *
+next_fair_job(List *candidates, int num_running[])
+{
+	ScheduledBgwJob *best = NULL;
 	ListCell *lc;
-	TimestampTz earliest = DT_NOEND;
 
-	foreach (lc, scheduled_jobs)
+	foreach (lc, candidates)
 	{
 		ScheduledBgwJob *sjob = lfirst(lc);
+		JobType type = sjob->job.bgw_type;
+		int max_concurrency = job_class_max_concurrency(type);
+		int64 share;
+		int64 best_share;
 
-		if (sjob->state == JOB_STATE_SCHEDULED)
-			earliest = least_timestamp(earliest, sjob->next_start);
+		if (max_concurrency > 0 && num_running[type] >= max_concurrency)
+			continue;
+
+		if (best == NULL)
+		{
+			best = sjob;
+			continue;
+		}
+
+		/* compare running/weight of the two classes without dividing */
+		share = (int64) num_running[type] * job_class_weight(best->job.bgw_type);
+		best_share = (int64) num_running[best->job.bgw_type] * job_class_weight(type);
+
+		if (share < best_share ||
+			(share == best_share &&
+			 (sjob->next_start < best->next_start ||
+			  (sjob->next_start == best->next_start && sjob->job.fd.id < best->job.fd.id))))
+			best = sjob;
 	}
-	return earliest;
+
+	return best;
+}
+
+static void
+start_scheduled_jobs(register_background_worker_callback_type bgw_register)
+{
+	List *candidates = waiting_jobs;
+	int num_running[_MAX_JOB_TYPE] = { 0 };
+	ScheduledBgwJob *sjob;
+	ListCell *lc;
+	StartHeapEntry *entry;
+
+	/*
+	 * Take all due jobs off the heap before starting any of them, so that a
+	 * job that fails to start and is rescheduled is not retried in the same
+	 * round.
+	 */
+	while ((entry = start_heap_first()) != NULL &&
+		   entry->next_start <= ts_timer_get_current_timestamp())
+	{
+		binaryheap_remove_first(start_heap);
+		candidates = lappend(candidates, entry->sjob);
+		pfree(entry);
+	}
+
+	waiting_jobs = NIL;
+
+	if (candidates == NIL)
+		return;
+
+	foreach (lc, running_jobs)
+	{
+		sjob = lfirst(lc);
+
+		if (sjob->state == JOB_STATE_STARTED || sjob->state == JOB_STATE_TERMINATING)
+			num_running[sjob->job.bgw_type]++;
+	}
+
+	while ((sjob = next_fair_job(candidates, num_running)) != NULL)
+	{
+		candidates = list_delete_ptr(candidates, sjob);
+
+		scheduled_ts_bgw_job_start(sjob, bgw_register);
+
+		if (sjob->state == JOB_STATE_STARTED)
+		{
+			running_jobs = lappend(running_jobs, sjob);
+			num_running[sjob->job.bgw_type]++;
+		}
+	}
+
+	/* The rest is held back by class limits until a running job stops */
+	waiting_jobs = candidates;
+}
+
+/* Returns the earliest time the scheduler should start a job that is waiting to be started */
+static TimestampTz
+earliest_time_to_start_next_job()
+{
+	StartHeapEntry *entry = start_heap_first();
+
+	return entry == NULL ? DT_NOEND : entry->next_start;
 }
 
 /* Returns the earliest time the scheduler needs to kill a job according to its timeout  */
@@ -492,7 +841,7 @@ earliest_job_timeout()
 	ListCell *lc;
 	TimestampTz earliest = DT_NOEND;
 
-	foreach (lc, scheduled_jobs)
+	foreach (lc, running_jobs)
 	{
 		ScheduledBgwJob *sjob = lfirst(lc);
 
@@ -531,6 +880,8 @@ terminate_all_jobs_and_release_workers()
 			sjob->reserved_worker = false;
 		}
 	}
+
+	ts_bgw_job_runner_pool_terminate();
 }
 
 static void
@@ -551,8 +902,9 @@ static void
 check_for_stopped_and_timed_out_jobs()
 {
 	ListCell *lc;
+	List *still_running = NIL;
 
-	foreach (lc, scheduled_jobs)
+	foreach (lc, running_jobs)
 	{
 		BgwHandleStatus status;
 		pid_t pid;
@@ -562,7 +914,10 @@ check_for_stopped_and_timed_out_jobs()
 		if (sjob->state != JOB_STATE_STARTED && sjob->state != JOB_STATE_TERMINATING)
 			continue;
 
-		status = GetBackgroundWorkerPid(sjob->handle, &pid);
+		if (sjob->runner != NULL)
+			status = ts_bgw_job_runner_poll(sjob->runner, &pid);
+		else
+			status = GetBackgroundWorkerPid(sjob->handle, &pid);
 
 		switch (status)
 		{
@@ -590,7 +945,13 @@ check_for_stopped_and_timed_out_jobs()
 				Assert(sjob->state != JOB_STATE_STARTED);
 				break;
 		}
+
+		if (sjob->state == JOB_STATE_STARTED || sjob->state == JOB_STATE_TERMINATING)
+			still_running = lappend(still_running, sjob);
 	}
+
+	list_free(running_jobs);
+	running_jobs = still_running;
 }
 
 /* This is the guts of the scheduler which runs the main loop.
@@ -605,12 +966,15 @@ ts_bgw_scheduler_process(int32 run_for_interval_ms,
 {
 	TimestampTz start = ts_timer_get_current_timestamp();
 	TimestampTz quit_time = DT_NOEND;
-	MemoryContext scheduler_mctx = CurrentMemoryContext;
+
+	scheduler_mctx = CurrentMemoryContext;
 
 	/* txn to read the list of jobs from the DB */
+	reset_job_queues();
 	StartTransactionCommand();
 	scheduled_jobs = ts_update_scheduled_jobs_list(scheduled_jobs, scheduler_mctx);
 	CommitTransactionCommand();
+	build_job_queues();
 
 	jobs_list_needs_update = false;
 
@@ -653,9 +1017,11 @@ ts_bgw_scheduler_process(int32 run_for_interval_ms,
 		/* txn to read the list of jobs from the DB */
 		if (jobs_list_needs_update)
 		{
+			reset_job_queues();
 			StartTransactionCommand();
 			scheduled_jobs = ts_update_scheduled_jobs_list(scheduled_jobs, scheduler_mctx);
 			CommitTransactionCommand();
+			build_job_queues();
 			jobs_list_needs_update = false;
 		}
 
@@ -669,8 +1035,11 @@ ts_bgw_scheduler_process(int32 run_for_interval_ms,
 
 	CHECK_FOR_INTERRUPTS();
 
+	/* Job runners exit once they have finished their current job */
+	ts_bgw_job_runner_pool_detach();
 	wait_for_all_jobs_to_shutdown();
 	check_for_stopped_and_timed_out_jobs();
+	ts_bgw_job_runner_pool_shutdown();
 }
 
 static void
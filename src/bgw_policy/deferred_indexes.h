@@ -0,0 +1,25 @@
+/*
+ * This file and its contents are licensed under the Apache License 2.0.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-APACHE for a copy of the license.
+ */
+
+#ifndef TIMESCALEDB_BGW_POLICY_DEFERRED_INDEXES_H
+#define TIMESCALEDB_BGW_POLICY_DEFERRED_INDEXES_H
+
+#include "catalog.h"
+#include "export.h"
+
+typedef struct BgwPolicyDeferredIndexes
+{
+	FormData_bgw_policy_deferred_indexes fd;
+} BgwPolicyDeferredIndexes;
+
+extern TSDLLEXPORT BgwPolicyDeferredIndexes *
+ts_bgw_policy_deferred_indexes_find_by_job(int32 job_id);
+extern TSDLLEXPORT BgwPolicyDeferredIndexes *
+ts_bgw_policy_deferred_indexes_find_by_hypertable(int32 hypertable_id);
+extern TSDLLEXPORT void ts_bgw_policy_deferred_indexes_insert(BgwPolicyDeferredIndexes *policy);
+extern TSDLLEXPORT bool ts_bgw_policy_deferred_indexes_delete_row_only_by_job_id(int32 job_id);
+
+#endif /* TIMESCALEDB_BGW_POLICY_DEFERRED_INDEXES_H */
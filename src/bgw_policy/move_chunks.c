@@ -0,0 +1,174 @@
+/*
+ * This file and its contents are licensed under the Apache License 2.0.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-APACHE for a copy of the license.
+ */
+
+#include <postgres.h>
+#include <utils/builtins.h>
+#include <utils/timestamp.h>
+#include <utils/lsyscache.h>
+#include <utils/syscache.h>
+
+#include "catalog.h"
+#include "policy.h"
+#include "move_chunks.h"
+#include "scanner.h"
+#include "utils.h"
+#include "hypertable.h"
+#include "bgw/job.h"
+
+/*
+ * The reorder_index_name column is nullable, so the tuple cannot be copied
+ * into the form struct directly.
+ */
+static ScanTupleResult
+bgw_policy_move_chunks_tuple_found(TupleInfo *ti, void *const data)
+{
+	BgwPolicyMoveChunks **policy = data;
+	Datum values[Natts_bgw_policy_move_chunks];
+	bool nulls[Natts_bgw_policy_move_chunks];
+	MemoryContext old = MemoryContextSwitchTo(ti->mctx);
+
+	heap_deform_tuple(ti->tuple, ti->desc, values, nulls);
+
+	*policy = palloc0(sizeof(BgwPolicyMoveChunks));
+	(*policy)->fd.job_id =
+		DatumGetInt32(values[AttrNumberGetAttrOffset(Anum_bgw_policy_move_chunks_job_id)]);
+	(*policy)->fd.hypertable_id =
+		DatumGetInt32(values[AttrNumberGetAttrOffset(Anum_bgw_policy_move_chunks_hypertable_id)]);
+	(*policy)->fd.older_than = *DatumGetIntervalP(
+		values[AttrNumberGetAttrOffset(Anum_bgw_policy_move_chunks_older_than)]);
+	namecpy(&(*policy)->fd.destination_tablespace,
+			DatumGetName(values[AttrNumberGetAttrOffset(
+				Anum_bgw_policy_move_chunks_destination_tablespace)]));
+	namecpy(&(*policy)->fd.index_destination_tablespace,
+			DatumGetName(values[AttrNumberGetAttrOffset(
+				Anum_bgw_policy_move_chunks_index_destination_tablespace)]));
+
+	if (!nulls[AttrNumberGetAttrOffset(Anum_bgw_policy_move_chunks_reorder_index_name)])
+		namecpy(&(*policy)->fd.reorder_index_name,
+				DatumGetName(values[AttrNumberGetAttrOffset(
+					Anum_bgw_policy_move_chunks_reorder_index_name)]));
+
+	MemoryContextSwitchTo(old);
+
+	return SCAN_CONTINUE;
+}
+
+/*
+ * To prevent infinite recursive calls from the job <-> policy tables, we do not cascade deletes in
+ * this function. Instead, the caller must be responsible for making sure that the delete cascades
+ * to the job corresponding to this policy.
+ */
+bool
+ts_bgw_policy_move_chunks_delete_row_only_by_job_id(int32 job_id)
+{
+	ScanKeyData scankey[1];
+
+	ScanKeyInit(&scankey[0],
+				Anum_bgw_policy_move_chunks_pkey_idx_job_id,
+				BTEqualStrategyNumber,
+				F_INT4EQ,
+				Int32GetDatum(job_id));
+
+	return ts_catalog_scan_one(BGW_POLICY_MOVE_CHUNKS,
+							   BGW_POLICY_MOVE_CHUNKS_PKEY_IDX,
+							   scankey,
+							   1,
+							   ts_bgw_policy_delete_row_only_tuple_found,
+							   RowExclusiveLock,
+							   BGW_POLICY_MOVE_CHUNKS_TABLE_NAME,
+							   NULL);
+}
+
+BgwPolicyMoveChunks *
+ts_bgw_policy_move_chunks_find_by_job(int32 job_id)
+{
+	ScanKeyData scankey[1];
+	BgwPolicyMoveChunks *ret = NULL;
+
+	ScanKeyInit(&scankey[0],
+				Anum_bgw_policy_move_chunks_pkey_idx_job_id,
+				BTEqualStrategyNumber,
+				F_INT4EQ,
+				Int32GetDatum(job_id));
+
+	ts_catalog_scan_one(BGW_POLICY_MOVE_CHUNKS,
+						BGW_POLICY_MOVE_CHUNKS_PKEY_IDX,
+						scankey,
+						1,
+						bgw_policy_move_chunks_tuple_found,
+						RowExclusiveLock,
+						BGW_POLICY_MOVE_CHUNKS_TABLE_NAME,
+						(void *) &ret);
+
+	return ret;
+}
+
+BgwPolicyMoveChunks *
+ts_bgw_policy_move_chunks_find_by_hypertable(int32 hypertable_id)
+{
+	ScanKeyData scankey[1];
+	BgwPolicyMoveChunks *ret = NULL;
+
+	ScanKeyInit(&scankey[0],
+				Anum_bgw_policy_move_chunks_hypertable_id_idx_hypertable_id,
+				BTEqualStrategyNumber,
+				F_INT4EQ,
+				Int32GetDatum(hypertable_id));
+
+	ts_catalog_scan_one(BGW_POLICY_MOVE_CHUNKS,
+						BGW_POLICY_MOVE_CHUNKS_HYPERTABLE_ID_IDX,
+						scankey,
+						1,
+						bgw_policy_move_chunks_tuple_found,
+						RowExclusiveLock,
+						BGW_POLICY_MOVE_CHUNKS_TABLE_NAME,
+						(void *) &ret);
+
+	return ret;
+}
+
+static void
+ts_bgw_policy_move_chunks_insert_with_relation(Relation rel, BgwPolicyMoveChunks *policy)
+{
+	TupleDesc tupdesc;
+	CatalogSecurityContext sec_ctx;
+	Datum values[Natts_bgw_policy_move_chunks];
+	bool nulls[Natts_bgw_policy_move_chunks] = { false };
+
+	tupdesc = RelationGetDescr(rel);
+
+	values[AttrNumberGetAttrOffset(Anum_bgw_policy_move_chunks_job_id)] =
+		Int32GetDatum(policy->fd.job_id);
+	values[AttrNumberGetAttrOffset(Anum_bgw_policy_move_chunks_hypertable_id)] =
+		Int32GetDatum(policy->fd.hypertable_id);
+	values[AttrNumberGetAttrOffset(Anum_bgw_policy_move_chunks_older_than)] =
+		IntervalPGetDatum(&policy->fd.older_than);
+	values[AttrNumberGetAttrOffset(Anum_bgw_policy_move_chunks_destination_tablespace)] =
+		NameGetDatum(&policy->fd.destination_tablespace);
+	values[AttrNumberGetAttrOffset(Anum_bgw_policy_move_chunks_index_destination_tablespace)] =
+		NameGetDatum(&policy->fd.index_destination_tablespace);
+
+	if (NameStr(policy->fd.reorder_index_name)[0] == '\0')
+		nulls[AttrNumberGetAttrOffset(Anum_bgw_policy_move_chunks_reorder_index_name)] = true;
+	else
+		values[AttrNumberGetAttrOffset(Anum_bgw_policy_move_chunks_reorder_index_name)] =
+			NameGetDatum(&policy->fd.reorder_index_name);
+
+	ts_catalog_database_info_become_owner(ts_catalog_database_info_get(), &sec_ctx);
+	ts_catalog_insert_values(rel, tupdesc, values, nulls);
+	ts_catalog_restore_user(&sec_ctx);
+}
+
+void
+ts_bgw_policy_move_chunks_insert(BgwPolicyMoveChunks *policy)
+{
+	Catalog *catalog = ts_catalog_get();
+	Relation rel =
+		heap_open(catalog_get_table_id(catalog, BGW_POLICY_MOVE_CHUNKS), RowExclusiveLock);
+
+	ts_bgw_policy_move_chunks_insert_with_relation(rel, policy);
+	heap_close(rel, RowExclusiveLock);
+}
@@ -0,0 +1,24 @@
+/*
+ * This file and its contents are licensed under the Apache License 2.0.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-APACHE for a copy of the license.
+ */
+
+#ifndef TIMESCALEDB_BGW_POLICY_MOVE_CHUNKS_H
+#define TIMESCALEDB_BGW_POLICY_MOVE_CHUNKS_H
+
+#include "catalog.h"
+#include "export.h"
+
+typedef struct BgwPolicyMoveChunks
+{
+	FormData_bgw_policy_move_chunks fd;
+} BgwPolicyMoveChunks;
+
+extern TSDLLEXPORT BgwPolicyMoveChunks *ts_bgw_policy_move_chunks_find_by_job(int32 job_id);
+extern TSDLLEXPORT BgwPolicyMoveChunks *
+ts_bgw_policy_move_chunks_find_by_hypertable(int32 hypertable_id);
+extern TSDLLEXPORT void ts_bgw_policy_move_chunks_insert(BgwPolicyMoveChunks *policy);
+extern TSDLLEXPORT bool ts_bgw_policy_move_chunks_delete_row_only_by_job_id(int32 job_id);
+
+#endif /* TIMESCALEDB_BGW_POLICY_MOVE_CHUNKS_H */
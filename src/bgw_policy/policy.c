@@ -9,6 +9,8 @@
 #include "policy.h"
 #include "bgw_policy/reorder.h"
 #include "bgw_policy/drop_chunks.h"
+#include "bgw_policy/move_chunks.h"
+#include "bgw_policy/deferred_indexes.h"
 #include "bgw/job.h"
 
 void
@@ -28,6 +30,16 @@ ts_bgw_policy_delete_by_hypertable_id(int32 hypertable_id)
 
 	if (policy)
 		ts_bgw_job_delete_by_id(((BgwPolicyDropChunks *) policy)->fd.job_id);
+
+	policy = ts_bgw_policy_move_chunks_find_by_hypertable(hypertable_id);
+
+	if (policy)
+		ts_bgw_job_delete_by_id(((BgwPolicyMoveChunks *) policy)->fd.job_id);
+
+	policy = ts_bgw_policy_deferred_indexes_find_by_hypertable(hypertable_id);
+
+	if (policy)
+		ts_bgw_job_delete_by_id(((BgwPolicyDeferredIndexes *) policy)->fd.job_id);
 }
 
 /* This function does NOT cascade deletes to the bgw_job table. */
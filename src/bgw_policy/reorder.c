@@ -118,6 +118,8 @@ ts_bgw_policy_reorder_insert_with_relation(Relation rel, BgwPolicyReorder *polic
 		Int32GetDatum(policy->fd.hypertable_id);
 	values[AttrNumberGetAttrOffset(Anum_bgw_policy_reorder_hypertable_index_name)] =
 		NameGetDatum(&policy->fd.hypertable_index_name);
+	values[AttrNumberGetAttrOffset(Anum_bgw_policy_reorder_max_workers)] =
+		Int32GetDatum(policy->fd.max_workers);
 
 	ts_catalog_database_info_become_owner(ts_catalog_database_info_get(), &sec_ctx);
 	ts_catalog_insert_values(rel, tupdesc, values, nulls);
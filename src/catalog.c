@@ -74,10 +74,26 @@ static const TableInfoDef catalog_table_names[_MAX_CATALOG_TABLES + 1] = {
 		.schema_name = CONFIG_SCHEMA_NAME,
 		.table_name = BGW_POLICY_DROP_CHUNKS_TABLE_NAME,
 	},
+	[BGW_POLICY_MOVE_CHUNKS] = {
+		.schema_name = CONFIG_SCHEMA_NAME,
+		.table_name = BGW_POLICY_MOVE_CHUNKS_TABLE_NAME,
+	},
 	[BGW_POLICY_CHUNK_STATS] = {
 		.schema_name = INTERNAL_SCHEMA_NAME,
 		.table_name = BGW_POLICY_CHUNK_STATS_TABLE_NAME,
 	},
+	[CHUNK_STATISTICS] = {
+		.schema_name = CATALOG_SCHEMA_NAME,
+		.table_name = CHUNK_STATISTICS_TABLE_NAME,
+	},
+	[DEFERRED_INDEX] = {
+		.schema_name = CATALOG_SCHEMA_NAME,
+		.table_name = DEFERRED_INDEX_TABLE_NAME,
+	},
+	[BGW_POLICY_DEFERRED_INDEXES] = {
+		.schema_name = CONFIG_SCHEMA_NAME,
+		.table_name = BGW_POLICY_DEFERRED_INDEXES_TABLE_NAME,
+	},
 	[_MAX_CATALOG_TABLES] = {
 		.schema_name = "invalid schema",
 		.table_name = "invalid table",
@@ -167,12 +183,38 @@ static const TableIndexDef catalog_table_index_definitions[_MAX_CATALOG_TABLES]
 			[BGW_POLICY_DROP_CHUNKS_HYPERTABLE_ID_IDX] = "bgw_policy_drop_chunks_hypertable_id_key",
 		},
 	},
+	[BGW_POLICY_MOVE_CHUNKS] = {
+		.length = _MAX_BGW_POLICY_MOVE_CHUNKS_INDEX,
+		.names = (char *[]) {
+			[BGW_POLICY_MOVE_CHUNKS_PKEY_IDX] = "bgw_policy_move_chunks_pkey",
+			[BGW_POLICY_MOVE_CHUNKS_HYPERTABLE_ID_IDX] = "bgw_policy_move_chunks_hypertable_id_key",
+		},
+	},
 	[BGW_POLICY_CHUNK_STATS] = {
 		.length = _MAX_BGW_POLICY_CHUNK_STATS_INDEX,
 		.names = (char *[]) {
 			[BGW_POLICY_CHUNK_STATS_JOB_ID_CHUNK_ID_IDX] = "bgw_policy_chunk_stats_job_id_chunk_id_key",
 		},
 	},
+	[CHUNK_STATISTICS] = {
+		.length = _MAX_CHUNK_STATISTICS_INDEX,
+		.names = (char *[]) {
+			[CHUNK_STATISTICS_PKEY_IDX] = "chunk_statistics_pkey",
+		},
+	},
+	[DEFERRED_INDEX] = {
+		.length = _MAX_DEFERRED_INDEX_INDEX,
+		.names = (char *[]) {
+			[DEFERRED_INDEX_PKEY_IDX] = "deferred_index_pkey",
+		},
+	},
+	[BGW_POLICY_DEFERRED_INDEXES] = {
+		.length = _MAX_BGW_POLICY_DEFERRED_INDEXES_INDEX,
+		.names = (char *[]) {
+			[BGW_POLICY_DEFERRED_INDEXES_PKEY_IDX] = "bgw_policy_deferred_indexes_pkey",
+			[BGW_POLICY_DEFERRED_INDEXES_HYPERTABLE_ID_IDX] = "bgw_policy_deferred_indexes_hypertable_id_key",
+		},
+	},
 };
 
 static const char *catalog_table_serial_id_names[_MAX_CATALOG_TABLES] = {
@@ -187,6 +229,8 @@ static const char *catalog_table_serial_id_names[_MAX_CATALOG_TABLES] = {
 	[BGW_JOB_STAT] = NULL,
 	[BGW_POLICY_REORDER] = NULL,
 	[BGW_POLICY_DROP_CHUNKS] = NULL,
+	[BGW_POLICY_MOVE_CHUNKS] = NULL,
+	[BGW_POLICY_DEFERRED_INDEXES] = NULL,
 };
 
 typedef struct InternalFunctionDef
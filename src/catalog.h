@@ -43,7 +43,11 @@ typedef enum CatalogTable
 	INSTALLATION_METADATA,
 	BGW_POLICY_REORDER,
 	BGW_POLICY_DROP_CHUNKS,
+	BGW_POLICY_MOVE_CHUNKS,
 	BGW_POLICY_CHUNK_STATS,
+	CHUNK_STATISTICS,
+	DEFERRED_INDEX,
+	BGW_POLICY_DEFERRED_INDEXES,
 	_MAX_CATALOG_TABLES,
 } CatalogTable;
 
@@ -633,6 +637,7 @@ enum Anum_bgw_policy_reorder
 	Anum_bgw_policy_reorder_job_id = 1,
 	Anum_bgw_policy_reorder_hypertable_id,
 	Anum_bgw_policy_reorder_hypertable_index_name,
+	Anum_bgw_policy_reorder_max_workers,
 	_Anum_bgw_policy_reorder_max,
 };
 
@@ -643,6 +648,7 @@ typedef struct FormData_bgw_policy_reorder
 	int32 job_id;
 	int32 hypertable_id;
 	NameData hypertable_index_name;
+	int32 max_workers;
 } FormData_bgw_policy_reorder;
 
 typedef FormData_bgw_policy_reorder *Form_bgw_policy_reorder;
@@ -729,6 +735,67 @@ typedef struct FormData_bgw_policy_drop_chunks_hypertable_id_idx
 	int32 hypertable_id;
 } FormData_bgw_policy_drop_chunks_hypertable_id_idx;
 
+/****** BGW_POLICY_MOVE_CHUNKS TABLE definitions */
+#define BGW_POLICY_MOVE_CHUNKS_TABLE_NAME "bgw_policy_move_chunks"
+
+enum Anum_bgw_policy_move_chunks
+{
+	Anum_bgw_policy_move_chunks_job_id = 1,
+	Anum_bgw_policy_move_chunks_hypertable_id,
+	Anum_bgw_policy_move_chunks_older_than,
+	Anum_bgw_policy_move_chunks_destination_tablespace,
+	Anum_bgw_policy_move_chunks_index_destination_tablespace,
+	Anum_bgw_policy_move_chunks_reorder_index_name,
+	_Anum_bgw_policy_move_chunks_max,
+};
+
+#define Natts_bgw_policy_move_chunks (_Anum_bgw_policy_move_chunks_max - 1)
+
+/*
+ * reorder_index_name is NULL when chunks are moved without reordering them,
+ * which is represented by an empty name here.
+ */
+typedef struct FormData_bgw_policy_move_chunks
+{
+	int32 job_id;
+	int32 hypertable_id;
+	Interval older_than;
+	NameData destination_tablespace;
+	NameData index_destination_tablespace;
+	NameData reorder_index_name;
+} FormData_bgw_policy_move_chunks;
+
+typedef FormData_bgw_policy_move_chunks *Form_bgw_policy_move_chunks;
+
+enum
+{
+	BGW_POLICY_MOVE_CHUNKS_PKEY_IDX = 0,
+	BGW_POLICY_MOVE_CHUNKS_HYPERTABLE_ID_IDX,
+	_MAX_BGW_POLICY_MOVE_CHUNKS_INDEX,
+};
+
+enum Anum_bgw_policy_move_chunks_pkey_idx
+{
+	Anum_bgw_policy_move_chunks_pkey_idx_job_id = 1,
+	_Anum_bgw_policy_move_chunks_pkey_idx_max,
+};
+
+typedef struct FormData_bgw_policy_move_chunks_pkey_idx
+{
+	int32 job_id;
+} FormData_bgw_policy_move_chunks_pkey_idx;
+
+enum Anum_bgw_policy_move_chunks_hypertable_id_idx
+{
+	Anum_bgw_policy_move_chunks_hypertable_id_idx_hypertable_id = 1,
+	_Anum_bgw_policy_move_chunks_hypertable_id_idx_max,
+};
+
+typedef struct FormData_bgw_policy_move_chunks_hypertable_id_idx
+{
+	int32 hypertable_id;
+} FormData_bgw_policy_move_chunks_hypertable_id_idx;
+
 /****** BGW_POLICY_CHUNK_STATS TABLE definitions */
 #define BGW_POLICY_CHUNK_STATS_TABLE_NAME "bgw_policy_chunk_stats"
 
@@ -772,6 +839,131 @@ typedef struct FormData_bgw_policy_chunk_stats_job_id_chunk_id_idx
 	int32 chunk_id;
 } FormData_bgw_policy_chunk_stats_job_id_chunk_id_idx;
 
+/************************************
+ *
+ * Chunk statistics table definitions
+ *
+ ************************************/
+
+#define CHUNK_STATISTICS_TABLE_NAME "chunk_statistics"
+
+enum Anum_chunk_statistics
+{
+	Anum_chunk_statistics_chunk_id = 1,
+	Anum_chunk_statistics_min_time,
+	Anum_chunk_statistics_max_time,
+	Anum_chunk_statistics_row_count,
+	Anum_chunk_statistics_total_bytes,
+	Anum_chunk_statistics_last_modified,
+	Anum_chunk_statistics_last_updated,
+	_Anum_chunk_statistics_max,
+};
+
+#define Natts_chunk_statistics (_Anum_chunk_statistics_max - 1)
+
+/* Do not use GETSTRUCT with FormData_chunk_statistics. It contains NULLs */
+typedef struct FormData_chunk_statistics
+{
+	int32 chunk_id;
+	int64 min_time;
+	int64 max_time;
+	int64 row_count;
+	int64 total_bytes;
+	TimestampTz last_modified;
+	TimestampTz last_updated;
+} FormData_chunk_statistics;
+
+typedef FormData_chunk_statistics *Form_chunk_statistics;
+
+enum
+{
+	CHUNK_STATISTICS_PKEY_IDX = 0,
+	_MAX_CHUNK_STATISTICS_INDEX,
+};
+
+enum Anum_chunk_statistics_pkey_idx
+{
+	Anum_chunk_statistics_pkey_idx_chunk_id = 1,
+	_Anum_chunk_statistics_pkey_idx_max,
+};
+
+/************************************
+ *
+ * Deferred index table definitions
+ *
+ ************************************/
+
+#define DEFERRED_INDEX_TABLE_NAME "deferred_index"
+
+enum Anum_deferred_index
+{
+	Anum_deferred_index_hypertable_id = 1,
+	Anum_deferred_index_hypertable_index_name,
+	_Anum_deferred_index_max,
+};
+
+#define Natts_deferred_index (_Anum_deferred_index_max - 1)
+
+typedef struct FormData_deferred_index
+{
+	int32 hypertable_id;
+	NameData hypertable_index_name;
+} FormData_deferred_index;
+
+typedef FormData_deferred_index *Form_deferred_index;
+
+enum
+{
+	DEFERRED_INDEX_PKEY_IDX = 0,
+	_MAX_DEFERRED_INDEX_INDEX,
+};
+
+enum Anum_deferred_index_pkey_idx
+{
+	Anum_deferred_index_pkey_idx_hypertable_id = 1,
+	Anum_deferred_index_pkey_idx_hypertable_index_name,
+	_Anum_deferred_index_pkey_idx_max,
+};
+
+/****** BGW_POLICY_DEFERRED_INDEXES TABLE definitions */
+#define BGW_POLICY_DEFERRED_INDEXES_TABLE_NAME "bgw_policy_deferred_indexes"
+
+enum Anum_bgw_policy_deferred_indexes
+{
+	Anum_bgw_policy_deferred_indexes_job_id = 1,
+	Anum_bgw_policy_deferred_indexes_hypertable_id,
+	_Anum_bgw_policy_deferred_indexes_max,
+};
+
+#define Natts_bgw_policy_deferred_indexes (_Anum_bgw_policy_deferred_indexes_max - 1)
+
+typedef struct FormData_bgw_policy_deferred_indexes
+{
+	int32 job_id;
+	int32 hypertable_id;
+} FormData_bgw_policy_deferred_indexes;
+
+typedef FormData_bgw_policy_deferred_indexes *Form_bgw_policy_deferred_indexes;
+
+enum
+{
+	BGW_POLICY_DEFERRED_INDEXES_PKEY_IDX = 0,
+	BGW_POLICY_DEFERRED_INDEXES_HYPERTABLE_ID_IDX,
+	_MAX_BGW_POLICY_DEFERRED_INDEXES_INDEX,
+};
+
+enum Anum_bgw_policy_deferred_indexes_pkey_idx
+{
+	Anum_bgw_policy_deferred_indexes_pkey_idx_job_id = 1,
+	_Anum_bgw_policy_deferred_indexes_pkey_idx_max,
+};
+
+enum Anum_bgw_policy_deferred_indexes_hypertable_id_idx
+{
+	Anum_bgw_policy_deferred_indexes_hypertable_id_idx_hypertable_id = 1,
+	_Anum_bgw_policy_deferred_indexes_hypertable_id_idx_max,
+};
+
 /*
  * The maximum number of indexes a catalog table can have.
  * This needs to be bumped in case of new catalog tables that have more indexes.
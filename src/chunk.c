@@ -4,6 +4,7 @@
  * LICENSE-APACHE for a copy of the license.
  */
 #include <postgres.h>
+#include <catalog/dependency.h>
 #include <catalog/namespace.h>
 #include <catalog/pg_trigger.h>
 #include <catalog/indexing.h>
@@ -44,6 +45,7 @@
 #include "hypertable.h"
 #include "hypercube.h"
 #include "scanner.h"
+#include "stats.h"
 #include "process_utility.h"
 #include "trigger.h"
 #include "compat.h"
@@ -51,6 +53,7 @@
 #include "hypertable_cache.h"
 #include "cache.h"
 #include "bgw_policy/chunk_stats.h"
+#include "chunk_statistics.h"
 
 TS_FUNCTION_INFO_V1(ts_chunk_show_chunks);
 TS_FUNCTION_INFO_V1(ts_chunk_drop_chunks);
@@ -69,10 +72,6 @@ static void chunk_scan_ctx_init(ChunkScanCtx *ctx, Hyperspace *hs, Point *p);
 static void chunk_scan_ctx_destroy(ChunkScanCtx *ctx);
 static void chunk_collision_scan(ChunkScanCtx *scanctx, Hypercube *cube);
 static int chunk_scan_ctx_foreach_chunk(ChunkScanCtx *ctx, on_chunk_func on_chunk, uint16 limit);
-static Chunk **chunk_get_chunks_in_time_range(Oid table_relid, Datum older_than_datum,
-											  Datum newer_than_datum, Oid older_than_type,
-											  Oid newer_than_type, char *caller_name,
-											  MemoryContext mctx, uint64 *num_chunks_returned);
 static Datum chunks_return_srf(FunctionCallInfo fcinfo);
 static int chunk_cmp(const void *ch1, const void *ch2);
 
@@ -639,7 +638,11 @@ chunk_create_after_lock(Hypertable *ht, Point *p, const char *schema, const char
 	ts_chunk_index_create_all(chunk->fd.hypertable_id,
 							  chunk->hypertable_relid,
 							  chunk->fd.id,
-							  chunk->table_id);
+							  chunk->table_id,
+							  ts_chunk_is_at_write_frontier(ht, chunk));
+
+	/* Start tracking the time range of the chunk's data */
+	ts_chunk_statistics_create(ht, chunk, p);
 
 	return chunk;
 }
@@ -661,7 +664,13 @@ ts_chunk_create(Hypertable *ht, Point *p, const char *schema, const char *prefix
 	chunk = ts_chunk_find(ht->space, p);
 
 	if (NULL == chunk)
+	{
+		instr_time start;
+
+		INSTR_TIME_SET_CURRENT(start);
 		chunk = chunk_create_after_lock(ht, p, schema, prefix);
+		ts_stats_count_time(STATS_CHUNKS_CREATED, start);
+	}
 
 	Assert(chunk != NULL);
 
@@ -779,6 +788,7 @@ chunk_scan_ctx_destroy(ChunkScanCtx *ctx)
 static inline void
 dimension_slice_and_chunk_constraint_join(ChunkScanCtx *scanctx, DimensionVec *vec)
 {
+	ScanSession *session = ts_scan_session_begin();
 	int i;
 
 	for (i = 0; i < vec->num_slices; i++)
@@ -789,6 +799,8 @@ dimension_slice_and_chunk_constraint_join(ChunkScanCtx *scanctx, DimensionVec *v
 		 */
 		ts_chunk_constraint_scan_by_dimension_slice(vec->slices[i], scanctx, CurrentMemoryContext);
 	}
+
+	ts_scan_session_end(session);
 }
 
 /*
@@ -984,6 +996,13 @@ ts_chunk_find(Hyperspace *hs, Point *p)
 {
 	Chunk *chunk;
 	ChunkScanCtx ctx;
+	ScanSession *session;
+
+	/*
+	 * A lookup issues one catalog scan per matching slice, so keep the
+	 * catalog relations open for all of them
+	 */
+	session = ts_scan_session_begin();
 
 	/* The scan context will keep the state accumulated during the scan */
 	chunk_scan_ctx_init(&ctx, hs, p);
@@ -1014,6 +1033,8 @@ ts_chunk_find(Hyperspace *hs, Point *p)
 																  CurrentMemoryContext);
 	}
 
+	ts_scan_session_end(session);
+
 	return chunk;
 }
 
@@ -1118,26 +1139,49 @@ chunks_typecheck_and_find_all_in_range_limit(Hyperspace *hs, Dimension *time_dim
 	return chunk_ctx;
 }
 
+typedef struct ChunkOidsCtx
+{
+	List *oids;
+	chunk_filter_func filter;
+	void *filter_arg;
+} ChunkOidsCtx;
+
 static ChunkResult
 append_chunk_oid(ChunkScanCtx *scanctx, Chunk *chunk)
 {
+	ChunkOidsCtx *oidsctx = scanctx->data;
+
 	if (!chunk_is_complete(scanctx, chunk))
 		return CHUNK_IGNORED;
 
+	/* The filter only sees the chunk's ID, before the chunk row is read */
+	if (NULL != oidsctx->filter && !oidsctx->filter(chunk, oidsctx->filter_arg))
+		return CHUNK_IGNORED;
+
 	/* Fill in the rest of the chunk's data from the chunk table */
 	chunk_fill_stub(chunk, false);
 
 	if (scanctx->lockmode != NoLock)
 		LockRelationOid(chunk->table_id, scanctx->lockmode);
 
-	scanctx->data = lappend_oid(scanctx->data, chunk->table_id);
+	oidsctx->oids = lappend_oid(oidsctx->oids, chunk->table_id);
 	return CHUNK_PROCESSED;
 }
 
+/*
+ * Find the OIDs of the chunks that have a slice in each of the given
+ * dimension vectors. An optional filter can exclude chunks based on their
+ * ID.
+ */
 List *
-ts_chunk_find_all_oids(Hyperspace *hs, List *dimension_vecs, LOCKMODE lockmode)
+ts_chunk_find_all_oids(Hyperspace *hs, List *dimension_vecs, chunk_filter_func filter,
+					   void *filter_arg, LOCKMODE lockmode)
 {
-	List *oid_list = NIL;
+	ChunkOidsCtx oidsctx = {
+		.oids = NIL,
+		.filter = filter,
+		.filter_arg = filter_arg,
+	};
 	ChunkScanCtx ctx;
 	ListCell *lc;
 
@@ -1156,13 +1200,12 @@ ts_chunk_find_all_oids(Hyperspace *hs, List *dimension_vecs, LOCKMODE lockmode)
 		dimension_slice_and_chunk_constraint_join(&ctx, vec);
 	}
 
-	ctx.data = NIL;
+	ctx.data = &oidsctx;
 	chunk_scan_ctx_foreach_chunk(&ctx, append_chunk_oid, 0);
-	oid_list = ctx.data;
 
 	chunk_scan_ctx_destroy(&ctx);
 
-	return oid_list;
+	return oidsctx.oids;
 }
 
 /* show_chunks SQL function handler */
@@ -1190,23 +1233,23 @@ ts_chunk_show_chunks(PG_FUNCTION_ARGS)
 
 		funcctx = SRF_FIRSTCALL_INIT();
 
-		funcctx->user_fctx = chunk_get_chunks_in_time_range(table_relid,
-															older_than_datum,
-															newer_than_datum,
-															older_than_type,
-															newer_than_type,
-															"show_chunks",
-															funcctx->multi_call_memory_ctx,
-															&funcctx->max_calls);
+		funcctx->user_fctx = ts_chunk_get_chunks_in_time_range(table_relid,
+															   older_than_datum,
+															   newer_than_datum,
+															   older_than_type,
+															   newer_than_type,
+															   "show_chunks",
+															   funcctx->multi_call_memory_ctx,
+															   &funcctx->max_calls);
 	}
 
 	return chunks_return_srf(fcinfo);
 }
 
-static Chunk **
-chunk_get_chunks_in_time_range(Oid table_relid, Datum older_than_datum, Datum newer_than_datum,
-							   Oid older_than_type, Oid newer_than_type, char *caller_name,
-							   MemoryContext mctx, uint64 *num_chunks_returned)
+Chunk **
+ts_chunk_get_chunks_in_time_range(Oid table_relid, Datum older_than_datum, Datum newer_than_datum,
+								  Oid older_than_type, Oid newer_than_type, char *caller_name,
+								  MemoryContext mctx, uint64 *num_chunks_returned)
 {
 	ListCell *lc;
 	MemoryContext oldcontext;
@@ -1404,8 +1447,11 @@ ts_chunk_get_window(int32 dimension_id, int64 point, int count, MemoryContext mc
 {
 	List *chunks = NIL;
 	DimensionVec *dimvec;
+	ScanSession *session;
 	int i;
 
+	session = ts_scan_session_begin();
+
 	/* Scan for "count" slices that precede the point in the given dimension */
 	dimvec = ts_dimension_slice_scan_by_dimension_before_point(dimension_id,
 															   point,
@@ -1443,6 +1489,8 @@ ts_chunk_get_window(int32 dimension_id, int64 point, int count, MemoryContext mc
 		}
 	}
 
+	ts_scan_session_end(session);
+
 	return chunks;
 }
 
@@ -1557,6 +1605,139 @@ ts_chunk_exists_relid(Oid relid)
 	return ts_chunk_get_by_relid(relid, 0, false) != NULL;
 }
 
+/*
+ * Check if a chunk is at the write frontier of its hypertable, i.e., if its
+ * slice in the first open ("time") dimension is not older than the frontier
+ * slice of that dimension. Those are the chunks that receive most of the
+ * inserts. The chunk needs to have its hypercube.
+ */
+bool
+ts_chunk_is_at_write_frontier(Hypertable *ht, Chunk *chunk)
+{
+	Dimension *dim = hyperspace_get_open_dimension(ht->space, 0);
+	DimensionSlice *slice;
+	DimensionSlice *latest;
+
+	Assert(NULL != chunk->cube);
+
+	if (NULL == dim)
+		return false;
+
+	slice = ts_hypercube_get_slice_by_dimension_id(chunk->cube, dim->fd.id);
+	latest = ts_dimension_slice_write_frontier(dim);
+
+	return NULL == latest || (NULL != slice && slice->fd.range_start >= latest->fd.range_start);
+}
+
+typedef struct ChunkCollectCtx
+{
+	Oid hypertable_relid;
+	Chunk **chunks;
+	uint64 num_chunks;
+	uint64 capacity;
+} ChunkCollectCtx;
+
+static ScanTupleResult
+chunk_tuple_collect(TupleInfo *ti, void *data)
+{
+	ChunkCollectCtx *ctx = data;
+	Chunk *chunk = MemoryContextAllocZero(ti->mctx, sizeof(Chunk));
+
+	/*
+	 * Unlike chunk_fill(), the hypertable is known, so there is no need to
+	 * look up the inheritance parent of every chunk.
+	 */
+	memcpy(&chunk->fd, GETSTRUCT(ti->tuple), sizeof(FormData_chunk));
+	chunk->table_id = get_relname_relid(NameStr(chunk->fd.table_name),
+										get_namespace_oid(NameStr(chunk->fd.schema_name), true));
+	chunk->hypertable_relid = ctx->hypertable_relid;
+
+	if (ctx->num_chunks >= ctx->capacity)
+	{
+		ctx->capacity *= 2;
+		ctx->chunks = repalloc(ctx->chunks, sizeof(Chunk *) * ctx->capacity);
+	}
+
+	ctx->chunks[ctx->num_chunks++] = chunk;
+
+	return SCAN_CONTINUE;
+}
+
+static int
+chunk_cmp_id(const void *ch1, const void *ch2)
+{
+	const Chunk *v1 = *((const Chunk **) ch1);
+	const Chunk *v2 = *((const Chunk **) ch2);
+
+	if (v1->fd.id < v2->fd.id)
+		return -1;
+	if (v1->fd.id > v2->fd.id)
+		return 1;
+	return 0;
+}
+
+/*
+ * Get all the chunks of a hypertable, ordered by chunk ID.
+ *
+ * This is a single scan of the chunk catalog on the hypertable ID index. A
+ * chunk whose table does not exist has an invalid table_id. The constraints
+ * and hypercube of each chunk are only filled in if num_constraints > 0,
+ * since that requires additional scans per chunk.
+ */
+Chunk **
+ts_chunk_get_by_hypertable_id(int32 hypertable_id, int16 num_constraints, MemoryContext mctx,
+							  uint64 *num_chunks_returned)
+{
+	ScanKeyData scankey[1];
+	ChunkCollectCtx ctx = {
+		.hypertable_relid = ts_hypertable_id_to_relid(hypertable_id),
+		.num_chunks = 0,
+		.capacity = 16,
+	};
+	uint64 i;
+
+	ctx.chunks = MemoryContextAlloc(mctx, sizeof(Chunk *) * ctx.capacity);
+
+	ScanKeyInit(&scankey[0],
+				Anum_chunk_hypertable_id_idx_hypertable_id,
+				BTEqualStrategyNumber,
+				F_INT4EQ,
+				Int32GetDatum(hypertable_id));
+
+	chunk_scan_internal(CHUNK_HYPERTABLE_ID_INDEX,
+						scankey,
+						1,
+						chunk_tuple_collect,
+						&ctx,
+						0,
+						ForwardScanDirection,
+						AccessShareLock,
+						mctx);
+
+	if (ctx.num_chunks > 1)
+		qsort(ctx.chunks, ctx.num_chunks, sizeof(Chunk *), chunk_cmp_id);
+
+	if (num_constraints > 0 && ctx.num_chunks > 0)
+	{
+		ScanSession *session = ts_scan_session_begin();
+
+		for (i = 0; i < ctx.num_chunks; i++)
+		{
+			Chunk *chunk = ctx.chunks[i];
+
+			chunk->constraints =
+				ts_chunk_constraint_scan_by_chunk_id(chunk->fd.id, num_constraints, mctx);
+			chunk->cube = ts_hypercube_from_constraints(chunk->constraints, mctx);
+		}
+
+		ts_scan_session_end(session);
+	}
+
+	*num_chunks_returned = ctx.num_chunks;
+
+	return ctx.chunks;
+}
+
 static ScanTupleResult
 chunk_tuple_delete(TupleInfo *ti, void *data)
 {
@@ -1586,6 +1767,7 @@ chunk_tuple_delete(TupleInfo *ti, void *data)
 
 	/* Delete any row in bgw_policy_chunk-stats corresponding to this chunk */
 	ts_bgw_policy_chunk_stats_delete_by_chunk_id(form->id);
+	ts_chunk_statistics_delete_by_chunk_id(form->id);
 
 	ts_catalog_database_info_become_owner(ts_catalog_database_info_get(), &sec_ctx);
 	ts_catalog_delete(ti->scanrel, ti->tuple);
@@ -1631,6 +1813,28 @@ ts_chunk_delete_by_relid(Oid relid)
 								   get_rel_name(relid));
 }
 
+static int
+chunk_delete_by_id(int32 chunk_id)
+{
+	ScanKeyData scankey[1];
+
+	ScanKeyInit(&scankey[0],
+				Anum_chunk_idx_id,
+				BTEqualStrategyNumber,
+				F_INT4EQ,
+				Int32GetDatum(chunk_id));
+
+	return chunk_scan_internal(CHUNK_ID_INDEX,
+							   scankey,
+							   1,
+							   chunk_tuple_delete,
+							   NULL,
+							   0,
+							   ForwardScanDirection,
+							   RowExclusiveLock,
+							   CurrentMemoryContext);
+}
+
 int
 ts_chunk_delete_by_hypertable_id(int32 hypertable_id)
 {
@@ -1844,20 +2048,246 @@ chunks_return_srf(FunctionCallInfo fcinfo)
 		SRF_RETURN_DONE(funcctx);
 }
 
+/*
+ * Minimum number of chunks for which drop_chunks deletes the catalog metadata
+ * with a sequential scan of every catalog table. Smaller batches do a few
+ * index scans per chunk, which is cheaper than scanning the whole catalog.
+ */
+#define CHUNK_DROP_BATCH_MIN_CHUNKS 16
+
+/*
+ * State for deleting the catalog metadata of a batch of chunks with a single
+ * scan of every catalog table, instead of several index scans per chunk.
+ */
+typedef struct ChunkDropBatch
+{
+	int32 *chunk_ids; /* sorted */
+	int num_chunks;
+	HTAB *dropped_slices;	/* slices of the dropped chunks */
+	HTAB *referenced_slices; /* slices of the remaining chunks */
+} ChunkDropBatch;
+
+static int
+int32_cmp(const void *a, const void *b)
+{
+	int32 left = *((const int32 *) a);
+	int32 right = *((const int32 *) b);
+
+	return left < right ? -1 : (left > right ? 1 : 0);
+}
+
+static bool
+chunk_drop_batch_contains(ChunkDropBatch *batch, int32 chunk_id)
+{
+	return bsearch(&chunk_id, batch->chunk_ids, batch->num_chunks, sizeof(int32), int32_cmp) !=
+		   NULL;
+}
+
+static int32
+chunk_drop_batch_get_chunk_id(TupleInfo *ti, AttrNumber attno)
+{
+	bool isnull;
+	Datum chunk_id = heap_getattr(ti->tuple, attno, ti->desc, &isnull);
+
+	Assert(!isnull);
+	return DatumGetInt32(chunk_id);
+}
+
+static ScanTupleResult
+chunk_drop_batch_constraint_tuple_found(TupleInfo *ti, void *data)
+{
+	ChunkDropBatch *batch = data;
+	bool isnull;
+	Datum slice_id =
+		heap_getattr(ti->tuple, Anum_chunk_constraint_dimension_slice_id, ti->desc, &isnull);
+
+	int32 id = isnull ? 0 : DatumGetInt32(slice_id);
+
+	if (chunk_drop_batch_contains(batch,
+								  chunk_drop_batch_get_chunk_id(ti,
+																Anum_chunk_constraint_chunk_id)))
+	{
+		if (!isnull)
+			hash_search(batch->dropped_slices, &id, HASH_ENTER, NULL);
+
+		ts_catalog_delete(ti->scanrel, ti->tuple);
+	}
+	else if (!isnull)
+		hash_search(batch->referenced_slices, &id, HASH_ENTER, NULL);
+
+	return SCAN_CONTINUE;
+}
+
+static ScanTupleResult
+chunk_drop_batch_index_tuple_found(TupleInfo *ti, void *data)
+{
+	if (chunk_drop_batch_contains(data,
+								  chunk_drop_batch_get_chunk_id(ti, Anum_chunk_index_chunk_id)))
+		ts_catalog_delete(ti->scanrel, ti->tuple);
+
+	return SCAN_CONTINUE;
+}
+
+static ScanTupleResult
+chunk_drop_batch_chunk_stats_tuple_found(TupleInfo *ti, void *data)
+{
+	if (chunk_drop_batch_contains(data,
+								  chunk_drop_batch_get_chunk_id(ti,
+																Anum_bgw_policy_chunk_stats_chunk_id)))
+		ts_catalog_delete(ti->scanrel, ti->tuple);
+
+	return SCAN_CONTINUE;
+}
+
+static ScanTupleResult
+chunk_drop_batch_statistics_tuple_found(TupleInfo *ti, void *data)
+{
+	if (chunk_drop_batch_contains(data,
+								  chunk_drop_batch_get_chunk_id(ti,
+																Anum_chunk_statistics_chunk_id)))
+		ts_catalog_delete(ti->scanrel, ti->tuple);
+
+	return SCAN_CONTINUE;
+}
+
+static ScanTupleResult
+chunk_drop_batch_chunk_tuple_found(TupleInfo *ti, void *data)
+{
+	if (chunk_drop_batch_contains(data, chunk_drop_batch_get_chunk_id(ti, Anum_chunk_id)))
+		ts_catalog_delete(ti->scanrel, ti->tuple);
+
+	return SCAN_CONTINUE;
+}
+
+static ScanTupleResult
+chunk_drop_batch_slice_tuple_found(TupleInfo *ti, void *data)
+{
+	ChunkDropBatch *batch = data;
+	int32 id = chunk_drop_batch_get_chunk_id(ti, Anum_dimension_slice_id);
+
+	/* Delete the slices that are no longer referenced by any chunk */
+	if (hash_search(batch->dropped_slices, &id, HASH_FIND, NULL) != NULL &&
+		hash_search(batch->referenced_slices, &id, HASH_FIND, NULL) == NULL)
+		ts_catalog_delete(ti->scanrel, ti->tuple);
+
+	return SCAN_CONTINUE;
+}
+
+static void
+chunk_drop_batch_scan(ChunkDropBatch *batch, CatalogTable table, tuple_found_func tuple_found)
+{
+	Catalog *catalog = ts_catalog_get();
+	ScannerCtx scanctx = {
+		.table = catalog_get_table_id(catalog, table),
+		.index = InvalidOid,
+		.nkeys = 0,
+		.data = batch,
+		.tuple_found = tuple_found,
+		.lockmode = RowExclusiveLock,
+		.scandirection = ForwardScanDirection,
+		.result_mctx = CurrentMemoryContext,
+	};
+
+	ts_scanner_scan(&scanctx);
+}
+
+/*
+ * Delete the catalog metadata of the given chunks: the chunk rows, their
+ * constraints, indexes, policy stats and statistics, and the dimension slices
+ * that are no longer used by any chunk. This is what chunk_tuple_delete does
+ * for a single chunk, but with one sequential scan of every catalog table for
+ * the whole batch. The chunk tables themselves are not touched.
+ */
+static void
+chunk_delete_batch(Chunk **chunks, uint64 num_chunks)
+{
+	struct HASHCTL hctl = {
+		.keysize = sizeof(int32),
+		.entrysize = sizeof(int32),
+		.hcxt = CurrentMemoryContext,
+	};
+	ChunkDropBatch batch = {
+		.chunk_ids = palloc(sizeof(int32) * num_chunks),
+		.num_chunks = num_chunks,
+	};
+	CatalogSecurityContext sec_ctx;
+	uint64 i;
+
+	for (i = 0; i < num_chunks; i++)
+		batch.chunk_ids[i] = chunks[i]->fd.id;
+
+	qsort(batch.chunk_ids, num_chunks, sizeof(int32), int32_cmp);
+	batch.dropped_slices = hash_create("chunk-drop-batch-dropped-slices",
+									   num_chunks,
+									   &hctl,
+									   HASH_ELEM | HASH_CONTEXT | HASH_BLOBS);
+	batch.referenced_slices = hash_create("chunk-drop-batch-referenced-slices",
+										  1024,
+										  &hctl,
+										  HASH_ELEM | HASH_CONTEXT | HASH_BLOBS);
+
+	ts_catalog_database_info_become_owner(ts_catalog_database_info_get(), &sec_ctx);
+
+	chunk_drop_batch_scan(&batch, CHUNK_CONSTRAINT, chunk_drop_batch_constraint_tuple_found);
+	chunk_drop_batch_scan(&batch, CHUNK_INDEX, chunk_drop_batch_index_tuple_found);
+	chunk_drop_batch_scan(&batch, BGW_POLICY_CHUNK_STATS, chunk_drop_batch_chunk_stats_tuple_found);
+	chunk_drop_batch_scan(&batch, CHUNK_STATISTICS, chunk_drop_batch_statistics_tuple_found);
+	chunk_drop_batch_scan(&batch, CHUNK, chunk_drop_batch_chunk_tuple_found);
+
+	if (hash_get_num_entries(batch.dropped_slices) > 0)
+		chunk_drop_batch_scan(&batch, DIMENSION_SLICE, chunk_drop_batch_slice_tuple_found);
+
+	ts_catalog_restore_user(&sec_ctx);
+
+	hash_destroy(batch.dropped_slices);
+	hash_destroy(batch.referenced_slices);
+	pfree(batch.chunk_ids);
+}
+
 void
 ts_chunk_do_drop_chunks(Oid table_relid, Datum older_than_datum, Datum newer_than_datum,
 						Oid older_than_type, Oid newer_than_type, bool cascade, int32 log_level)
 {
 	int i = 0;
 	uint64 num_chunks = 0;
-	Chunk **chunks = chunk_get_chunks_in_time_range(table_relid,
-													older_than_datum,
-													newer_than_datum,
-													older_than_type,
-													newer_than_type,
-													"drop_chunks",
-													CurrentMemoryContext,
-													&num_chunks);
+	ObjectAddresses *objects;
+	Chunk **chunks = ts_chunk_get_chunks_in_time_range(table_relid,
+													   older_than_datum,
+													   newer_than_datum,
+													   older_than_type,
+													   newer_than_type,
+													   "drop_chunks",
+													   CurrentMemoryContext,
+													   &num_chunks);
+
+	if (num_chunks == 0)
+		return;
+
+	if (num_chunks < CHUNK_DROP_BATCH_MIN_CHUNKS)
+	{
+		for (; i < num_chunks; i++)
+		{
+			ObjectAddress objaddr = {
+				.classId = RelationRelationId,
+				.objectId = chunks[i]->table_id,
+			};
+
+			elog(log_level,
+				 "dropping chunk %s.%s",
+				 chunks[i]->fd.schema_name.data,
+				 chunks[i]->fd.table_name.data);
+
+			/* Remove the chunk from the hypertable table */
+			chunk_delete_by_id(chunks[i]->fd.id);
+
+			/* Drop the table */
+			performDeletion(&objaddr, cascade ? DROP_CASCADE : DROP_RESTRICT, 0);
+		}
+
+		return;
+	}
+
+	objects = new_object_addresses();
 
 	for (; i < num_chunks; i++)
 	{
@@ -1871,12 +2301,19 @@ ts_chunk_do_drop_chunks(Oid table_relid, Datum older_than_datum, Datum newer_tha
 			 chunks[i]->fd.schema_name.data,
 			 chunks[i]->fd.table_name.data);
 
-		/* Remove the chunk from the hypertable table */
-		ts_chunk_delete_by_relid(chunks[i]->table_id);
-
-		/* Drop the table */
-		performDeletion(&objaddr, cascade, 0);
+		add_exact_object_address(&objaddr, objects);
 	}
+
+	/* Remove the chunks from the catalog */
+	chunk_delete_batch(chunks, num_chunks);
+
+	/*
+	 * Drop the tables. The chunks' constraints and indexes are dropped along
+	 * with them. When other objects depend on the chunks, PostgreSQL reports
+	 * this with its generic multi-object error.
+	 */
+	performMultipleDeletions(objects, cascade ? DROP_CASCADE : DROP_RESTRICT, 0);
+	free_object_addresses(objects);
 }
 
 Datum
@@ -61,6 +61,9 @@ typedef struct ChunkScanCtx
 	void *data;
 } ChunkScanCtx;
 
+/* Filter for chunks found in a scan. Returns false to exclude the chunk */
+typedef bool (*chunk_filter_func)(Chunk *chunk, void *arg);
+
 /* The hash table entry for the ChunkScanCtx */
 typedef struct ChunkScanEntry
 {
@@ -71,7 +74,8 @@ typedef struct ChunkScanEntry
 extern Chunk *ts_chunk_create(Hypertable *ht, Point *p, const char *schema, const char *prefix);
 extern Chunk *ts_chunk_create_stub(int32 id, int16 num_constraints);
 extern Chunk *ts_chunk_find(Hyperspace *hs, Point *p);
-extern List *ts_chunk_find_all_oids(Hyperspace *hs, List *dimension_vecs, LOCKMODE lockmode);
+extern List *ts_chunk_find_all_oids(Hyperspace *hs, List *dimension_vecs, chunk_filter_func filter,
+									void *filter_arg, LOCKMODE lockmode);
 extern Chunk *ts_chunk_copy(Chunk *chunk);
 extern Chunk *ts_chunk_get_by_name_with_memory_context(const char *schema_name,
 													   const char *table_name,
@@ -83,6 +87,9 @@ extern TSDLLEXPORT Chunk *ts_chunk_get_by_relid(Oid relid, int16 num_constraints
 												bool fail_if_not_found);
 extern bool ts_chunk_exists(const char *schema_name, const char *table_name);
 extern bool ts_chunk_exists_relid(Oid relid);
+extern bool ts_chunk_is_at_write_frontier(Hypertable *ht, Chunk *chunk);
+extern Chunk **ts_chunk_get_by_hypertable_id(int32 hypertable_id, int16 num_constraints,
+											 MemoryContext mctx, uint64 *num_chunks_returned);
 extern void ts_chunk_recreate_all_constraints_for_dimension(Hyperspace *hs, int32 dimension_id);
 extern int ts_chunk_delete_by_relid(Oid chunk_oid);
 extern int ts_chunk_delete_by_hypertable_id(int32 hypertable_id);
@@ -91,6 +98,10 @@ extern bool ts_chunk_set_name(Chunk *chunk, const char *newname);
 extern bool ts_chunk_set_schema(Chunk *chunk, const char *newschema);
 extern List *ts_chunk_get_window(int32 dimension_id, int64 point, int count, MemoryContext mctx);
 extern void ts_chunks_rename_schema_name(char *old_schema, char *new_schema);
+extern TSDLLEXPORT Chunk **
+ts_chunk_get_chunks_in_time_range(Oid table_relid, Datum older_than_datum, Datum newer_than_datum,
+								  Oid older_than_type, Oid newer_than_type, char *caller_name,
+								  MemoryContext mctx, uint64 *num_chunks_returned);
 extern TSDLLEXPORT void ts_chunk_do_drop_chunks(Oid table_relid, Datum older_than_datum,
 												Datum newer_than_datum, Oid older_than_type,
 												Oid newer_than_type, bool cascade, int32 log_level);
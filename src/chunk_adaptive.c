@@ -117,13 +117,6 @@ calculate_initial_chunk_target_size(void)
 	return (int64)((double) get_memory_cache_size() * DEFAULT_CACHE_MEMORY_SLACK);
 }
 
-typedef enum MinMaxResult
-{
-	MINMAX_NO_INDEX,
-	MINMAX_NO_TUPLES,
-	MINMAX_FOUND,
-} MinMaxResult;
-
 /*
  * Use a heap scan to find the min and max of a given column of a chunk. This
  * could be a rather costly operation. Should figure out how to keep min-max
@@ -177,9 +170,10 @@ minmax_heapscan(Relation rel, Oid atttype, AttrNumber attnum, Datum minmax[2])
  * Use an index scan to find the min and max of a given column of a chunk.
  */
 static MinMaxResult
-minmax_indexscan(Relation rel, Relation idxrel, AttrNumber attnum, Datum minmax[2])
+minmax_indexscan(Relation rel, Relation idxrel, Snapshot snapshot, AttrNumber attnum,
+				 Datum minmax[2])
 {
-	IndexScanDesc scan = index_beginscan(rel, idxrel, GetTransactionSnapshot(), 0, 0);
+	IndexScanDesc scan = index_beginscan(rel, idxrel, snapshot, 0, 0);
 	HeapTuple tuple;
 	bool isnull;
 	bool nulls[2] = { true, true };
@@ -211,8 +205,8 @@ minmax_indexscan(Relation rel, Relation idxrel, AttrNumber attnum, Datum minmax[
  * Do a scan for min and max using and index on the given column.
  */
 static MinMaxResult
-relation_minmax_indexscan(Relation rel, Oid atttype, Name attname, AttrNumber attnum,
-						  Datum minmax[2])
+relation_minmax_indexscan(Relation rel, Snapshot snapshot, Oid atttype, Name attname,
+						  AttrNumber attnum, Datum minmax[2])
 {
 	List *indexlist = RelationGetIndexList(rel);
 	ListCell *lc;
@@ -227,7 +221,7 @@ relation_minmax_indexscan(Relation rel, Oid atttype, Name attname, AttrNumber at
 		idxattr = TupleDescAttr(idxrel->rd_att, 0);
 
 		if (idxattr->atttypid == atttype && namestrcmp(&idxattr->attname, NameStr(*attname)) == 0)
-			res = minmax_indexscan(rel, idxrel, attnum, minmax);
+			res = minmax_indexscan(rel, idxrel, snapshot, attnum, minmax);
 
 		index_close(idxrel, AccessShareLock);
 
@@ -248,13 +242,36 @@ table_has_minmax_index(Oid relid, Oid atttype, Name attname, AttrNumber attnum)
 {
 	Datum minmax[2];
 	Relation rel = heap_open(relid, AccessShareLock);
-	MinMaxResult res = relation_minmax_indexscan(rel, atttype, attname, attnum, minmax);
+	MinMaxResult res =
+		relation_minmax_indexscan(rel, GetTransactionSnapshot(), atttype, attname, attnum, minmax);
 
 	heap_close(rel, AccessShareLock);
 
 	return res != MINMAX_NO_INDEX;
 }
 
+/*
+ * Get the min and max value for a given column of a chunk using only an
+ * index on the column. Unlike chunk_get_minmax(), this never falls back to a
+ * heap scan, so it is cheap enough to call on maintenance paths.
+ *
+ * Dead and uncommitted tuples are included, so the result covers the values
+ * visible to any snapshot.
+ */
+MinMaxResult
+ts_chunk_get_minmax_indexscan(Oid relid, Oid atttype, AttrNumber attnum, Datum minmax[2])
+{
+	Relation rel = heap_open(relid, AccessShareLock);
+	NameData attname;
+	MinMaxResult res;
+
+	namestrcpy(&attname, get_attname_compat(relid, attnum, false));
+	res = relation_minmax_indexscan(rel, SnapshotAny, atttype, &attname, attnum, minmax);
+	heap_close(rel, AccessShareLock);
+
+	return res;
+}
+
 /*
  * Get the min and max value for a given column of a chunk.
  *
@@ -268,7 +285,8 @@ chunk_get_minmax(Oid relid, Oid atttype, AttrNumber attnum, Datum minmax[2])
 	MinMaxResult res;
 
 	namestrcpy(&attname, get_attname_compat(relid, attnum, false));
-	res = relation_minmax_indexscan(rel, atttype, &attname, attnum, minmax);
+	res =
+		relation_minmax_indexscan(rel, GetTransactionSnapshot(), atttype, &attname, attnum, minmax);
 
 	if (res == MINMAX_NO_INDEX)
 	{
@@ -5,6 +5,7 @@
 #define TIMESCALEDB_CHUNK_ADAPTIVE_H
 
 #include <postgres.h>
+#include <access/attnum.h>
 
 typedef struct ChunkSizingInfo
 {
@@ -23,6 +24,15 @@ typedef struct ChunkSizingInfo
 	int64 target_size_bytes;
 } ChunkSizingInfo;
 
+typedef enum MinMaxResult
+{
+	MINMAX_NO_INDEX,
+	MINMAX_NO_TUPLES,
+	MINMAX_FOUND,
+} MinMaxResult;
+
 extern void ts_chunk_adaptive_sizing_info_validate(ChunkSizingInfo *info);
+extern MinMaxResult ts_chunk_get_minmax_indexscan(Oid relid, Oid atttype, AttrNumber attnum,
+												  Datum minmax[2]);
 
 #endif /* TIMESCALEDB_CHUNK_ADAPTIVE_H */
@@ -15,6 +15,7 @@
 #include "subspace_store.h"
 #include "dimension.h"
 #include "guc.h"
+#include "stats.h"
 
 ChunkDispatch *
 ts_chunk_dispatch_create(Hypertable *ht, EState *estate)
@@ -31,6 +32,7 @@ ts_chunk_dispatch_create(Hypertable *ht, EState *estate)
 		ts_subspace_store_init(ht->space, estate->es_query_cxt, ts_guc_max_open_chunks_per_insert);
 	cd->prev_cis = NULL;
 	cd->prev_cis_oid = InvalidOid;
+	cd->chunks_touched = NULL;
 
 	return cd;
 }
@@ -64,6 +66,9 @@ ts_chunk_dispatch_get_chunk_insert_state(ChunkDispatch *dispatch, Point *point,
 	if (NULL == cis)
 	{
 		Chunk *new_chunk;
+		MemoryContext old;
+
+		ts_stats_count(STATS_CHUNK_DISPATCH_MISSES);
 
 		new_chunk = ts_hypertable_get_chunk(dispatch->hypertable, point);
 
@@ -72,17 +77,25 @@ ts_chunk_dispatch_get_chunk_insert_state(ChunkDispatch *dispatch, Point *point,
 
 		cis = ts_chunk_insert_state_create(new_chunk, dispatch);
 		ts_subspace_store_add(dispatch->cache, new_chunk->cube, cis, destroy_chunk_insert_state);
+
+		old = MemoryContextSwitchTo(dispatch->estate->es_query_cxt);
+		dispatch->chunks_touched = bms_add_member(dispatch->chunks_touched, new_chunk->fd.id);
+		MemoryContextSwitchTo(old);
 	}
-	else if (cis->rel->rd_id == dispatch->prev_cis_oid && cis == dispatch->prev_cis)
+	else
 	{
+		ts_stats_count(STATS_CHUNK_DISPATCH_HITS);
+
 		/* got the same item from cache as before */
-		*cis_changed_out = false;
+		if (cis->rel->rd_id == dispatch->prev_cis_oid && cis == dispatch->prev_cis)
+			*cis_changed_out = false;
 	}
 
 	if (*cis_changed_out)
 		ts_chunk_insert_state_switch(cis);
 
 	Assert(cis != NULL);
+	ts_chunk_time_range_tracker_add(&cis->time_range, point);
 	dispatch->prev_cis = cis;
 	dispatch->prev_cis_oid = cis->rel->rd_id;
 	return cis;
@@ -41,6 +41,8 @@ typedef struct ChunkDispatch
 	CmdType cmd_type;
 	ChunkInsertState *prev_cis;
 	Oid prev_cis_oid;
+	/* IDs of the chunks that tuples were routed to, for EXPLAIN */
+	Bitmapset *chunks_touched;
 } ChunkDispatch;
 
 typedef struct Point Point;
@@ -8,6 +8,7 @@
 #include <utils/rel.h>
 #include <catalog/pg_class.h>
 #include <nodes/extensible.h>
+#include <commands/explain.h>
 
 #include "compat.h"
 #include "chunk_dispatch_state.h"
@@ -40,6 +41,8 @@ chunk_dispatch_begin(CustomScanState *node, EState *estate, int eflags)
 	ps = ExecInitNode(state->subplan, estate, eflags);
 	state->hypertable_cache = hypertable_cache;
 	state->dispatch = ts_chunk_dispatch_create(ht, estate);
+	memcpy(state->stats_start, ts_stats.counters, sizeof(state->stats_start));
+	state->creation_time_start = ts_stats.times[STATS_CHUNKS_CREATED];
 	node->custom_ps = list_make1(ps);
 }
 
@@ -179,12 +182,62 @@ chunk_dispatch_rescan(CustomScanState *node)
 	ExecReScan(substate);
 }
 
+#define stats_diff(state, counter) (ts_stats.counters[(counter)] - (state)->stats_start[(counter)])
+
+/*
+ * Show how tuples were routed to chunks. The numbers are the differences of
+ * the backend's counters since the start of execution, so they also include
+ * work done by, e.g., triggers inserting into other hypertables.
+ */
+static void
+chunk_dispatch_explain(CustomScanState *node, List *ancestors, ExplainState *es)
+{
+	ChunkDispatchState *state = (ChunkDispatchState *) node;
+
+	if (!es->analyze || !es->verbose)
+		return;
+
+	ExplainPropertyIntegerCompat("Chunks touched",
+								 NULL,
+								 bms_num_members(state->dispatch->chunks_touched),
+								 es);
+	ExplainPropertyIntegerCompat("Chunk insert state cache hits",
+								 NULL,
+								 stats_diff(state, STATS_CHUNK_DISPATCH_HITS),
+								 es);
+	ExplainPropertyIntegerCompat("Chunk insert state cache misses",
+								 NULL,
+								 stats_diff(state, STATS_CHUNK_DISPATCH_MISSES),
+								 es);
+	ExplainPropertyIntegerCompat("Chunk insert state cache evictions",
+								 NULL,
+								 stats_diff(state, STATS_SUBSPACE_STORE_EVICTIONS),
+								 es);
+	ExplainPropertyIntegerCompat("Chunks created",
+								 NULL,
+								 stats_diff(state, STATS_CHUNKS_CREATED),
+								 es);
+
+	if (es->timing)
+	{
+		instr_time creation_time = ts_stats.times[STATS_CHUNKS_CREATED];
+
+		INSTR_TIME_SUBTRACT(creation_time, state->creation_time_start);
+		ExplainPropertyFloatCompat("Chunk creation time",
+								   "ms",
+								   INSTR_TIME_GET_MILLISEC(creation_time),
+								   3,
+								   es);
+	}
+}
+
 static CustomExecMethods chunk_dispatch_state_methods = {
 	.CustomName = CHUNK_DISPATCH_STATE_NAME,
 	.BeginCustomScan = chunk_dispatch_begin,
 	.EndCustomScan = chunk_dispatch_end,
 	.ExecCustomScan = chunk_dispatch_exec,
 	.ReScanCustomScan = chunk_dispatch_rescan,
+	.ExplainCustomScan = chunk_dispatch_explain,
 };
 
 ChunkDispatchState *
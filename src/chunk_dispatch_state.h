@@ -10,6 +10,8 @@
 #include <nodes/execnodes.h>
 #include <nodes/parsenodes.h>
 
+#include "stats.h"
+
 typedef struct ChunkDispatch ChunkDispatch;
 typedef struct Cache Cache;
 
@@ -33,6 +35,10 @@ typedef struct ChunkDispatchState
 	 * for each chunk.
 	 */
 	ChunkDispatch *dispatch;
+
+	/* Counters at the start of execution, to report the differences in EXPLAIN */
+	uint64 stats_start[_STATS_MAX_COUNTERS];
+	instr_time creation_time_start;
 } ChunkDispatchState;
 
 #define CHUNK_DISPATCH_STATE_NAME "ChunkDispatchState"
@@ -36,7 +36,7 @@ static bool chunk_index_insert(int32 chunk_id, const char *chunk_index, int32 hy
 							   const char *hypertable_index);
 static Oid ts_chunk_index_create_post_adjustment(int32 hypertable_id, Relation template_indexrel,
 												 Relation chunkrel, IndexInfo *indexinfo,
-												 bool isconstraint);
+												 bool isconstraint, Oid index_tablespace);
 
 static List *
 create_index_colnames(Relation indexrel)
@@ -265,10 +265,13 @@ ts_chunk_index_get_tablespace(int32 hypertable_id, Relation template_indexrel, R
 
 /*
  * Create a chunk index based on the configuration of the "parent" index.
+ *
+ * If index_tablespace is valid the index is created there, otherwise the
+ * tablespace is chosen the same way as for any other chunk index.
  */
 static Oid
 chunk_relation_index_create(Relation htrel, Relation template_indexrel, Relation chunkrel,
-							bool isconstraint)
+							bool isconstraint, Oid index_tablespace)
 {
 	IndexInfo *indexinfo = BuildIndexInfo(template_indexrel);
 	int32 hypertable_id;
@@ -306,12 +309,14 @@ chunk_relation_index_create(Relation htrel, Relation template_indexrel, Relation
 												 template_indexrel,
 												 chunkrel,
 												 indexinfo,
-												 isconstraint);
+												 isconstraint,
+												 index_tablespace);
 }
 
 static Oid
 ts_chunk_index_create_post_adjustment(int32 hypertable_id, Relation template_indexrel,
-									  Relation chunkrel, IndexInfo *indexinfo, bool isconstraint)
+									  Relation chunkrel, IndexInfo *indexinfo, bool isconstraint,
+									  Oid index_tablespace)
 {
 	Oid chunk_indexrelid = InvalidOid;
 	const char *indexname;
@@ -344,7 +349,10 @@ ts_chunk_index_create_post_adjustment(int32 hypertable_id, Relation template_ind
 										get_rel_name(RelationGetRelid(template_indexrel)),
 										get_rel_namespace(RelationGetRelid(chunkrel)));
 
-	tablespace = ts_chunk_index_get_tablespace(hypertable_id, template_indexrel, chunkrel);
+	if (OidIsValid(index_tablespace))
+		tablespace = index_tablespace;
+	else
+		tablespace = ts_chunk_index_get_tablespace(hypertable_id, template_indexrel, chunkrel);
 
 	/* assign flags for index creation and constraint creation */
 	if (isconstraint)
@@ -456,7 +464,7 @@ chunk_index_create(Relation hypertable_rel, int32 hypertable_id, Relation hypert
 	}
 
 	chunk_indexrelid =
-		chunk_relation_index_create(hypertable_rel, hypertable_idxrel, chunkrel, false);
+		chunk_relation_index_create(hypertable_rel, hypertable_idxrel, chunkrel, false, InvalidOid);
 
 	chunk_index_insert(chunk_id,
 					   get_rel_name(chunk_indexrelid),
@@ -473,7 +481,8 @@ ts_chunk_index_create_from_adjusted_index_info(int32 hypertable_id, Relation hyp
 																 hypertable_idxrel,
 																 chunkrel,
 																 indexinfo,
-																 false);
+																 false,
+																 InvalidOid);
 
 	chunk_index_insert(chunk_id,
 					   get_rel_name(chunk_indexrelid),
@@ -519,6 +528,183 @@ ts_chunk_index_create_from_stmt(IndexStmt *stmt, int32 chunk_id, Oid chunkrelid,
 	return idxobj.objectId;
 }
 
+/*
+ * Deferred indexes.
+ *
+ * A hypertable index created WITH (timescaledb.deferred) is not built on the
+ * chunks at the write frontier, since maintaining it would slow down the
+ * inserts that mostly go to those chunks. Such indexes are listed in the
+ * deferred_index catalog table and built by the deferred indexes policy once
+ * a chunk has fallen behind the frontier. Until then, the chunk simply has no
+ * such index, so the planner never considers it for the chunk.
+ */
+static int
+deferred_index_scan(ScanKeyData *scankey, int nkeys, tuple_found_func tuple_found,
+					tuple_filter_func tuple_filter, void *data, LOCKMODE lockmode)
+{
+	Catalog *catalog = ts_catalog_get();
+	ScannerCtx scanctx = {
+		.table = catalog_get_table_id(catalog, DEFERRED_INDEX),
+		.index = catalog_get_index(catalog, DEFERRED_INDEX, DEFERRED_INDEX_PKEY_IDX),
+		.nkeys = nkeys,
+		.scankey = scankey,
+		.tuple_found = tuple_found,
+		.filter = tuple_filter,
+		.data = data,
+		.lockmode = lockmode,
+		.scandirection = ForwardScanDirection,
+	};
+
+	return ts_scanner_scan(&scanctx);
+}
+
+static int
+deferred_index_scankey_init(ScanKeyData *scankey, int32 hypertable_id,
+							const char *hypertable_index)
+{
+	ScanKeyInit(&scankey[0],
+				Anum_deferred_index_pkey_idx_hypertable_id,
+				BTEqualStrategyNumber,
+				F_INT4EQ,
+				Int32GetDatum(hypertable_id));
+
+	if (NULL == hypertable_index)
+		return 1;
+
+	ScanKeyInit(&scankey[1],
+				Anum_deferred_index_pkey_idx_hypertable_index_name,
+				BTEqualStrategyNumber,
+				F_NAMEEQ,
+				DirectFunctionCall1(namein, CStringGetDatum(hypertable_index)));
+
+	return 2;
+}
+
+/*
+ * Mark a hypertable index as deferred.
+ */
+void
+ts_chunk_index_set_deferred(int32 hypertable_id, const char *hypertable_index)
+{
+	Catalog *catalog = ts_catalog_get();
+	Relation rel = heap_open(catalog_get_table_id(catalog, DEFERRED_INDEX), RowExclusiveLock);
+	Datum values[Natts_deferred_index];
+	bool nulls[Natts_deferred_index] = { false };
+	CatalogSecurityContext sec_ctx;
+
+	values[AttrNumberGetAttrOffset(Anum_deferred_index_hypertable_id)] =
+		Int32GetDatum(hypertable_id);
+	values[AttrNumberGetAttrOffset(Anum_deferred_index_hypertable_index_name)] =
+		DirectFunctionCall1(namein, CStringGetDatum(hypertable_index));
+
+	ts_catalog_database_info_become_owner(ts_catalog_database_info_get(), &sec_ctx);
+	ts_catalog_insert_values(rel, RelationGetDescr(rel), values, nulls);
+	ts_catalog_restore_user(&sec_ctx);
+
+	heap_close(rel, RowExclusiveLock);
+}
+
+bool
+ts_chunk_index_is_deferred(int32 hypertable_id, const char *hypertable_index)
+{
+	ScanKeyData scankey[2];
+	int nkeys = deferred_index_scankey_init(scankey, hypertable_id, hypertable_index);
+
+	return deferred_index_scan(scankey, nkeys, NULL, NULL, NULL, AccessShareLock) > 0;
+}
+
+static ScanTupleResult
+deferred_index_tuple_delete(TupleInfo *ti, void *data)
+{
+	CatalogSecurityContext sec_ctx;
+
+	ts_catalog_database_info_become_owner(ts_catalog_database_info_get(), &sec_ctx);
+	ts_catalog_delete(ti->scanrel, ti->tuple);
+	ts_catalog_restore_user(&sec_ctx);
+
+	return SCAN_CONTINUE;
+}
+
+int
+ts_chunk_index_delete_deferred_by_hypertable_id(int32 hypertable_id)
+{
+	ScanKeyData scankey[1];
+	int nkeys = deferred_index_scankey_init(scankey, hypertable_id, NULL);
+
+	return deferred_index_scan(scankey,
+							   nkeys,
+							   deferred_index_tuple_delete,
+							   NULL,
+							   NULL,
+							   RowExclusiveLock);
+}
+
+static ScanTupleResult
+deferred_index_tuple_collect(TupleInfo *ti, void *data)
+{
+	FormData_deferred_index *deferred_index = (FormData_deferred_index *) GETSTRUCT(ti->tuple);
+	List **names = data;
+
+	*names = lappend(*names, pstrdup(NameStr(deferred_index->hypertable_index_name)));
+
+	return SCAN_CONTINUE;
+}
+
+/*
+ * Build the deferred indexes of a hypertable that are missing on a chunk.
+ *
+ * Returns the number of indexes built.
+ */
+int
+ts_chunk_index_create_deferred(Hypertable *ht, Chunk *chunk)
+{
+	ScanKeyData scankey[1];
+	int nkeys = deferred_index_scankey_init(scankey, ht->fd.id, NULL);
+	List *names = NIL;
+	Relation htrel;
+	Relation chunkrel;
+	Oid namespaceid;
+	ListCell *lc;
+	int num_created = 0;
+
+	deferred_index_scan(scankey,
+						nkeys,
+						deferred_index_tuple_collect,
+						NULL,
+						&names,
+						AccessShareLock);
+
+	if (names == NIL)
+		return 0;
+
+	htrel = relation_open(ht->main_table_relid, AccessShareLock);
+
+	/* Need ShareLock on the heap relation we are creating indexes on */
+	chunkrel = relation_open(chunk->table_id, ShareLock);
+	namespaceid = get_rel_namespace(ht->main_table_relid);
+
+	foreach (lc, names)
+	{
+		Oid hypertable_idxoid = get_relname_relid(lfirst(lc), namespaceid);
+		Relation hypertable_idxrel;
+		ChunkIndexMapping cim;
+
+		if (!OidIsValid(hypertable_idxoid) ||
+			ts_chunk_index_get_by_hypertable_indexrelid(chunk, hypertable_idxoid, &cim))
+			continue;
+
+		hypertable_idxrel = relation_open(hypertable_idxoid, AccessShareLock);
+		chunk_index_create(htrel, ht->fd.id, hypertable_idxrel, chunk->fd.id, chunkrel, InvalidOid);
+		relation_close(hypertable_idxrel, AccessShareLock);
+		num_created++;
+	}
+
+	relation_close(chunkrel, NoLock);
+	relation_close(htrel, AccessShareLock);
+
+	return num_created;
+}
+
 static inline Oid
 chunk_index_get_schemaid(Form_chunk_index chunk_index, bool missing_ok)
 {
@@ -532,10 +718,11 @@ chunk_index_get_schemaid(Form_chunk_index chunk_index, bool missing_ok)
 
 /*
  * Create all indexes on a chunk, given the indexes that exists on the chunk's
- * hypertable.
+ * hypertable. Deferred indexes are skipped if "skip_deferred" is set.
  */
 void
-ts_chunk_index_create_all(int32 hypertable_id, Oid hypertable_relid, int32 chunk_id, Oid chunkrelid)
+ts_chunk_index_create_all(int32 hypertable_id, Oid hypertable_relid, int32 chunk_id, Oid chunkrelid,
+						  bool skip_deferred)
 {
 	Relation htrel;
 	Relation chunkrel;
@@ -563,7 +750,13 @@ ts_chunk_index_create_all(int32 hypertable_id, Oid hypertable_relid, int32 chunk
 	foreach (lc, indexlist)
 	{
 		Oid hypertable_idxoid = lfirst_oid(lc);
-		Relation hypertable_idxrel = relation_open(hypertable_idxoid, AccessShareLock);
+		Relation hypertable_idxrel;
+
+		if (skip_deferred &&
+			ts_chunk_index_is_deferred(hypertable_id, get_rel_name(hypertable_idxoid)))
+			continue;
+
+		hypertable_idxrel = relation_open(hypertable_idxoid, AccessShareLock);
 
 		chunk_index_create(htrel,
 						   hypertable_id,
@@ -748,6 +941,23 @@ ts_chunk_index_delete(Chunk *chunk, Oid chunk_indexrelid, bool drop_index)
 								   &data);
 }
 
+static ScanFilterResult
+deferred_index_name_and_schema_filter(TupleInfo *ti, void *data)
+{
+	FormData_deferred_index *deferred_index = (FormData_deferred_index *) GETSTRUCT(ti->tuple);
+	ChunkIndexDeleteData *cid = data;
+
+	if (namestrcmp(&deferred_index->hypertable_index_name, cid->index_name) == 0)
+	{
+		Hypertable *ht = ts_hypertable_get_by_id(deferred_index->hypertable_id);
+
+		if (NULL != ht && namestrcmp(&ht->fd.schema_name, cid->schema) == 0)
+			return SCAN_INCLUDE;
+	}
+
+	return SCAN_EXCLUDE;
+}
+
 void
 ts_chunk_index_delete_by_name(const char *schema, const char *index_name, bool drop_index)
 {
@@ -763,6 +973,14 @@ ts_chunk_index_delete_by_name(const char *schema, const char *index_name, bool d
 							chunk_index_tuple_delete,
 							chunk_index_name_and_schema_filter,
 							&data);
+
+	/* A dropped hypertable index is no longer deferred */
+	deferred_index_scan(NULL,
+						0,
+						deferred_index_tuple_delete,
+						deferred_index_name_and_schema_filter,
+						&data,
+						RowExclusiveLock);
 }
 
 int
@@ -941,6 +1159,20 @@ ts_chunk_index_rename(Chunk *chunk, Oid chunk_indexrelid, const char *newname)
 								   &renameinfo);
 }
 
+static ScanTupleResult
+deferred_index_tuple_rename(TupleInfo *ti, void *data)
+{
+	ChunkIndexRenameInfo *info = data;
+	HeapTuple tuple = heap_copytuple(ti->tuple);
+	FormData_deferred_index *deferred_index = (FormData_deferred_index *) GETSTRUCT(tuple);
+
+	namestrcpy(&deferred_index->hypertable_index_name, info->newname);
+	ts_catalog_update(ti->scanrel, tuple);
+	heap_freetuple(tuple);
+
+	return SCAN_DONE;
+}
+
 int
 ts_chunk_index_rename_parent(Hypertable *ht, Oid hypertable_indexrelid, const char *newname)
 {
@@ -951,6 +1183,14 @@ ts_chunk_index_rename_parent(Hypertable *ht, Oid hypertable_indexrelid, const ch
 		.newname = newname,
 		.isparent = true,
 	};
+	int nkeys = deferred_index_scankey_init(scankey, ht->fd.id, indexname);
+
+	deferred_index_scan(scankey,
+						nkeys,
+						deferred_index_tuple_rename,
+						NULL,
+						&renameinfo,
+						RowExclusiveLock);
 
 	ScanKeyInit(&scankey[0],
 				Anum_chunk_index_hypertable_id_hypertable_index_name_idx_hypertable_id,
@@ -1029,7 +1269,7 @@ TS_FUNCTION_INFO_V1(ts_chunk_index_clone);
 
 static Oid
 chunk_index_duplicate_index(Relation hypertable_rel, Chunk *src_chunk, Oid chunk_index_oid,
-							Relation dest_chunk_rel)
+							Relation dest_chunk_rel, Oid index_tablespace)
 {
 	Relation chunk_index_rel = relation_open(chunk_index_oid, AccessShareLock);
 	ChunkIndexMapping cim;
@@ -1043,7 +1283,8 @@ chunk_index_duplicate_index(Relation hypertable_rel, Chunk *src_chunk, Oid chunk
 	new_chunk_indexrelid = chunk_relation_index_create(hypertable_rel,
 													   chunk_index_rel,
 													   dest_chunk_rel,
-													   OidIsValid(constraint_oid));
+													   OidIsValid(constraint_oid),
+													   index_tablespace);
 
 	relation_close(chunk_index_rel, NoLock);
 	return new_chunk_indexrelid;
@@ -1053,9 +1294,11 @@ chunk_index_duplicate_index(Relation hypertable_rel, Chunk *src_chunk, Oid chunk
  * Create versions of every index over src_chunkrelid over chunkrelid.
  * Returns the relids of the new indexes created.
  * New indexes are in the same order as RelationGetIndexList.
+ * If index_tablespace is valid, the new indexes are created in that tablespace.
  */
 TSDLLEXPORT List *
-ts_chunk_index_duplicate(Oid src_chunkrelid, Oid dest_chunkrelid, List **src_index_oids)
+ts_chunk_index_duplicate(Oid src_chunkrelid, Oid dest_chunkrelid, List **src_index_oids,
+						 Oid index_tablespace)
 {
 	Relation hypertable_rel = NULL;
 	Relation src_chunk_rel;
@@ -1078,7 +1321,11 @@ ts_chunk_index_duplicate(Oid src_chunkrelid, Oid dest_chunkrelid, List **src_ind
 	{
 		Oid chunk_index_oid = lfirst_oid(index_elem);
 		Oid new_chunk_indexrelid =
-			chunk_index_duplicate_index(hypertable_rel, src_chunk, chunk_index_oid, dest_chunk_rel);
+			chunk_index_duplicate_index(hypertable_rel,
+										src_chunk,
+										chunk_index_oid,
+										dest_chunk_rel,
+										index_tablespace);
 
 		new_index_oids = lappend_oid(new_index_oids, new_chunk_indexrelid);
 	}
@@ -1122,7 +1369,8 @@ ts_chunk_index_clone(PG_FUNCTION_ARGS)
 	new_chunk_indexrelid = chunk_relation_index_create(hypertable_rel,
 													   chunk_index_rel,
 													   chunk_rel,
-													   OidIsValid(constraint_oid));
+													   OidIsValid(constraint_oid),
+													   InvalidOid);
 
 	heap_close(chunk_rel, NoLock);
 
@@ -36,7 +36,12 @@ extern void ts_chunk_index_create_from_adjusted_index_info(int32 hypertable_id,
 														   int32 chunk_id, Relation chunkrel,
 														   IndexInfo *indexinfo);
 extern void ts_chunk_index_create_all(int32 hypertable_id, Oid hypertable_relid, int32 chunk_id,
-									  Oid chunkrelid);
+									  Oid chunkrelid, bool skip_deferred);
+extern void ts_chunk_index_set_deferred(int32 hypertable_id, const char *hypertable_index);
+extern TSDLLEXPORT bool ts_chunk_index_is_deferred(int32 hypertable_id,
+												   const char *hypertable_index);
+extern int ts_chunk_index_delete_deferred_by_hypertable_id(int32 hypertable_id);
+extern TSDLLEXPORT int ts_chunk_index_create_deferred(Hypertable *ht, Chunk *chunk);
 extern Oid ts_chunk_index_create_from_stmt(IndexStmt *stmt, int32 chunk_id, Oid chunkrelid,
 										   int32 hypertable_id, Oid hypertable_indexrelid);
 extern int ts_chunk_index_delete(Chunk *chunk, Oid chunk_indexrelid, bool drop_index);
@@ -60,7 +65,7 @@ extern TSDLLEXPORT bool ts_chunk_index_get_by_indexrelid(Chunk *chunk, Oid chunk
 extern TSDLLEXPORT void ts_chunk_index_mark_clustered(Oid chunkrelid, Oid indexrelid);
 
 extern TSDLLEXPORT List *ts_chunk_index_duplicate(Oid src_chunkrelid, Oid dest_chunkrelid,
-												  List **src_index_oids);
+												  List **src_index_oids, Oid index_tablespace);
 
 /* chunk_index_recreate  is a process akin to reindex
  * except that indexes are created in 2 steps
@@ -28,6 +28,7 @@
 #include "chunk_dispatch_state.h"
 #include "compat.h"
 #include "chunk_index.h"
+#include "chunk_statistics.h"
 
 /*
  * Create a new RangeTblEntry for the chunk in the executor's range table and
@@ -486,6 +487,36 @@ chunk_insert_state_set_arbiter_indexes(ChunkInsertState *state, ChunkDispatch *d
 #endif
 }
 
+/*
+ * Check if the SET list of an ON CONFLICT DO UPDATE changes the time column.
+ *
+ * The planner expands the SET list to all columns, with unchanged columns set
+ * to the existing value, so assignments of the column to itself are skipped.
+ */
+static bool
+on_conflict_set_updates_time(List *on_conflict_set, Hypertable *ht)
+{
+	Dimension *dim = hyperspace_get_open_dimension(ht->space, 0);
+	ListCell *lc;
+
+	if (NULL == dim)
+		return false;
+
+	foreach (lc, on_conflict_set)
+	{
+		TargetEntry *tle = lfirst(lc);
+		Var *var = (Var *) tle->expr;
+
+		if (tle->resjunk || tle->resno != dim->column_attno)
+			continue;
+
+		return !(IsA(var, Var) && var->varattno == dim->column_attno &&
+				 var->varno != INNER_VAR && var->varno != OUTER_VAR);
+	}
+
+	return false;
+}
+
 /*
  * Create new insert chunk state.
  *
@@ -549,6 +580,21 @@ ts_chunk_insert_state_create(Chunk *chunk, ChunkDispatch *dispatch)
 	if (dispatch->on_conflict != ONCONFLICT_NONE)
 		chunk_insert_state_set_arbiter_indexes(state, dispatch, rel);
 
+	ts_chunk_time_range_tracker_init(&state->time_range, dispatch->hypertable, chunk);
+
+	/*
+	 * The tracked time values are taken before row triggers run, and updates
+	 * on conflict can move existing rows, so the time range is unknown after
+	 * such inserts.
+	 */
+	if (resrelinfo->ri_TrigDesc != NULL && resrelinfo->ri_TrigDesc->trig_insert_before_row)
+		state->time_range.invalidate = true;
+
+	if (dispatch->on_conflict == ONCONFLICT_UPDATE &&
+		((resrelinfo->ri_TrigDesc != NULL && resrelinfo->ri_TrigDesc->trig_update_before_row) ||
+		 on_conflict_set_updates_time(dispatch->on_conflict_set, dispatch->hypertable)))
+		state->time_range.invalidate = true;
+
 	/* Set tuple conversion map, if tuple needs conversion */
 	parent_rel = heap_open(dispatch->hypertable->main_table_relid, AccessShareLock);
 
@@ -13,6 +13,7 @@
 
 #include "hypertable.h"
 #include "chunk.h"
+#include "chunk_statistics.h"
 #include "cache.h"
 #include "chunk_dispatch_state.h"
 
@@ -26,6 +27,7 @@ typedef struct ChunkInsertState
 	MemoryContext mctx;
 
 	EState *estate;
+	ChunkTimeRangeTracker time_range;
 } ChunkInsertState;
 
 typedef struct ChunkDispatch ChunkDispatch;
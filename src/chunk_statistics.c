@@ -0,0 +1,784 @@
+/*
+ * This file and its contents are licensed under the Apache License 2.0.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-APACHE for a copy of the license.
+ */
+#include <postgres.h>
+#include <access/htup_details.h>
+#include <catalog/pg_class.h>
+#include <executor/executor.h>
+#include <miscadmin.h>
+#include <parser/parsetree.h>
+#include <storage/lmgr.h>
+#include <utils/builtins.h>
+#include <utils/fmgroids.h>
+#include <utils/inval.h>
+#include <utils/lsyscache.h>
+#include <utils/syscache.h>
+#include <utils/timestamp.h>
+#include <math.h>
+
+#include "chunk_statistics.h"
+#include "chunk.h"
+#include "chunk_adaptive.h"
+#include "compat.h"
+#include "dimension.h"
+#include "dimension_slice.h"
+#include "extension.h"
+#include "hypercube.h"
+#include "hypertable.h"
+#include "hypertable_cache.h"
+#include "scanner.h"
+#include "utils.h"
+
+void _chunk_statistics_init(void);
+void _chunk_statistics_fini(void);
+
+static ExecutorStart_hook_type prev_ExecutorStart_hook;
+
+static void
+chunk_statistics_formdata_fill(ChunkStatistics *stats, HeapTuple tuple, TupleDesc desc)
+{
+	Datum values[Natts_chunk_statistics];
+	bool nulls[Natts_chunk_statistics];
+
+	heap_deform_tuple(tuple, desc, values, nulls);
+
+	Assert(!nulls[AttrNumberGetAttrOffset(Anum_chunk_statistics_chunk_id)]);
+	Assert(!nulls[AttrNumberGetAttrOffset(Anum_chunk_statistics_row_count)]);
+	Assert(!nulls[AttrNumberGetAttrOffset(Anum_chunk_statistics_total_bytes)]);
+
+	stats->fd.chunk_id =
+		DatumGetInt32(values[AttrNumberGetAttrOffset(Anum_chunk_statistics_chunk_id)]);
+	stats->has_time_range = !nulls[AttrNumberGetAttrOffset(Anum_chunk_statistics_min_time)] &&
+							!nulls[AttrNumberGetAttrOffset(Anum_chunk_statistics_max_time)];
+
+	if (stats->has_time_range)
+	{
+		stats->fd.min_time =
+			DatumGetInt64(values[AttrNumberGetAttrOffset(Anum_chunk_statistics_min_time)]);
+		stats->fd.max_time =
+			DatumGetInt64(values[AttrNumberGetAttrOffset(Anum_chunk_statistics_max_time)]);
+	}
+	else
+	{
+		stats->fd.min_time = 0;
+		stats->fd.max_time = 0;
+	}
+
+	stats->fd.row_count =
+		DatumGetInt64(values[AttrNumberGetAttrOffset(Anum_chunk_statistics_row_count)]);
+	stats->fd.total_bytes =
+		DatumGetInt64(values[AttrNumberGetAttrOffset(Anum_chunk_statistics_total_bytes)]);
+	stats->fd.last_modified = DatumGetTimestampTz(
+		values[AttrNumberGetAttrOffset(Anum_chunk_statistics_last_modified)]);
+	stats->fd.last_updated =
+		DatumGetTimestampTz(values[AttrNumberGetAttrOffset(Anum_chunk_statistics_last_updated)]);
+}
+
+static void
+chunk_statistics_formdata_fill_values(const ChunkStatistics *stats, Datum *values, bool *nulls)
+{
+	values[AttrNumberGetAttrOffset(Anum_chunk_statistics_chunk_id)] =
+		Int32GetDatum(stats->fd.chunk_id);
+
+	if (stats->has_time_range)
+	{
+		values[AttrNumberGetAttrOffset(Anum_chunk_statistics_min_time)] =
+			Int64GetDatum(stats->fd.min_time);
+		values[AttrNumberGetAttrOffset(Anum_chunk_statistics_max_time)] =
+			Int64GetDatum(stats->fd.max_time);
+	}
+
+	nulls[AttrNumberGetAttrOffset(Anum_chunk_statistics_min_time)] = !stats->has_time_range;
+	nulls[AttrNumberGetAttrOffset(Anum_chunk_statistics_max_time)] = !stats->has_time_range;
+
+	values[AttrNumberGetAttrOffset(Anum_chunk_statistics_row_count)] =
+		Int64GetDatum(stats->fd.row_count);
+	values[AttrNumberGetAttrOffset(Anum_chunk_statistics_total_bytes)] =
+		Int64GetDatum(stats->fd.total_bytes);
+	values[AttrNumberGetAttrOffset(Anum_chunk_statistics_last_modified)] =
+		TimestampTzGetDatum(stats->fd.last_modified);
+	values[AttrNumberGetAttrOffset(Anum_chunk_statistics_last_updated)] =
+		TimestampTzGetDatum(stats->fd.last_updated);
+}
+
+static ScanTupleResult
+chunk_statistics_tuple_found(TupleInfo *ti, void *data)
+{
+	chunk_statistics_formdata_fill(data, ti->tuple, ti->desc);
+
+	return SCAN_DONE;
+}
+
+static void
+chunk_statistics_scankey_init(ScanKeyData *scankey, int32 chunk_id)
+{
+	ScanKeyInit(scankey,
+				Anum_chunk_statistics_pkey_idx_chunk_id,
+				BTEqualStrategyNumber,
+				F_INT4EQ,
+				Int32GetDatum(chunk_id));
+}
+
+/*
+ * Get the cached statistics of a chunk.
+ *
+ * Returns false if the statistics of the chunk have never been collected.
+ */
+bool
+ts_chunk_statistics_get(int32 chunk_id, ChunkStatistics *stats)
+{
+	ScanKeyData scankey[1];
+
+	chunk_statistics_scankey_init(&scankey[0], chunk_id);
+
+	return ts_catalog_scan_one(CHUNK_STATISTICS,
+							   CHUNK_STATISTICS_PKEY_IDX,
+							   scankey,
+							   1,
+							   chunk_statistics_tuple_found,
+							   AccessShareLock,
+							   CHUNK_STATISTICS_TABLE_NAME,
+							   stats);
+}
+
+static bool
+chunk_statistics_time_range_equal(const ChunkStatistics *left, const ChunkStatistics *right)
+{
+	if (left->has_time_range != right->has_time_range)
+		return false;
+
+	return !left->has_time_range ||
+		   (left->fd.min_time == right->fd.min_time && left->fd.max_time == right->fd.max_time);
+}
+
+static bool
+chunk_statistics_equal(const ChunkStatistics *left, const ChunkStatistics *right)
+{
+	return chunk_statistics_time_range_equal(left, right) &&
+		   left->fd.row_count == right->fd.row_count &&
+		   left->fd.total_bytes == right->fd.total_bytes;
+}
+
+/*
+ * Check if the cached time range of a chunk covers the given range. An
+ * unknown time range covers everything.
+ */
+static bool
+chunk_statistics_time_range_covers(const ChunkStatistics *stats, int64 min_time, int64 max_time)
+{
+	return !stats->has_time_range ||
+		   (stats->fd.min_time <= min_time && stats->fd.max_time >= max_time);
+}
+
+static ScanTupleResult
+chunk_statistics_update_tuple_found(TupleInfo *ti, void *data)
+{
+	ChunkStatistics *stats = data;
+	Datum values[Natts_chunk_statistics];
+	bool nulls[Natts_chunk_statistics] = { false };
+	HeapTuple new_tuple;
+	CatalogSecurityContext sec_ctx;
+
+	chunk_statistics_formdata_fill_values(stats, values, nulls);
+	new_tuple = heap_form_tuple(ti->desc, values, nulls);
+
+	ts_catalog_database_info_become_owner(ts_catalog_database_info_get(), &sec_ctx);
+	ts_catalog_update_tid(ti->scanrel, &ti->tuple->t_self, new_tuple);
+	ts_catalog_restore_user(&sec_ctx);
+
+	heap_freetuple(new_tuple);
+
+	return SCAN_DONE;
+}
+
+static void
+chunk_statistics_update(ChunkStatistics *stats)
+{
+	ScanKeyData scankey[1];
+
+	chunk_statistics_scankey_init(&scankey[0], stats->fd.chunk_id);
+
+	ts_catalog_scan_one(CHUNK_STATISTICS,
+						CHUNK_STATISTICS_PKEY_IDX,
+						scankey,
+						1,
+						chunk_statistics_update_tuple_found,
+						RowExclusiveLock,
+						CHUNK_STATISTICS_TABLE_NAME,
+						stats);
+}
+
+static void
+chunk_statistics_insert(ChunkStatistics *stats)
+{
+	Catalog *catalog = ts_catalog_get();
+	Relation rel = heap_open(catalog_get_table_id(catalog, CHUNK_STATISTICS), RowExclusiveLock);
+	Datum values[Natts_chunk_statistics];
+	bool nulls[Natts_chunk_statistics] = { false };
+	CatalogSecurityContext sec_ctx;
+
+	chunk_statistics_formdata_fill_values(stats, values, nulls);
+
+	ts_catalog_database_info_become_owner(ts_catalog_database_info_get(), &sec_ctx);
+	ts_catalog_insert_values(rel, RelationGetDescr(rel), values, nulls);
+	ts_catalog_restore_user(&sec_ctx);
+	heap_close(rel, RowExclusiveLock);
+}
+
+/*
+ * Lock the statistics of a chunk for writing.
+ *
+ * Writers of the statistics of a chunk are serialized with a lock that is
+ * held until the end of the transaction. This avoids failing on concurrent
+ * updates of the same row, or on concurrent inserts of the same chunk, but
+ * does not block readers.
+ *
+ * Returns false if nowait is set and the lock is held by someone else.
+ */
+static bool
+chunk_statistics_lock(int32 chunk_id, bool nowait)
+{
+	LOCKTAG tag;
+
+	SET_LOCKTAG_OBJECT(tag,
+					   MyDatabaseId,
+					   catalog_get_table_id(ts_catalog_get(), CHUNK_STATISTICS),
+					   chunk_id,
+					   0);
+
+	return LockAcquire(&tag, ExclusiveLock, false, nowait) != LOCKACQUIRE_NOT_AVAIL;
+}
+
+/*
+ * Store new statistics for a chunk, updating the existing row or inserting a
+ * new one. The cached time range is left as is unless update_time_range is
+ * set.
+ *
+ * Returns true if plans that relied on the previous time range are no longer
+ * valid, i.e., if the time range grew or became unknown.
+ */
+static bool
+chunk_statistics_store(ChunkStatistics *stats, bool update_time_range)
+{
+	ChunkStatistics old;
+
+	chunk_statistics_lock(stats->fd.chunk_id, false);
+
+	stats->fd.last_updated = GetCurrentTimestamp();
+	stats->fd.last_modified = stats->fd.last_updated;
+
+	if (!ts_chunk_statistics_get(stats->fd.chunk_id, &old))
+	{
+		if (!update_time_range)
+			stats->has_time_range = false;
+
+		chunk_statistics_insert(stats);
+
+		return false;
+	}
+
+	if (!update_time_range)
+	{
+		stats->has_time_range = old.has_time_range;
+		stats->fd.min_time = old.fd.min_time;
+		stats->fd.max_time = old.fd.max_time;
+	}
+
+	/* Only bump the modification time if the chunk actually changed */
+	if (chunk_statistics_equal(&old, stats))
+		stats->fd.last_modified = old.fd.last_modified;
+
+	chunk_statistics_update(stats);
+
+	return old.has_time_range &&
+		   (!stats->has_time_range ||
+			!chunk_statistics_time_range_covers(&old, stats->fd.min_time, stats->fd.max_time));
+}
+
+/*
+ * Get the actual time range of a chunk using an index on the time column.
+ *
+ * Returns false if the time range cannot be determined cheaply, in which case
+ * the cached time range is left as is.
+ */
+static bool
+chunk_statistics_get_time_range(Hypertable *ht, Chunk *chunk, ChunkStatistics *stats)
+{
+	Dimension *dim = hyperspace_get_open_dimension(ht->space, 0);
+	const char *attname;
+	AttrNumber attno;
+	Datum minmax[2];
+
+	/* Values transformed by a partitioning function are not time values */
+	if (NULL == dim || NULL != dim->partitioning)
+		return false;
+
+	attname = get_attname_compat(ht->main_table_relid, dim->column_attno, false);
+	attno = get_attnum(chunk->table_id, attname);
+
+	if (attno == InvalidAttrNumber)
+		return false;
+
+	/*
+	 * Only narrow the time range if there are no concurrent writers. Inserts
+	 * that come after this extend the range once the lock is released.
+	 */
+	if (!ConditionalLockRelationOid(chunk->table_id, ShareLock))
+		return false;
+
+	switch (ts_chunk_get_minmax_indexscan(chunk->table_id, dim->fd.column_type, attno, minmax))
+	{
+		case MINMAX_NO_INDEX:
+			return false;
+		case MINMAX_NO_TUPLES:
+			stats->has_time_range = false;
+			break;
+		case MINMAX_FOUND:
+		{
+			int64 first = ts_time_value_to_internal(minmax[0], dim->fd.column_type, false);
+			int64 second = ts_time_value_to_internal(minmax[1], dim->fd.column_type, false);
+
+			/* The order depends on the direction of the index */
+			stats->fd.min_time = Min(first, second);
+			stats->fd.max_time = Max(first, second);
+			stats->has_time_range = true;
+			break;
+		}
+	}
+
+	return true;
+}
+
+static int64
+chunk_statistics_get_row_count(Oid relid)
+{
+	HeapTuple tuple = SearchSysCache1(RELOID, ObjectIdGetDatum(relid));
+	int64 row_count = 0;
+
+	if (HeapTupleIsValid(tuple))
+	{
+		row_count = (int64) rint(((Form_pg_class) GETSTRUCT(tuple))->reltuples);
+		ReleaseSysCache(tuple);
+	}
+
+	return row_count;
+}
+
+/*
+ * Refresh the cached statistics of a chunk.
+ *
+ * The row count is the planner's estimate (reltuples), so this is meant to be
+ * called after the chunk has been analyzed or rewritten.
+ */
+void
+ts_chunk_statistics_refresh(Hypertable *ht, Chunk *chunk)
+{
+	ChunkStatistics stats = {
+		.fd.chunk_id = chunk->fd.id,
+	};
+	bool has_time_range;
+
+	/* The chunk might have been dropped concurrently */
+	LockRelationOid(chunk->table_id, AccessShareLock);
+
+	if (!SearchSysCacheExists1(RELOID, ObjectIdGetDatum(chunk->table_id)))
+	{
+		UnlockRelationOid(chunk->table_id, AccessShareLock);
+		return;
+	}
+
+	/*
+	 * Take the statistics lock before looking at the data, so that inserts
+	 * extending the range wait for the new range rather than extend the old
+	 * one. Inserts can hold the locks of several chunks, so skip the chunk
+	 * rather than risk a deadlock. The next refresh will pick it up.
+	 */
+	if (!chunk_statistics_lock(chunk->fd.id, true))
+		return;
+
+	has_time_range = chunk_statistics_get_time_range(ht, chunk, &stats);
+	stats.fd.row_count = chunk_statistics_get_row_count(chunk->table_id);
+	stats.fd.total_bytes = DatumGetInt64(
+		DirectFunctionCall1(pg_total_relation_size, ObjectIdGetDatum(chunk->table_id)));
+
+	if (chunk_statistics_store(&stats, has_time_range))
+		CacheInvalidateRelcacheByRelid(ht->main_table_relid);
+}
+
+/*
+ * Pad a time value by the given amount in either direction, but stay within
+ * the limit.
+ */
+static int64
+time_range_pad_down(int64 time, int64 padding, int64 limit)
+{
+	if (time < PG_INT64_MIN + padding || time - padding < limit)
+		return Min(time, limit);
+
+	return time - padding;
+}
+
+static int64
+time_range_pad_up(int64 time, int64 padding, int64 limit)
+{
+	if (time > PG_INT64_MAX - padding || time + padding > limit)
+		return Max(time, limit);
+
+	return time + padding;
+}
+
+void
+ts_chunk_time_range_tracker_init(ChunkTimeRangeTracker *tracker, Hypertable *ht, Chunk *chunk)
+{
+	Dimension *dim = hyperspace_get_open_dimension(ht->space, 0);
+	DimensionSlice *slice;
+
+	memset(tracker, 0, sizeof(*tracker));
+	tracker->chunk_id = chunk->fd.id;
+	tracker->hypertable_relid = ht->main_table_relid;
+	tracker->dimension_index = -1;
+
+	/* Values transformed by a partitioning function are not time values */
+	if (NULL == dim || NULL != dim->partitioning || NULL == chunk->cube)
+		return;
+
+	slice = ts_hypercube_get_slice_by_dimension_id(chunk->cube, dim->fd.id);
+
+	if (NULL == slice)
+		return;
+
+	tracker->covers_all = false;
+
+	tracker->dimension_index = dim - ht->space->dimensions;
+	tracker->slice_start = slice->fd.range_start;
+	tracker->slice_end = slice->fd.range_end;
+	tracker->padding = dim->fd.interval_length / CHUNK_TIME_RANGE_PADDING_FRACTION;
+}
+
+/*
+ * Make the cached time range of a chunk unknown, e.g., because the chunk is
+ * written in ways that are not tracked.
+ *
+ * The caller must hold RowExclusiveLock on the chunk, as writers do. The lock
+ * conflicts with the lock taken by a refresh, so a known range cannot
+ * reappear until the writes are done.
+ */
+static void
+chunk_statistics_invalidate_time_range(int32 chunk_id, Oid hypertable_relid)
+{
+	ChunkStatistics stats;
+
+	if (!ts_chunk_statistics_get(chunk_id, &stats) || !stats.has_time_range)
+		return;
+
+	chunk_statistics_lock(chunk_id, false);
+
+	if (!ts_chunk_statistics_get(chunk_id, &stats) || !stats.has_time_range)
+		return;
+
+	stats.has_time_range = false;
+	stats.fd.last_updated = GetCurrentTimestamp();
+	stats.fd.last_modified = stats.fd.last_updated;
+
+	/*
+	 * Queue the invalidation before the update, so that the command counter
+	 * increment of the update processes it and plans made later in the same
+	 * statement, e.g., by triggers, see the new range.
+	 */
+	CacheInvalidateRelcacheByRelid(hypertable_relid);
+	chunk_statistics_update(&stats);
+}
+
+/*
+ * Extend the cached time range of a chunk to cover a time value that is about
+ * to be inserted, or make it unknown if the tracker invalidates it. Plans that
+ * relied on the old range are invalidated before the tuple is inserted.
+ *
+ * The new range is padded so that inserts with increasing time values only
+ * need to update the catalog, and invalidate plans, once in a while. The range
+ * read from the catalog is remembered, so that values within it are only
+ * compared. It cannot shrink while the chunk is written, since a refresh
+ * needs a lock that conflicts with the writers' RowExclusiveLock.
+ */
+void
+ts_chunk_time_range_tracker_extend(ChunkTimeRangeTracker *tracker, int64 time)
+{
+	ChunkStatistics stats;
+	bool found;
+
+	if (tracker->invalidate)
+	{
+		chunk_statistics_invalidate_time_range(tracker->chunk_id, tracker->hypertable_relid);
+		tracker->covers_all = true;
+		return;
+	}
+
+	/* Values of an untracked dimension leave the range as is */
+	if (tracker->dimension_index < 0)
+	{
+		tracker->covers_all = true;
+		return;
+	}
+
+	/* Most inserts fall within the range, so check without the lock first */
+	found = ts_chunk_statistics_get(tracker->chunk_id, &stats);
+
+	if (found && !chunk_statistics_time_range_covers(&stats, time, time))
+	{
+		chunk_statistics_lock(tracker->chunk_id, false);
+		found = ts_chunk_statistics_get(tracker->chunk_id, &stats);
+
+		if (found && !chunk_statistics_time_range_covers(&stats, time, time))
+		{
+			stats.fd.min_time =
+				Min(stats.fd.min_time,
+					time_range_pad_down(time, tracker->padding, tracker->slice_start));
+			stats.fd.max_time =
+				Max(stats.fd.max_time,
+					time_range_pad_up(time, tracker->padding, tracker->slice_end - 1));
+			stats.fd.last_updated = GetCurrentTimestamp();
+			stats.fd.last_modified = stats.fd.last_updated;
+			/* See chunk_statistics_invalidate_time_range() for the order */
+			CacheInvalidateRelcacheByRelid(tracker->hypertable_relid);
+			chunk_statistics_update(&stats);
+		}
+	}
+
+	/* Without statistics or a known range, every value is covered */
+	if (!found || !stats.has_time_range)
+	{
+		tracker->covers_all = true;
+		return;
+	}
+
+	tracker->has_range = true;
+	tracker->min_time = stats.fd.min_time;
+	tracker->max_time = stats.fd.max_time;
+}
+
+/*
+ * Add the statistics of a new chunk.
+ *
+ * The time range starts out as a padded range around the point that created
+ * the chunk, and is then extended by inserts.
+ */
+void
+ts_chunk_statistics_create(Hypertable *ht, Chunk *chunk, Point *p)
+{
+	ChunkStatistics stats = {
+		.fd.chunk_id = chunk->fd.id,
+	};
+	ChunkTimeRangeTracker tracker;
+
+	ts_chunk_time_range_tracker_init(&tracker, ht, chunk);
+
+	if (tracker.dimension_index >= 0)
+	{
+		int64 time = p->coordinates[tracker.dimension_index];
+
+		stats.fd.min_time = time_range_pad_down(time, tracker.padding, tracker.slice_start);
+		stats.fd.max_time = time_range_pad_up(time, tracker.padding, tracker.slice_end - 1);
+		stats.has_time_range = true;
+	}
+
+	stats.fd.last_updated = GetCurrentTimestamp();
+	stats.fd.last_modified = stats.fd.last_updated;
+	chunk_statistics_insert(&stats);
+}
+
+static bool
+chunk_statistics_time_column_updated(Oid relid, Dimension *dim, RangeTblEntry *rte)
+{
+	AttrNumber attno = get_attnum(relid, NameStr(dim->fd.column_name));
+
+	return bms_is_member(attno - FirstLowInvalidHeapAttributeNumber, rte->updatedCols);
+}
+
+/*
+ * Make the cached time ranges of the chunks written by a ModifyTable node
+ * unknown if the writes are not seen by the insert path, i.e., inserts
+ * directly into a chunk and updates of the time column.
+ *
+ * Only the result relations of the node are considered, so an update of a
+ * hypertable only affects the chunks that are left after exclusion.
+ */
+static void
+chunk_statistics_invalidate_for_modify_table(ModifyTableState *mtstate, EState *estate)
+{
+	ModifyTable *mt = (ModifyTable *) mtstate->ps.plan;
+	Oid nominal_relid;
+	Cache *hcache;
+	Hypertable *ht;
+	Dimension *dim;
+	int i;
+
+	if (mtstate->operation != CMD_INSERT && mtstate->operation != CMD_UPDATE)
+		return;
+
+	nominal_relid = rt_fetch(mt->nominalRelation, estate->es_range_table)->relid;
+	hcache = ts_hypertable_cache_pin();
+	ht = ts_hypertable_cache_get_entry(hcache, nominal_relid);
+	dim = (NULL == ht) ? NULL : hyperspace_get_open_dimension(ht->space, 0);
+
+	for (i = 0; i < mtstate->mt_nplans; i++)
+	{
+		ResultRelInfo *rri = &mtstate->resultRelInfo[i];
+		RangeTblEntry *rte = rt_fetch(rri->ri_RangeTableIndex, estate->es_range_table);
+		Oid relid = RelationGetRelid(rri->ri_RelationDesc);
+		Chunk *chunk;
+
+		if (NULL != ht)
+		{
+			/*
+			 * Inserts into the hypertable are tracked by the insert path, so
+			 * only an update of the time column in one of its chunks needs
+			 * the chunk.
+			 */
+			if (relid == ht->main_table_relid || NULL == dim ||
+				mtstate->operation != CMD_UPDATE ||
+				!chunk_statistics_time_column_updated(relid, dim, rte))
+				continue;
+
+			chunk = ts_chunk_get_by_relid(relid, 0, false);
+
+			if (NULL != chunk)
+				chunk_statistics_invalidate_time_range(chunk->fd.id, ht->main_table_relid);
+		}
+		else if (relid == nominal_relid)
+		{
+			/*
+			 * A write directly into a table that is not a hypertable. We
+			 * need to look up the table to know if it is a chunk.
+			 */
+			Hypertable *chunk_ht;
+			Dimension *chunk_dim;
+
+			chunk = ts_chunk_get_by_relid(relid, 0, false);
+
+			if (NULL == chunk)
+				continue;
+
+			chunk_ht = ts_hypertable_cache_get_entry(hcache, chunk->hypertable_relid);
+			chunk_dim =
+				(NULL == chunk_ht) ? NULL : hyperspace_get_open_dimension(chunk_ht->space, 0);
+
+			if (NULL != chunk_dim &&
+				(mtstate->operation == CMD_INSERT ||
+				 chunk_statistics_time_column_updated(relid, chunk_dim, rte)))
+				chunk_statistics_invalidate_time_range(chunk->fd.id, chunk_ht->main_table_relid);
+		}
+	}
+
+	ts_cache_release(hcache);
+}
+
+/*
+ * Invalidate cached time ranges when a write starts executing, rather than
+ * when it is planned, so that prepared statements and cached plans also
+ * invalidate the ranges each time they write. The result relations are
+ * locked at this point, and the range is unknown before any data is written.
+ */
+static void
+chunk_statistics_executor_start(QueryDesc *queryDesc, int eflags)
+{
+	EState *estate;
+	ListCell *lc;
+
+	if (prev_ExecutorStart_hook != NULL)
+		prev_ExecutorStart_hook(queryDesc, eflags);
+	else
+		standard_ExecutorStart(queryDesc, eflags);
+
+	if ((eflags & EXEC_FLAG_EXPLAIN_ONLY) || !ts_extension_is_loaded())
+		return;
+
+	if (queryDesc->operation == CMD_SELECT && !queryDesc->plannedstmt->hasModifyingCTE)
+		return;
+
+	estate = queryDesc->estate;
+
+	/*
+	 * A top-level HypertableInsert wraps the ModifyTable of a hypertable
+	 * insert, which is tracked, so only a bare ModifyTable is of interest.
+	 * Writes in WITH queries are all on the list of auxiliary ModifyTables.
+	 */
+	if (IsA(queryDesc->planstate, ModifyTableState))
+		chunk_statistics_invalidate_for_modify_table((ModifyTableState *) queryDesc->planstate,
+													 estate);
+
+	foreach (lc, estate->es_auxmodifytables)
+		chunk_statistics_invalidate_for_modify_table(lfirst(lc), estate);
+}
+
+/*
+ * Make the cached time range unknown when copying directly into a chunk,
+ * which bypasses the insert path. The chunk is not yet locked by the copy.
+ */
+void
+ts_chunk_statistics_invalidate_for_copy(Oid relid)
+{
+	Cache *hcache;
+	Hypertable *ht;
+	Chunk *chunk = ts_chunk_get_by_relid(relid, 0, false);
+
+	if (NULL == chunk)
+		return;
+
+	hcache = ts_hypertable_cache_pin();
+	ht = ts_hypertable_cache_get_entry(hcache, chunk->hypertable_relid);
+
+	if (NULL != ht && NULL != hyperspace_get_open_dimension(ht->space, 0))
+	{
+		LockRelationOid(relid, RowExclusiveLock);
+		chunk_statistics_invalidate_time_range(chunk->fd.id, ht->main_table_relid);
+	}
+
+	ts_cache_release(hcache);
+}
+
+static ScanTupleResult
+chunk_statistics_delete_tuple_found(TupleInfo *ti, void *data)
+{
+	CatalogSecurityContext sec_ctx;
+
+	ts_catalog_database_info_become_owner(ts_catalog_database_info_get(), &sec_ctx);
+	ts_catalog_delete(ti->scanrel, ti->tuple);
+	ts_catalog_restore_user(&sec_ctx);
+
+	return SCAN_CONTINUE;
+}
+
+int
+ts_chunk_statistics_delete_by_chunk_id(int32 chunk_id)
+{
+	Catalog *catalog = ts_catalog_get();
+	ScanKeyData scankey[1];
+	ScannerCtx scanctx = {
+		.table = catalog_get_table_id(catalog, CHUNK_STATISTICS),
+		.index = catalog_get_index(catalog, CHUNK_STATISTICS, CHUNK_STATISTICS_PKEY_IDX),
+		.nkeys = 1,
+		.scankey = scankey,
+		.tuple_found = chunk_statistics_delete_tuple_found,
+		.lockmode = RowExclusiveLock,
+		.scandirection = ForwardScanDirection,
+	};
+
+	chunk_statistics_scankey_init(&scankey[0], chunk_id);
+
+	return ts_scanner_scan(&scanctx);
+}
+
+void
+_chunk_statistics_init(void)
+{
+	prev_ExecutorStart_hook = ExecutorStart_hook;
+	ExecutorStart_hook = chunk_statistics_executor_start;
+}
+
+void
+_chunk_statistics_fini(void)
+{
+	ExecutorStart_hook = prev_ExecutorStart_hook;
+}
@@ -0,0 +1,92 @@
+/*
+ * This file and its contents are licensed under the Apache License 2.0.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-APACHE for a copy of the license.
+ */
+#ifndef TIMESCALEDB_CHUNK_STATISTICS_H
+#define TIMESCALEDB_CHUNK_STATISTICS_H
+
+#include <postgres.h>
+
+#include "catalog.h"
+#include "dimension.h"
+#include "export.h"
+
+typedef struct Chunk Chunk;
+typedef struct Hypertable Hypertable;
+
+/*
+ * Cached statistics of a chunk, kept in the chunk_statistics catalog table.
+ *
+ * The time range covers the values of the chunk's open ("time") dimension, in
+ * internal time format, and is usually much narrower than the range of the
+ * chunk's dimension slice. It is maintained by inserts and narrowed to the
+ * actual min and max by ANALYZE, so it is always a superset of the data in the
+ * chunk and can be used to exclude the chunk from queries. It is unset (NULL
+ * in the catalog) when the chunk is empty or the range is not known.
+ */
+typedef struct ChunkStatistics
+{
+	FormData_chunk_statistics fd;
+	bool has_time_range;
+} ChunkStatistics;
+
+/* Inserts extend the time range by this fraction of the chunk interval */
+#define CHUNK_TIME_RANGE_PADDING_FRACTION 16
+
+/*
+ * Keeps the cached time range of a chunk ahead of the time values inserted
+ * into it. The range is extended before the first tuple outside of it is
+ * inserted, so that queries run during the insert, e.g., by triggers, do not
+ * exclude the chunk.
+ */
+typedef struct ChunkTimeRangeTracker
+{
+	int32 chunk_id;
+	Oid hypertable_relid;
+	/* Index of the time dimension in a point, or -1 if not tracked */
+	int dimension_index;
+	int64 slice_start;
+	int64 slice_end;
+	int64 padding;
+	/* Set if the inserts can also move existing rows in time */
+	bool invalidate;
+	/* Set once the cached range is known to cover all inserted values */
+	bool covers_all;
+	/* The cached range, once read */
+	bool has_range;
+	int64 min_time;
+	int64 max_time;
+} ChunkTimeRangeTracker;
+
+extern void ts_chunk_time_range_tracker_extend(ChunkTimeRangeTracker *tracker, int64 time);
+
+static inline void
+ts_chunk_time_range_tracker_add(ChunkTimeRangeTracker *tracker, Point *p)
+{
+	int64 time;
+
+	if (tracker->covers_all)
+		return;
+
+	if (tracker->invalidate || tracker->dimension_index < 0)
+	{
+		ts_chunk_time_range_tracker_extend(tracker, 0);
+		return;
+	}
+
+	time = p->coordinates[tracker->dimension_index];
+
+	if (!tracker->has_range || time < tracker->min_time || time > tracker->max_time)
+		ts_chunk_time_range_tracker_extend(tracker, time);
+}
+
+extern bool ts_chunk_statistics_get(int32 chunk_id, ChunkStatistics *stats);
+extern TSDLLEXPORT void ts_chunk_statistics_refresh(Hypertable *ht, Chunk *chunk);
+extern void ts_chunk_statistics_create(Hypertable *ht, Chunk *chunk, Point *p);
+extern void ts_chunk_statistics_invalidate_for_copy(Oid relid);
+extern int ts_chunk_statistics_delete_by_chunk_id(int32 chunk_id);
+extern void ts_chunk_time_range_tracker_init(ChunkTimeRangeTracker *tracker, Hypertable *ht,
+											 Chunk *chunk);
+
+#endif /* TIMESCALEDB_CHUNK_STATISTICS_H */
@@ -0,0 +1,309 @@
+/*
+ * This file and its contents are licensed under the Apache License 2.0.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-APACHE for a copy of the license.
+ */
+#include <postgres.h>
+#include <access/brin_internal.h>
+#include <access/brin_revmap.h>
+#include <access/brin_tuple.h>
+#include <access/genam.h>
+#include <access/heapam.h>
+#include <access/stratnum.h>
+#include <catalog/pg_am.h>
+#include <miscadmin.h>
+#include <nodes/relation.h>
+#include <storage/bufmgr.h>
+#include <utils/fmgroids.h>
+#include <utils/lsyscache.h>
+#include <utils/memutils.h>
+#include <utils/rel.h>
+
+#include "chunk_summary.h"
+#include "compat.h"
+
+/*
+ * A restriction on the summarized column, normalized to "column op value".
+ *
+ * A block range can only hold matching values if "min min_proc value" and
+ * "max max_proc value" are true for its summary.
+ */
+typedef struct SummaryClause
+{
+	Datum value;
+	Oid collation;
+	bool check_min;
+	bool check_max;
+	FmgrInfo min_proc;
+	FmgrInfo max_proc;
+} SummaryClause;
+
+static bool
+summary_clause_init(SummaryClause *sc, Expr *clause, Index rt_index, AttrNumber attno,
+					Oid opfamily, Oid collation)
+{
+	OpExpr *op;
+	Expr *leftop, *rightop;
+	Var *var;
+	Const *c;
+	Oid opno, lefttype, righttype, le_opno, ge_opno;
+	int strategy;
+
+	if (!IsA(clause, OpExpr))
+		return false;
+
+	op = (OpExpr *) clause;
+
+	if (list_length(op->args) != 2)
+		return false;
+
+	leftop = linitial(op->args);
+	rightop = lsecond(op->args);
+	opno = op->opno;
+
+	if (IsA(leftop, RelabelType))
+		leftop = ((RelabelType *) leftop)->arg;
+	if (IsA(rightop, RelabelType))
+		rightop = ((RelabelType *) rightop)->arg;
+
+	if (IsA(leftop, Var) && IsA(rightop, Const))
+	{
+		var = (Var *) leftop;
+		c = (Const *) rightop;
+	}
+	else if (IsA(rightop, Var) && IsA(leftop, Const))
+	{
+		var = (Var *) rightop;
+		c = (Const *) leftop;
+		opno = get_commutator(opno);
+	}
+	else
+		return false;
+
+	if (var->varno != rt_index || var->varattno != attno || var->varlevelsup != 0 ||
+		c->constisnull || !OidIsValid(opno) || !op_strict(opno))
+		return false;
+
+	/* The summaries are ordered according to the index collation */
+	if (OidIsValid(op->inputcollid) && op->inputcollid != collation)
+		return false;
+
+	if (!op_in_opfamily(opno, opfamily))
+		return false;
+
+	get_op_opfamily_properties(opno, opfamily, false, &strategy, &lefttype, &righttype);
+
+	sc->value = c->constvalue;
+	sc->collation = op->inputcollid;
+	sc->check_min = false;
+	sc->check_max = false;
+
+	switch (strategy)
+	{
+		case BTLessStrategyNumber:
+		case BTLessEqualStrategyNumber:
+			fmgr_info(get_opcode(opno), &sc->min_proc);
+			sc->check_min = true;
+			break;
+		case BTGreaterEqualStrategyNumber:
+		case BTGreaterStrategyNumber:
+			fmgr_info(get_opcode(opno), &sc->max_proc);
+			sc->check_max = true;
+			break;
+		case BTEqualStrategyNumber:
+			le_opno = get_opfamily_member(opfamily, lefttype, righttype, BTLessEqualStrategyNumber);
+			ge_opno =
+				get_opfamily_member(opfamily, lefttype, righttype, BTGreaterEqualStrategyNumber);
+
+			if (!OidIsValid(le_opno) || !OidIsValid(ge_opno))
+				return false;
+
+			fmgr_info(get_opcode(le_opno), &sc->min_proc);
+			fmgr_info(get_opcode(ge_opno), &sc->max_proc);
+			sc->check_min = true;
+			sc->check_max = true;
+			break;
+		default:
+			return false;
+	}
+
+	return true;
+}
+
+/*
+ * Get the restrictions that a summary index can refute. Only single-column
+ * minmax BRIN indexes are chunk summaries.
+ */
+static List *
+summary_clauses(Relation indexrel, Index rt_index, List *restrictinfos)
+{
+	Form_pg_index index = indexrel->rd_index;
+	List *clauses = NIL;
+	ListCell *lc;
+
+	if (indexrel->rd_rel->relam != BRIN_AM_OID || index->indnatts != 1 ||
+		index->indkey.values[0] == InvalidAttrNumber || !IndexIsValid(index) ||
+		RelationGetIndexPredicate(indexrel) != NIL ||
+		index_getprocid(indexrel, 1, BRIN_PROCNUM_OPCINFO) != F_BRIN_MINMAX_OPCINFO)
+		return NIL;
+
+	foreach (lc, restrictinfos)
+	{
+		RestrictInfo *rinfo = lfirst(lc);
+		SummaryClause *sc = palloc(sizeof(SummaryClause));
+
+		if (summary_clause_init(sc,
+								rinfo->clause,
+								rt_index,
+								index->indkey.values[0],
+								indexrel->rd_opfamily[0],
+								indexrel->rd_indcollation[0]))
+			clauses = lappend(clauses, sc);
+		else
+			pfree(sc);
+	}
+
+	return clauses;
+}
+
+static bool
+summary_range_excluded(BrinValues *bval, List *clauses)
+{
+	ListCell *lc;
+
+	/* The operators are strict, so they never match a range of NULLs */
+	if (bval->bv_allnulls)
+		return true;
+
+	foreach (lc, clauses)
+	{
+		SummaryClause *sc = lfirst(lc);
+
+		if (sc->check_min &&
+			!DatumGetBool(
+				FunctionCall2Coll(&sc->min_proc, sc->collation, bval->bv_values[0], sc->value)))
+			return true;
+
+		if (sc->check_max &&
+			!DatumGetBool(
+				FunctionCall2Coll(&sc->max_proc, sc->collation, bval->bv_values[1], sc->value)))
+			return true;
+	}
+
+	return false;
+}
+
+/*
+ * Check if the summaries of all block ranges of a relation refute the
+ * clauses. Inserts widen the summary of a range before they commit, but a
+ * range that is not summarized yet can hold any values, so a single such
+ * range means the relation cannot be excluded.
+ */
+static bool
+summary_excluded(Relation rel, Relation indexrel, List *clauses, Snapshot snapshot)
+{
+	BlockNumber nblocks = RelationGetNumberOfBlocks(rel);
+	BlockNumber pages_per_range;
+	BlockNumber blkno;
+	BrinRevmap *revmap;
+	BrinDesc *bdesc;
+	Buffer buf = InvalidBuffer;
+	MemoryContext range_mcxt;
+	bool excluded = true;
+
+	revmap = brinRevmapInitialize(indexrel, &pages_per_range, snapshot);
+	bdesc = brin_build_desc(indexrel);
+	range_mcxt =
+		AllocSetContextCreate(CurrentMemoryContext, "Chunk summary range", ALLOCSET_SMALL_SIZES);
+
+	for (blkno = 0; blkno < nblocks && excluded; blkno += pages_per_range)
+	{
+		BrinTuple *tup;
+		BrinMemTuple *dtup;
+		OffsetNumber off;
+		Size size;
+		MemoryContext old;
+
+		CHECK_FOR_INTERRUPTS();
+
+		tup = brinGetTupleForHeapBlock(revmap,
+									   blkno,
+									   &buf,
+									   &off,
+									   &size,
+									   BUFFER_LOCK_SHARE,
+									   snapshot);
+
+		if (tup == NULL)
+		{
+			excluded = false;
+			break;
+		}
+
+		/* Deforming copies the summary values, so the page can be unlocked */
+		old = MemoryContextSwitchTo(range_mcxt);
+		dtup = brin_deform_tuple_compat(bdesc, tup);
+		LockBuffer(buf, BUFFER_LOCK_UNLOCK);
+
+		/* Placeholders are for ranges that are being summarized concurrently */
+		excluded = !dtup->bt_placeholder && summary_range_excluded(&dtup->bt_columns[0], clauses);
+
+		MemoryContextSwitchTo(old);
+		MemoryContextReset(range_mcxt);
+	}
+
+	if (BufferIsValid(buf))
+		ReleaseBuffer(buf);
+
+	brinRevmapTerminate(revmap);
+	brin_free_desc(bdesc);
+	MemoryContextDelete(range_mcxt);
+
+	return excluded;
+}
+
+/*
+ * Check if the summary indexes of a chunk prove that none of its rows match
+ * the restrictions.
+ *
+ * The summaries change with every insert without invalidating plans, so this
+ * is only safe at execution time, with restrictions that are already reduced
+ * to constants.
+ */
+bool
+ts_chunk_summary_excludes(Oid relid, Index rt_index, List *restrictinfos, Snapshot snapshot)
+{
+	MemoryContext mcxt, old;
+	Relation rel;
+	ListCell *lc;
+	bool excluded = false;
+
+	if (restrictinfos == NIL)
+		return false;
+
+	mcxt = AllocSetContextCreate(CurrentMemoryContext, "Chunk summary", ALLOCSET_SMALL_SIZES);
+	old = MemoryContextSwitchTo(mcxt);
+
+	rel = heap_open(relid, AccessShareLock);
+
+	foreach (lc, RelationGetIndexList(rel))
+	{
+		Relation indexrel = index_open(lfirst_oid(lc), AccessShareLock);
+		List *clauses = summary_clauses(indexrel, rt_index, restrictinfos);
+
+		if (clauses != NIL)
+			excluded = summary_excluded(rel, indexrel, clauses, snapshot);
+
+		index_close(indexrel, AccessShareLock);
+
+		if (excluded)
+			break;
+	}
+
+	heap_close(rel, AccessShareLock);
+
+	MemoryContextSwitchTo(old);
+	MemoryContextDelete(mcxt);
+
+	return excluded;
+}
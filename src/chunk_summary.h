@@ -0,0 +1,22 @@
+/*
+ * This file and its contents are licensed under the Apache License 2.0.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-APACHE for a copy of the license.
+ */
+#ifndef TIMESCALEDB_CHUNK_SUMMARY_H
+#define TIMESCALEDB_CHUNK_SUMMARY_H
+
+#include <postgres.h>
+#include <nodes/pg_list.h>
+#include <utils/snapshot.h>
+
+/*
+ * Chunk summaries are the block-range (BRIN) minmax indexes of a chunk. A
+ * BRIN index created on a hypertable is created on every chunk, so it keeps a
+ * cheap min/max summary of the indexed column for each chunk that can be used
+ * to exclude the chunk as a whole.
+ */
+extern bool ts_chunk_summary_excludes(Oid relid, Index rt_index, List *restrictinfos,
+									  Snapshot snapshot);
+
+#endif /* TIMESCALEDB_CHUNK_SUMMARY_H */
@@ -89,6 +89,18 @@
 	BackgroundWorkerInitializeConnection(dbname, username, BGWORKER_NO_FLAGS)
 #endif
 
+/*
+ * brin_deform_tuple
+ *
+ * PG11 added an argument to reuse an already allocated in-memory tuple. We
+ * always let it allocate a new one.
+ */
+#if PG96 || PG10
+#define brin_deform_tuple_compat(brdesc, tuple) brin_deform_tuple(brdesc, tuple)
+#else
+#define brin_deform_tuple_compat(brdesc, tuple) brin_deform_tuple(brdesc, tuple, NULL)
+#endif
+
 /* CatalogTuple functions not implemented until pg10 */
 #if PG96
 #define CatalogTupleInsert(relation, tuple)                                                        \
@@ -270,6 +282,24 @@ MakeTupleTableSlotCompat(TupleDesc tupdesc)
 #define MakeTupleTableSlotCompat MakeTupleTableSlot
 #endif
 
+/*
+ * ExplainPropertyInteger & ExplainPropertyFloat
+ *
+ * PG11 added a unit argument to the explain property functions and made
+ * ExplainPropertyInteger take an int64 (see:
+ * https://github.com/postgres/postgres/commit/7a50bb690b4837d29e715293c156cff2fc72885c).
+ * Older versions ignore the unit.
+ */
+#if PG96 || PG10
+#define ExplainPropertyIntegerCompat(qlabel, unit, value, es)                                      \
+	ExplainPropertyLong(qlabel, value, es)
+#define ExplainPropertyFloatCompat(qlabel, unit, value, ndigits, es)                               \
+	ExplainPropertyFloat(qlabel, value, ndigits, es)
+#else
+#define ExplainPropertyIntegerCompat ExplainPropertyInteger
+#define ExplainPropertyFloatCompat ExplainPropertyFloat
+#endif
+
 /*
  * get_attname
  *
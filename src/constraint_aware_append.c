@@ -13,13 +13,21 @@
 #include <optimizer/prep.h>
 #include <executor/executor.h>
 #include <catalog/pg_class.h>
+#include <catalog/pg_inherits.h>
 #include <utils/memutils.h>
 #include <utils/lsyscache.h>
 #include <commands/explain.h>
 
+#include "compat.h"
+#if PG96 || PG10 /* PG11 consolidates pg_foo_fn.h -> pg_foo.h */
+#include <catalog/pg_inherits_fn.h>
+#endif
+#include "chunk_summary.h"
 #include "constraint_aware_append.h"
+#include "guc.h"
 #include "hypertable.h"
-#include "compat.h"
+#include "planner.h"
+#include "stats.h"
 
 /*
  * Exclude child relations (chunks) at execution time based on constraints.
@@ -86,8 +94,12 @@ can_exclude_chunk(PlannerInfo *root, Scan *scan, EState *estate, Index rt_index,
 {
 	RangeTblEntry *rte = rt_fetch(scan->scanrelid, estate->es_range_table);
 
-	return rte->rtekind == RTE_RELATION && rte->relkind == RELKIND_RELATION && !rte->inh &&
-		   excluded_by_constraint(root, rte, rt_index, restrictinfos);
+	if (rte->rtekind != RTE_RELATION || rte->relkind != RELKIND_RELATION || rte->inh)
+		return false;
+
+	return excluded_by_constraint(root, rte, rt_index, restrictinfos) ||
+		   (ts_guc_enable_chunk_summary_exclusion &&
+			ts_chunk_summary_excludes(rte->relid, rt_index, restrictinfos, estate->es_snapshot));
 }
 
 /*
@@ -227,7 +239,10 @@ ca_append_begin(CustomScanState *node, EState *estate, int eflags)
 				restrictinfos = constify_restrictinfos(&root, restrictinfos);
 
 				if (can_exclude_chunk(&root, (Scan *) plan, estate, scanrelid, restrictinfos))
+				{
+					ts_stats_count(STATS_CHUNKS_EXCLUDED_EXEC);
 					continue;
+				}
 
 				*appendplans = lappend(*appendplans, plan);
 				break;
@@ -330,16 +345,53 @@ ca_append_explain(CustomScanState *node, List *ancestors, ExplainState *es)
 	Oid relid = linitial_oid(linitial(cscan->custom_private));
 
 	ExplainPropertyText("Hypertable", get_rel_name(relid), es);
-#if PG96 || PG10
-	ExplainPropertyInteger("Chunks left after exclusion", state->num_append_subplans, es);
-#else
+	ExplainPropertyIntegerCompat("Chunks left after exclusion",
+								 NULL,
+								 state->num_append_subplans,
+								 es);
 
 	/*
-	 * PG 11 adds a uint field for certain cases. (See:
-	 * https://github.com/postgres/postgres/commit/7a50bb690b4837d29e715293c156cff2fc72885c).
+	 * Show where the chunks went when asked for the details. Chunks are
+	 * either excluded at planning time, based on the catalog or on
+	 * constraints, or at executor startup.
 	 */
-	ExplainPropertyInteger("Chunks left after exclusion", NULL, state->num_append_subplans, es);
-#endif
+	if (es->analyze && es->verbose)
+	{
+		List *chunk_ri_clauses = lsecond(cscan->custom_private);
+		List *expand_details = lthird(cscan->custom_private);
+		List *all_chunks = find_inheritance_children(relid, NoLock);
+		int num_planned = list_length(chunk_ri_clauses);
+
+		ExplainPropertyIntegerCompat("Chunks total", NULL, list_length(all_chunks), es);
+		ExplainPropertyIntegerCompat("Chunks excluded during planning",
+									 NULL,
+									 Max(list_length(all_chunks) - num_planned, 0),
+									 es);
+		ExplainPropertyIntegerCompat("Chunks excluded during startup",
+									 NULL,
+									 num_planned - state->num_append_subplans,
+									 es);
+
+		if (expand_details != NIL)
+		{
+			ExplainPropertyIntegerCompat("Chunks expanded during planning",
+										 NULL,
+										 linitial_int(expand_details),
+										 es);
+			ExplainPropertyIntegerCompat("Hypertable expansion catalog scans",
+										 NULL,
+										 lsecond_int(expand_details),
+										 es);
+			if (es->timing)
+				ExplainPropertyFloatCompat("Hypertable expansion time",
+										   "ms",
+										   lthird_int(expand_details) / 1000.0,
+										   3,
+										   es);
+		}
+
+		list_free(all_chunks);
+	}
 }
 
 static CustomExecMethods constraint_aware_append_state_methods = {
@@ -378,6 +430,7 @@ constraint_aware_append_plan_create(PlannerInfo *root, RelOptInfo *rel, struct C
 	RangeTblEntry *rte = planner_rt_fetch(rel->relid, root);
 	List *chunk_ri_clauses = NIL;
 	List *children = NIL;
+	List *expand_details = NIL;
 	ListCell *lc_child;
 
 	cscan->scan.scanrelid = 0;			 /* Not a real relation we are scanning */
@@ -452,7 +505,20 @@ constraint_aware_append_plan_create(PlannerInfo *root, RelOptInfo *rel, struct C
 		}
 	}
 
-	cscan->custom_private = list_make2(list_make1_oid(rte->relid), chunk_ri_clauses);
+	/*
+	 * Keep the details of the hypertable expansion around for EXPLAIN
+	 */
+	if (rel->fdw_private != NULL)
+	{
+		TimescaleDBPrivate *priv = rel->fdw_private;
+
+		expand_details = list_make3_int(priv->chunks_expanded,
+										priv->expand_catalog_scans,
+										priv->expand_time_us);
+	}
+
+	cscan->custom_private =
+		list_make3(list_make1_oid(rte->relid), chunk_ri_clauses, expand_details);
 	cscan->custom_scan_tlist = subplan->targetlist; /* Target list of tuples
 													 * we expect as input */
 	cscan->flags = path->flags;
@@ -513,6 +579,13 @@ ts_constraint_aware_append_path_create(PlannerInfo *root, Hypertable *ht, Path *
 	return &path->cpath.path;
 }
 
+bool
+ts_is_constraint_aware_append_path(Path *path)
+{
+	return IsA(path, CustomPath) &&
+		   castNode(CustomPath, path)->methods == &constraint_aware_append_path_methods;
+}
+
 void
 _constraint_aware_append_init(void)
 {
@@ -25,6 +25,7 @@ typedef struct ConstraintAwareAppendState
 typedef struct Hypertable Hypertable;
 
 Path *ts_constraint_aware_append_path_create(PlannerInfo *root, Hypertable *ht, Path *subpath);
+bool ts_is_constraint_aware_append_path(Path *path);
 
 void _constraint_aware_append_init(void);
 
@@ -15,10 +15,15 @@
 
 TS_FUNCTION_INFO_V1(ts_add_drop_chunks_policy);
 TS_FUNCTION_INFO_V1(ts_add_reorder_policy);
+TS_FUNCTION_INFO_V1(ts_add_move_chunks_policy);
+TS_FUNCTION_INFO_V1(ts_add_deferred_indexes_policy);
 TS_FUNCTION_INFO_V1(ts_remove_drop_chunks_policy);
 TS_FUNCTION_INFO_V1(ts_remove_reorder_policy);
+TS_FUNCTION_INFO_V1(ts_remove_move_chunks_policy);
+TS_FUNCTION_INFO_V1(ts_remove_deferred_indexes_policy);
 TS_FUNCTION_INFO_V1(ts_alter_job_schedule);
 TS_FUNCTION_INFO_V1(ts_reorder_chunk);
+TS_FUNCTION_INFO_V1(ts_move_chunk);
 
 Datum
 ts_add_drop_chunks_policy(PG_FUNCTION_ARGS)
@@ -32,6 +37,18 @@ ts_add_reorder_policy(PG_FUNCTION_ARGS)
 	PG_RETURN_DATUM(ts_cm_functions->add_reorder_policy(fcinfo));
 }
 
+Datum
+ts_add_move_chunks_policy(PG_FUNCTION_ARGS)
+{
+	PG_RETURN_DATUM(ts_cm_functions->add_move_chunks_policy(fcinfo));
+}
+
+Datum
+ts_add_deferred_indexes_policy(PG_FUNCTION_ARGS)
+{
+	PG_RETURN_DATUM(ts_cm_functions->add_deferred_indexes_policy(fcinfo));
+}
+
 Datum
 ts_remove_drop_chunks_policy(PG_FUNCTION_ARGS)
 {
@@ -44,6 +61,18 @@ ts_remove_reorder_policy(PG_FUNCTION_ARGS)
 	PG_RETURN_DATUM(ts_cm_functions->remove_reorder_policy(fcinfo));
 }
 
+Datum
+ts_remove_move_chunks_policy(PG_FUNCTION_ARGS)
+{
+	PG_RETURN_DATUM(ts_cm_functions->remove_move_chunks_policy(fcinfo));
+}
+
+Datum
+ts_remove_deferred_indexes_policy(PG_FUNCTION_ARGS)
+{
+	PG_RETURN_DATUM(ts_cm_functions->remove_deferred_indexes_policy(fcinfo));
+}
+
 Datum
 ts_alter_job_schedule(PG_FUNCTION_ARGS)
 {
@@ -56,6 +85,12 @@ ts_reorder_chunk(PG_FUNCTION_ARGS)
 	PG_RETURN_DATUM(ts_cm_functions->reorder_chunk(fcinfo));
 }
 
+Datum
+ts_move_chunk(PG_FUNCTION_ARGS)
+{
+	PG_RETURN_DATUM(ts_cm_functions->move_chunk(fcinfo));
+}
+
 /*
  * casting a function pointer to a pointer of another type is undefined
  * behavior, so we need one of these for every function type we have
@@ -123,6 +158,13 @@ bgw_policy_job_execute_default_fn(BgwJob *job)
 	pg_unreachable();
 }
 
+static bool
+bgw_policy_job_execute_helper_default_fn(BgwJob *job, int32 item)
+{
+	error_no_default_fn_enterprise();
+	pg_unreachable();
+}
+
 static Datum
 error_no_default_fn_pg_community(PG_FUNCTION_ARGS)
 {
@@ -163,10 +205,15 @@ TSDLLEXPORT CrossModuleFunctions ts_cm_functions_default = {
 	.module_shutdown_hook = NULL,
 	.add_tsl_license_info_telemetry = add_telemetry_default,
 	.bgw_policy_job_execute = bgw_policy_job_execute_default_fn,
+	.bgw_policy_job_execute_helper = bgw_policy_job_execute_helper_default_fn,
 	.add_drop_chunks_policy = error_no_default_fn_pg_enterprise,
 	.add_reorder_policy = error_no_default_fn_pg_enterprise,
+	.add_move_chunks_policy = error_no_default_fn_pg_enterprise,
+	.add_deferred_indexes_policy = error_no_default_fn_pg_enterprise,
 	.remove_drop_chunks_policy = error_no_default_fn_pg_enterprise,
 	.remove_reorder_policy = error_no_default_fn_pg_enterprise,
+	.remove_move_chunks_policy = error_no_default_fn_pg_enterprise,
+	.remove_deferred_indexes_policy = error_no_default_fn_pg_enterprise,
 	.create_upper_paths_hook = NULL,
 	.gapfill_marker = error_no_default_fn_pg_community,
 	.gapfill_int16_time_bucket = error_no_default_fn_pg_community,
@@ -177,6 +224,7 @@ TSDLLEXPORT CrossModuleFunctions ts_cm_functions_default = {
 	.gapfill_timestamptz_time_bucket = error_no_default_fn_pg_community,
 	.alter_job_schedule = error_no_default_fn_pg_enterprise,
 	.reorder_chunk = error_no_default_fn_pg_community,
+	.move_chunk = error_no_default_fn_pg_community,
 };
 
 TSDLLEXPORT CrossModuleFunctions *ts_cm_functions = &ts_cm_functions_default;
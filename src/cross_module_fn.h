@@ -37,10 +37,15 @@ typedef struct CrossModuleFunctions
 	void (*module_shutdown_hook)(void);
 	void (*add_tsl_license_info_telemetry)(JsonbParseState *parseState);
 	bool (*bgw_policy_job_execute)(BgwJob *job);
+	bool (*bgw_policy_job_execute_helper)(BgwJob *job, int32 item);
 	Datum (*add_drop_chunks_policy)(PG_FUNCTION_ARGS);
 	Datum (*add_reorder_policy)(PG_FUNCTION_ARGS);
+	Datum (*add_move_chunks_policy)(PG_FUNCTION_ARGS);
+	Datum (*add_deferred_indexes_policy)(PG_FUNCTION_ARGS);
 	Datum (*remove_drop_chunks_policy)(PG_FUNCTION_ARGS);
 	Datum (*remove_reorder_policy)(PG_FUNCTION_ARGS);
+	Datum (*remove_move_chunks_policy)(PG_FUNCTION_ARGS);
+	Datum (*remove_deferred_indexes_policy)(PG_FUNCTION_ARGS);
 	void (*create_upper_paths_hook)(PlannerInfo *, UpperRelationKind, RelOptInfo *, RelOptInfo *);
 	PGFunction gapfill_marker;
 	PGFunction gapfill_int16_time_bucket;
@@ -51,6 +56,7 @@ typedef struct CrossModuleFunctions
 	PGFunction gapfill_timestamptz_time_bucket;
 	PGFunction alter_job_schedule;
 	PGFunction reorder_chunk;
+	PGFunction move_chunk;
 } CrossModuleFunctions;
 
 extern TSDLLEXPORT CrossModuleFunctions *ts_cm_functions;
@@ -24,6 +24,7 @@
 #include "dimension_vector.h"
 #include "hypertable.h"
 #include "scanner.h"
+#include "utils.h"
 
 /* Put DIMENSION_SLICE_MAXVALUE point in same slice as DIMENSION_SLICE_MAXVALUE-1, always */
 /* This avoids the problem with coord < range_end where coord and range_end is an int64 */
@@ -733,10 +734,58 @@ ts_dimension_slice_nth_latest_slice(int32 dimension_id, int n)
 	return ret;
 }
 
+/*
+ * Get the slice at the write frontier of an open dimension, i.e., the newest
+ * slice that starts at or before the current time. Newer slices are ahead of
+ * the frontier, so a few rows far in the future, e.g., from a bad clock, do not
+ * move the frontier away from the slices that receive the inserts. Dimensions
+ * that are not of a time type have no current time and use the newest slice.
+ */
+DimensionSlice *
+ts_dimension_slice_write_frontier(Dimension *dim)
+{
+	ScanKeyData scankey[2];
+	Interval zero = { 0 };
+	DimensionSlice *ret = NULL;
+
+	if (NULL != dim->partitioning || !IS_TIMESTAMP_TYPE(dim->fd.column_type))
+		return ts_dimension_slice_nth_latest_slice(dim->fd.id, 1);
+
+	ScanKeyInit(&scankey[0],
+				Anum_dimension_slice_dimension_id_range_start_range_end_idx_dimension_id,
+				BTEqualStrategyNumber,
+				F_INT4EQ,
+				Int32GetDatum(dim->fd.id));
+	ScanKeyInit(&scankey[1],
+				Anum_dimension_slice_dimension_id_range_start_range_end_idx_range_start,
+				BTLessEqualStrategyNumber,
+				F_INT8LE,
+				Int64GetDatum(ts_interval_from_now_to_internal(IntervalPGetDatum(&zero),
+															   dim->fd.column_type)));
+
+	dimension_slice_scan_limit_direction_internal(
+		DIMENSION_SLICE_DIMENSION_ID_RANGE_START_RANGE_END_IDX,
+		scankey,
+		2,
+		dimension_slice_nth_tuple_found,
+		&ret,
+		1,
+		BackwardScanDirection,
+		AccessShareLock,
+		CurrentMemoryContext);
+
+	/* All slices start in the future */
+	if (NULL == ret)
+		return ts_dimension_slice_nth_latest_slice(dim->fd.id, 1);
+
+	return ret;
+}
+
 typedef struct ChunkStatInfo
 {
-	int32 chunk_id;
+	List *chunk_ids;
 	int32 job_id;
+	int limit;
 } ChunkStatInfo;
 
 static ScanTupleResult
@@ -751,30 +800,46 @@ dimension_slice_check_chunk_stats_tuple_found(TupleInfo *ti, void *data)
 
 	foreach (lc, chunk_ids)
 	{
-		BgwPolicyChunkStats *chunk_stat =
-			ts_bgw_policy_chunk_stats_find(info->job_id, lfirst_int(lc));
+		int32 chunk_id = lfirst_int(lc);
+		BgwPolicyChunkStats *chunk_stat = ts_bgw_policy_chunk_stats_find(info->job_id, chunk_id);
 
-		if (chunk_stat == NULL || chunk_stat->fd.num_times_job_run == 0)
+		/* Chunks in several slices of this dimension are only reported once */
+		if ((chunk_stat == NULL || chunk_stat->fd.num_times_job_run == 0) &&
+			!list_member_int(info->chunk_ids, chunk_id))
 		{
 			/* Save the chunk_id */
-			info->chunk_id = lfirst_int(lc);
-			return SCAN_DONE;
+			info->chunk_ids = lappend_int(info->chunk_ids, chunk_id);
+
+			if (list_length(info->chunk_ids) >= info->limit)
+				return SCAN_DONE;
 		}
 	}
 
 	return SCAN_CONTINUE;
 }
 
-int
-ts_dimension_slice_oldest_chunk_without_executed_job(int32 job_id, int32 dimension_id,
-													 StrategyNumber start_strategy,
-													 int64 start_value, StrategyNumber end_strategy,
-													 int64 end_value)
+/*
+ * Return the IDs of (at most) the `limit` oldest chunks that the given job
+ * has not yet been run on, in slice order.
+ */
+List *
+ts_dimension_slice_oldest_chunks_without_executed_job(int32 job_id, int32 dimension_id,
+													  StrategyNumber start_strategy,
+													  int64 start_value,
+													  StrategyNumber end_strategy,
+													  int64 end_value, int limit)
 {
 	ChunkStatInfo info = {
 		.job_id = job_id,
-		.chunk_id = -1,
+		.chunk_ids = NIL,
+		.limit = limit,
 	};
+	ScanSession *session;
+
+	Assert(limit > 0);
+
+	/* Every slice found scans chunk constraints and chunk stats */
+	session = ts_scan_session_begin();
 
 	dimension_slice_scan_with_strategies(dimension_id,
 										 start_strategy,
@@ -785,5 +850,27 @@ ts_dimension_slice_oldest_chunk_without_executed_job(int32 job_id, int32 dimensi
 										 dimension_slice_check_chunk_stats_tuple_found,
 										 -1);
 
-	return info.chunk_id;
+	ts_scan_session_end(session);
+
+	return info.chunk_ids;
+}
+
+int
+ts_dimension_slice_oldest_chunk_without_executed_job(int32 job_id, int32 dimension_id,
+													 StrategyNumber start_strategy,
+													 int64 start_value, StrategyNumber end_strategy,
+													 int64 end_value)
+{
+	List *chunk_ids = ts_dimension_slice_oldest_chunks_without_executed_job(job_id,
+																			 dimension_id,
+																			 start_strategy,
+																			 start_value,
+																			 end_strategy,
+																			 end_value,
+																			 1);
+
+	if (chunk_ids == NIL)
+		return -1;
+
+	return linitial_int(chunk_ids);
 }
@@ -28,6 +28,7 @@ typedef struct DimensionSlice
 
 typedef struct DimensionVec DimensionVec;
 typedef struct Hypercube Hypercube;
+typedef struct Dimension Dimension;
 
 extern DimensionVec *ts_dimension_slice_scan_limit(int32 dimension_id, int64 coordinate, int limit);
 extern DimensionVec *ts_dimension_slice_scan_range_limit(int32 dimension_id,
@@ -58,9 +59,13 @@ extern int ts_dimension_slice_cmp(const DimensionSlice *left, const DimensionSli
 extern int ts_dimension_slice_cmp_coordinate(const DimensionSlice *slice, int64 coord);
 
 extern TSDLLEXPORT DimensionSlice *ts_dimension_slice_nth_latest_slice(int32 dimension_id, int n);
+extern TSDLLEXPORT DimensionSlice *ts_dimension_slice_write_frontier(Dimension *dim);
 extern TSDLLEXPORT int ts_dimension_slice_oldest_chunk_without_executed_job(
 	int32 job_id, int32 dimension_id, StrategyNumber start_strategy, int64 start_value,
 	StrategyNumber end_strategy, int64 end_value);
+extern TSDLLEXPORT List *ts_dimension_slice_oldest_chunks_without_executed_job(
+	int32 job_id, int32 dimension_id, StrategyNumber start_strategy, int64 start_value,
+	StrategyNumber end_strategy, int64 end_value, int limit);
 
 #define dimension_slice_insert(slice) ts_dimension_slice_insert_multi(&(slice), 1)
 
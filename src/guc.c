@@ -33,14 +33,32 @@ static const struct config_enum_entry telemetry_level_options[] = {
 	{ "off", TELEMETRY_OFF, false }, { "basic", TELEMETRY_BASIC, false }, { NULL, 0, false }
 };
 
+static const struct config_enum_entry tablespace_placement_options[] = {
+	{ "sticky", TABLESPACE_PLACEMENT_STICKY, false },
+	{ "balanced", TABLESPACE_PLACEMENT_BALANCED, false },
+	{ NULL, 0, false }
+};
+
 bool ts_guc_disable_optimizations = false;
 bool ts_guc_optimize_non_hypertables = false;
 bool ts_guc_restoring = false;
 bool ts_guc_constraint_aware_append = true;
 bool ts_guc_enable_ordered_append = true;
+bool ts_guc_enable_skip_scan = true;
+bool ts_guc_enable_chunk_aggregation = false;
 bool ts_guc_enable_constraint_exclusion = true;
+bool ts_guc_enable_chunk_time_range_exclusion = false;
+bool ts_guc_enable_chunk_summary_exclusion = false;
+bool ts_guc_track_plan_exclusion = false;
 int ts_guc_max_open_chunks_per_insert = 10;
 int ts_guc_max_cached_chunks_per_hypertable = 10;
+int ts_guc_tablespace_placement = TABLESPACE_PLACEMENT_STICKY;
+int ts_guc_bgw_job_runners = 0;
+int ts_guc_bgw_reorder_max_concurrency = 0;
+int ts_guc_bgw_reorder_weight = 1;
+int ts_guc_bgw_drop_chunks_max_concurrency = 0;
+int ts_guc_bgw_drop_chunks_weight = 1;
+TSDLLEXPORT int ts_guc_reorder_cost_delay = 0;
 int ts_guc_telemetry_level = TELEMETRY_BASIC;
 
 TSDLLEXPORT char *ts_guc_license_key = TS_DEFAULT_LICENSE;
@@ -118,6 +136,30 @@ _guc_init(void)
 							 NULL,
 							 NULL);
 
+	DefineCustomBoolVariable("timescaledb.enable_skip_scan",
+							 "Enable skip scans",
+							 "Enable SkipScan for DISTINCT queries on a single column that is the "
+							 "leading column of a btree index",
+							 &ts_guc_enable_skip_scan,
+							 true,
+							 PGC_USERSET,
+							 0,
+							 NULL,
+							 NULL,
+							 NULL);
+
+	DefineCustomBoolVariable("timescaledb.enable_chunkwise_aggregation",
+							 "Enable chunk-wise aggregation",
+							 "Enable aggregating each chunk separately below the append of "
+							 "the chunks of a hypertable",
+							 &ts_guc_enable_chunk_aggregation,
+							 false,
+							 PGC_USERSET,
+							 0,
+							 NULL,
+							 NULL,
+							 NULL);
+
 	DefineCustomBoolVariable("timescaledb.enable_constraint_exclusion",
 							 "Enable constraint exclusion",
 							 "Enable planner constraint exclusion",
@@ -129,6 +171,43 @@ _guc_init(void)
 							 NULL,
 							 NULL);
 
+	DefineCustomBoolVariable("timescaledb.enable_chunk_time_range_exclusion",
+							 "Enable chunk exclusion on cached time ranges",
+							 "Exclude chunks whose cached time range does not match the query, "
+							 "even if the chunk's time slice does",
+							 &ts_guc_enable_chunk_time_range_exclusion,
+							 false,
+							 PGC_USERSET,
+							 0,
+							 NULL,
+							 NULL,
+							 NULL);
+
+	DefineCustomBoolVariable("timescaledb.enable_chunk_summary_exclusion",
+							 "Enable chunk exclusion on summary indexes",
+							 "Exclude chunks at execution time if the chunk's single-column BRIN "
+							 "minmax indexes prove that no row matches the query",
+							 &ts_guc_enable_chunk_summary_exclusion,
+							 false,
+							 PGC_USERSET,
+							 0,
+							 NULL,
+							 NULL,
+							 NULL);
+
+	DefineCustomBoolVariable("timescaledb.track_plan_exclusion",
+							 "Count chunks excluded at plan time",
+							 "Count the chunks of a hypertable that planning excluded in "
+							 "timescaledb_information.stats. This requires counting all chunks "
+							 "of the hypertable on every plan",
+							 &ts_guc_track_plan_exclusion,
+							 false,
+							 PGC_USERSET,
+							 0,
+							 NULL,
+							 NULL,
+							 NULL);
+
 	DefineCustomIntVariable("timescaledb.max_open_chunks_per_insert",
 							"Maximum open chunks per insert",
 							"Maximum number of open chunk tables per insert",
@@ -160,6 +239,106 @@ _guc_init(void)
 							NULL,
 							assign_max_cached_chunks_per_hypertable_hook,
 							NULL);
+
+	DefineCustomEnumVariable("timescaledb.tablespace_placement",
+							 "Tablespace placement of new chunks",
+							 "With \"sticky\", chunks in the same space partition always go to the "
+							 "same attached tablespace. With \"balanced\", a new chunk goes to the "
+							 "attached tablespace holding the fewest chunks in its time slice",
+							 &ts_guc_tablespace_placement,
+							 TABLESPACE_PLACEMENT_STICKY,
+							 tablespace_placement_options,
+							 PGC_USERSET,
+							 0,
+							 NULL,
+							 NULL,
+							 NULL);
+
+	DefineCustomIntVariable("timescaledb.bgw_job_runners",
+							"Number of persistent job runners per database",
+							"Number of background workers the job scheduler keeps alive to run "
+							"jobs in, instead of starting a new background worker for every job "
+							"run. Idle runners hold a background worker slot.",
+							&ts_guc_bgw_job_runners,
+							0,
+							0,
+							1000,
+							PGC_SIGHUP,
+							0,
+							NULL,
+							NULL,
+							NULL);
+
+	DefineCustomIntVariable("timescaledb.bgw_reorder_max_concurrency",
+							"Maximum number of concurrent reorder jobs",
+							"Maximum number of reorder policy jobs the job scheduler runs at the "
+							"same time in a database, 0 for no limit",
+							&ts_guc_bgw_reorder_max_concurrency,
+							0,
+							0,
+							1000,
+							PGC_SIGHUP,
+							0,
+							NULL,
+							NULL,
+							NULL);
+
+	DefineCustomIntVariable("timescaledb.bgw_reorder_weight",
+							"Scheduling weight of reorder jobs",
+							"Relative share of background workers the job scheduler gives to "
+							"reorder policy jobs when jobs of several types are due",
+							&ts_guc_bgw_reorder_weight,
+							1,
+							1,
+							1000,
+							PGC_SIGHUP,
+							0,
+							NULL,
+							NULL,
+							NULL);
+
+	DefineCustomIntVariable("timescaledb.bgw_drop_chunks_max_concurrency",
+							"Maximum number of concurrent drop_chunks jobs",
+							"Maximum number of drop_chunks policy jobs the job scheduler runs at "
+							"the same time in a database, 0 for no limit",
+							&ts_guc_bgw_drop_chunks_max_concurrency,
+							0,
+							0,
+							1000,
+							PGC_SIGHUP,
+							0,
+							NULL,
+							NULL,
+							NULL);
+
+	DefineCustomIntVariable("timescaledb.bgw_drop_chunks_weight",
+							"Scheduling weight of drop_chunks jobs",
+							"Relative share of background workers the job scheduler gives to "
+							"drop_chunks policy jobs when jobs of several types are due",
+							&ts_guc_bgw_drop_chunks_weight,
+							1,
+							1,
+							1000,
+							PGC_SIGHUP,
+							0,
+							NULL,
+							NULL,
+							NULL);
+
+	DefineCustomIntVariable("timescaledb.reorder_cost_delay",
+							"Cost-based delay of reorder",
+							"Like vacuum_cost_delay, the time reorder sleeps whenever copying a "
+							"chunk has used up vacuum_cost_limit, 0 to disable the delay",
+							&ts_guc_reorder_cost_delay,
+							0,
+							0,
+							100,
+							PGC_USERSET,
+							GUC_UNIT_MS,
+							NULL,
+							NULL,
+							NULL);
+
 	DefineCustomEnumVariable("timescaledb.telemetry_level",
 							 "Telemetry settings level",
 							 "Level used to determine which telemetry to send",
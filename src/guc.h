@@ -11,14 +11,32 @@
 
 extern bool ts_telemetry_on(void);
 
+typedef enum TablespacePlacement
+{
+	TABLESPACE_PLACEMENT_STICKY,
+	TABLESPACE_PLACEMENT_BALANCED,
+} TablespacePlacement;
+
 extern bool ts_guc_disable_optimizations;
 extern bool ts_guc_optimize_non_hypertables;
 extern bool ts_guc_constraint_aware_append;
 extern bool ts_guc_enable_ordered_append;
+extern bool ts_guc_enable_skip_scan;
+extern bool ts_guc_enable_chunk_aggregation;
 extern bool ts_guc_enable_constraint_exclusion;
+extern bool ts_guc_enable_chunk_time_range_exclusion;
+extern bool ts_guc_enable_chunk_summary_exclusion;
+extern bool ts_guc_track_plan_exclusion;
 extern bool ts_guc_restoring;
 extern int ts_guc_max_open_chunks_per_insert;
 extern int ts_guc_max_cached_chunks_per_hypertable;
+extern int ts_guc_tablespace_placement;
+extern int ts_guc_bgw_job_runners;
+extern int ts_guc_bgw_reorder_max_concurrency;
+extern int ts_guc_bgw_reorder_weight;
+extern int ts_guc_bgw_drop_chunks_max_concurrency;
+extern int ts_guc_bgw_drop_chunks_weight;
+extern TSDLLEXPORT int ts_guc_reorder_cost_delay;
 extern int ts_guc_telemetry_level;
 extern TSDLLEXPORT char *ts_guc_license_key;
 extern char *ts_last_tune_time;
@@ -39,6 +39,8 @@
 #include "dimension.h"
 #include "chunk.h"
 #include "chunk_adaptive.h"
+#include "chunk_constraint.h"
+#include "chunk_index.h"
 
 #include "subspace_store.h"
 #include "hypertable_cache.h"
@@ -406,6 +408,7 @@ hypertable_tuple_delete(TupleInfo *ti, void *data)
 	ts_tablespace_delete(hypertable_id, NULL);
 	ts_chunk_delete_by_hypertable_id(hypertable_id);
 	ts_dimension_delete_by_hypertable_id(hypertable_id, true);
+	ts_chunk_index_delete_deferred_by_hypertable_id(hypertable_id);
 
 	/* Also remove any policy argument / job that uses this hypertable */
 	ts_bgw_policy_delete_by_hypertable_id(hypertable_id);
@@ -772,6 +775,84 @@ ts_hypertable_has_tablespace(Hypertable *ht, Oid tspc_oid)
 	return ts_tablespaces_contain(tspcs, tspc_oid);
 }
 
+/*
+ * Select the attached tablespace that holds the fewest chunks in the given
+ * chunk's time slice.
+ *
+ * The chunks sharing a time slice with the new chunk are the ones currently
+ * taking inserts, so spreading them evenly spreads ingest I/O across the
+ * attached tablespaces. Ties are broken in favor of the "sticky" tablespace,
+ * so with no other chunks in the slice this picks the same tablespace as the
+ * default placement.
+ */
+static int
+hypertable_select_tablespace_balanced(Hypertable *ht, Chunk *chunk, Tablespaces *tspcs,
+									  int sticky_index)
+{
+	Dimension *time_dim = hyperspace_get_open_dimension(ht->space, 0);
+	DimensionSlice *slice;
+	List *chunk_ids = NIL;
+	ListCell *lc;
+	int *counts;
+	int best = sticky_index;
+	int i;
+
+	if (NULL == time_dim)
+		return sticky_index;
+
+	slice = ts_hypercube_get_slice_by_dimension_id(chunk->cube, time_dim->fd.id);
+
+	Assert(NULL != slice);
+
+	ts_chunk_constraint_scan_by_dimension_slice_to_list(slice, &chunk_ids, CurrentMemoryContext);
+
+	counts = palloc0(sizeof(int) * tspcs->num_tablespaces);
+
+	foreach (lc, chunk_ids)
+	{
+		int32 chunk_id = lfirst_int(lc);
+		Chunk *other;
+		Oid tspc_oid;
+
+		/* The new chunk's metadata exists, but its table does not yet */
+		if (chunk_id == chunk->fd.id)
+			continue;
+
+		other = ts_chunk_get_by_id(chunk_id, 0, false);
+
+		if (NULL == other || !OidIsValid(other->table_id))
+			continue;
+
+		tspc_oid = get_rel_tablespace(other->table_id);
+
+		if (!OidIsValid(tspc_oid))
+			tspc_oid = MyDatabaseTableSpace;
+
+		for (i = 0; i < tspcs->num_tablespaces; i++)
+		{
+			if (tspcs->tablespaces[i].tablespace_oid == tspc_oid)
+			{
+				counts[i]++;
+				break;
+			}
+		}
+	}
+
+	/* Start at the sticky tablespace so that it wins ties */
+	for (i = 1; i < tspcs->num_tablespaces; i++)
+	{
+		int idx = (sticky_index + i) % tspcs->num_tablespaces;
+
+		if (counts[idx] < counts[best])
+			best = idx;
+	}
+
+	pfree(counts);
+	list_free(chunk_ids);
+
+	return best;
+}
+
 /*
  * Select a tablespace to use for a given chunk.
  *
@@ -781,6 +862,10 @@ ts_hypertable_has_tablespace(Hypertable *ht, Oid tspc_oid)
  * We try to do "sticky" selection to consistently pick the same tablespace for
  * chunks in the same closed (space) dimension. This ensures chunks in the same
  * "space" partition will live on the same disk.
+ *
+ * With timescaledb.tablespace_placement set to "balanced", the sticky choice
+ * is only a tie breaker and chunks are instead spread evenly over the
+ * tablespaces within each time slice.
  */
 Tablespace *
 ts_hypertable_select_tablespace(Hypertable *ht, Chunk *chunk)
@@ -818,7 +903,12 @@ ts_hypertable_select_tablespace(Hypertable *ht, Chunk *chunk)
 	Assert(i >= 0);
 
 	/* Use the index of the slice to find the tablespace */
-	return &tspcs->tablespaces[i % tspcs->num_tablespaces];
+	i = i % tspcs->num_tablespaces;
+
+	if (ts_guc_tablespace_placement == TABLESPACE_PLACEMENT_BALANCED && tspcs->num_tablespaces > 1)
+		i = hypertable_select_tablespace_balanced(ht, chunk, tspcs, i);
+
+	return &tspcs->tablespaces[i];
 }
 
 char *
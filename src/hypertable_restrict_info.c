@@ -16,7 +16,9 @@
 #include "utils.h"
 #include "dimension_slice.h"
 #include "chunk.h"
+#include "chunk_statistics.h"
 #include "dimension_vector.h"
+#include "guc.h"
 #include "partitioning.h"
 
 typedef struct DimensionRestrictInfo
@@ -508,12 +510,94 @@ ts_hypertable_restrict_info_has_restrictions(HypertableRestrictInfo *hri)
 	return hri->num_base_restrictions > 0;
 }
 
+/*
+ * Get the restriction on the time dimension if it can be checked against the
+ * cached time ranges of chunks, or NULL otherwise.
+ */
+static DimensionRestrictInfoOpen *
+hypertable_restrict_info_get_time_restriction(HypertableRestrictInfo *hri)
+{
+	int i;
+
+	if (!ts_guc_enable_chunk_time_range_exclusion)
+		return NULL;
+
+	for (i = 0; i < hri->num_dimensions; i++)
+	{
+		DimensionRestrictInfo *dri = hri->dimension_restriction[i];
+		DimensionRestrictInfoOpen *dri_open = (DimensionRestrictInfoOpen *) dri;
+
+		if (dri->dimension->type != DIMENSION_TYPE_OPEN)
+			continue;
+
+		/* Cached time ranges are only kept for untransformed time values */
+		if (NULL != dri->dimension->partitioning ||
+			(dri_open->lower_strategy == InvalidStrategy &&
+			 dri_open->upper_strategy == InvalidStrategy))
+			return NULL;
+
+		return dri_open;
+	}
+
+	return NULL;
+}
+
+/*
+ * Check if the cached time range of a chunk overlaps with the restriction on
+ * the time dimension. Chunks without a known time range always overlap.
+ */
+static bool
+chunk_time_range_matches(int32 chunk_id, DimensionRestrictInfoOpen *dri)
+{
+	ChunkStatistics stats;
+
+	if (!ts_chunk_statistics_get(chunk_id, &stats) || !stats.has_time_range)
+		return true;
+
+	switch (dri->lower_strategy)
+	{
+		case BTGreaterStrategyNumber:
+			if (stats.fd.max_time <= dri->lower_bound)
+				return false;
+			break;
+		case BTGreaterEqualStrategyNumber:
+			if (stats.fd.max_time < dri->lower_bound)
+				return false;
+			break;
+		default:
+			break;
+	}
+
+	switch (dri->upper_strategy)
+	{
+		case BTLessStrategyNumber:
+			if (stats.fd.min_time >= dri->upper_bound)
+				return false;
+			break;
+		case BTLessEqualStrategyNumber:
+			if (stats.fd.min_time > dri->upper_bound)
+				return false;
+			break;
+		default:
+			break;
+	}
+
+	return true;
+}
+
+static bool
+chunk_time_range_filter(Chunk *chunk, void *arg)
+{
+	return chunk_time_range_matches(chunk->fd.id, arg);
+}
+
 List *
 ts_hypertable_restrict_info_get_chunk_oids(HypertableRestrictInfo *hri, Hypertable *ht,
 										   LOCKMODE lockmode)
 {
 	int i;
 	List *dimension_vecs = NIL;
+	DimensionRestrictInfoOpen *time_restriction;
 
 	for (i = 0; i < hri->num_dimensions; i++)
 	{
@@ -538,7 +622,13 @@ ts_hypertable_restrict_info_get_chunk_oids(HypertableRestrictInfo *hri, Hypertab
 
 	Assert(list_length(dimension_vecs) == ht->space->num_dimensions);
 
-	return ts_chunk_find_all_oids(ht->space, dimension_vecs, lockmode);
+	time_restriction = hypertable_restrict_info_get_time_restriction(hri);
+
+	return ts_chunk_find_all_oids(ht->space,
+								  dimension_vecs,
+								  NULL == time_restriction ? NULL : chunk_time_range_filter,
+								  time_restriction,
+								  lockmode);
 }
 
 List *
@@ -553,6 +643,7 @@ ts_hypertable_restrict_info_get_chunk_oids_ordered(HypertableRestrictInfo *hri,
 	 * adjusted
 	 */
 	DimensionRestrictInfo *dri;
+	DimensionRestrictInfoOpen *time_restriction;
 	DimensionVec *dv;
 	List *chunk_oids = NIL;
 	int i;
@@ -583,6 +674,8 @@ ts_hypertable_restrict_info_get_chunk_oids_ordered(HypertableRestrictInfo *hri,
 	else
 		ts_dimension_vec_sort(&dv);
 
+	time_restriction = hypertable_restrict_info_get_time_restriction(hri);
+
 	for (i = 0; i < dv->num_slices; i++)
 	{
 		ListCell *lc;
@@ -601,7 +694,13 @@ ts_hypertable_restrict_info_get_chunk_oids_ordered(HypertableRestrictInfo *hri,
 
 		foreach (lc, chunk_ids)
 		{
-			Chunk *chunk = ts_chunk_get_by_id(lfirst_int(lc), 0, true);
+			Chunk *chunk;
+
+			if (NULL != time_restriction &&
+				!chunk_time_range_matches(lfirst_int(lc), time_restriction))
+				continue;
+
+			chunk = ts_chunk_get_by_id(lfirst_int(lc), 0, true);
 
 			chunk_oids = lappend_oid(chunk_oids, chunk->table_id);
 		}
@@ -20,6 +20,7 @@
 #include "config.h"
 #include "license_guc.h"
 #include "constraint_aware_append.h"
+#include "skip_scan.h"
 
 #ifdef PG_MODULE_MAGIC
 PG_MODULE_MAGIC;
@@ -34,9 +35,15 @@ extern void _cache_invalidate_fini(void);
 extern void _cache_init(void);
 extern void _cache_fini(void);
 
+extern void _scanner_init(void);
+extern void _scanner_fini(void);
+
 extern void _planner_init(void);
 extern void _planner_fini(void);
 
+extern void _chunk_statistics_init(void);
+extern void _chunk_statistics_fini(void);
+
 extern void _process_utility_init(void);
 extern void _process_utility_fini(void);
 
@@ -73,10 +80,13 @@ _PG_init(void)
 	ts_bgw_check_loader_api_version();
 
 	_cache_init();
+	_scanner_init();
 	_hypertable_cache_init();
 	_cache_invalidate_init();
 	_planner_init();
+	_chunk_statistics_init();
 	_constraint_aware_append_init();
+	_skip_scan_init();
 	_event_trigger_init();
 	_process_utility_init();
 	_guc_init();
@@ -106,9 +116,11 @@ _PG_fini(void)
 	_guc_fini();
 	_process_utility_fini();
 	_event_trigger_fini();
+	_chunk_statistics_fini();
 	_planner_fini();
 	_cache_invalidate_fini();
 	_hypertable_cache_fini();
+	_scanner_fini();
 	_cache_fini();
 }
 
@@ -506,6 +506,23 @@ custom_group_estimate(PlannerInfo *root, double path_rows)
 	return clamp_row_est(d_num_groups);
 }
 
+/* Estimate the number of groups of the query, using the custom estimate when
+ * available and the default estimate otherwise */
+double
+ts_plan_estimate_num_groups(PlannerInfo *root, double path_rows)
+{
+	Query *parse = root->parse;
+	double d_num_groups = custom_group_estimate(root, path_rows);
+
+	if (IS_VALID_ESTIMATE(d_num_groups))
+		return d_num_groups;
+
+	return estimate_num_groups(root,
+							   get_sortgrouplist_exprs(parse->groupClause, parse->targetList),
+							   path_rows,
+							   NULL);
+}
+
 /* Add a parallel HashAggregate plan.
  * This code is similar to parts of create_grouping_paths */
 static void
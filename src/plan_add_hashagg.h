@@ -21,4 +21,5 @@
  * */
 
 extern void ts_plan_add_hashagg(PlannerInfo *root, RelOptInfo *input_rel, RelOptInfo *output_rel);
+extern double ts_plan_estimate_num_groups(PlannerInfo *root, double path_rows);
 #endif /* TIMESCALEDB_PLAN_ADD_HASHAGG_H */
@@ -0,0 +1,529 @@
+/*
+ * This file and its contents are licensed under the Apache License 2.0.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-APACHE for a copy of the license.
+ */
+#include <postgres.h>
+#include <catalog/pg_type.h>
+#include <nodes/makefuncs.h>
+#include <nodes/nodeFuncs.h>
+#include <optimizer/clauses.h>
+#include <optimizer/pathnode.h>
+#include <optimizer/paths.h>
+#include <optimizer/prep.h>
+#include <optimizer/tlist.h>
+#include <parser/parsetree.h>
+#include <utils/datetime.h>
+#include <utils/lsyscache.h>
+#include <utils/timestamp.h>
+#include <miscadmin.h>
+
+#include "compat-msvc-enter.h"
+#include <optimizer/cost.h>
+#include "compat-msvc-exit.h"
+
+#include "compat.h"
+#include "chunk.h"
+#include "dimension.h"
+#include "dimension_slice.h"
+#include "extension.h"
+#include "guc.h"
+#include "hypercube.h"
+#include "hypertable.h"
+#include "hypertable_cache.h"
+#include "planner_import.h"
+#include "plan_add_hashagg.h"
+#include "plan_chunk_agg.h"
+
+/* Default origin of time_bucket for timestamps, see time_bucket.c */
+#define TIME_BUCKET_DEFAULT_ORIGIN (2 * USECS_PER_DAY)
+
+/* Difference between the PostgreSQL epoch and our internal (UNIX) epoch */
+#define TS_EPOCH_DIFF_MICROSECONDS                                                                 \
+	((int64)(POSTGRES_EPOCH_JDATE - UNIX_EPOCH_JDATE) * USECS_PER_DAY)
+
+static AppendRelInfo *
+get_appendrelinfo(PlannerInfo *root, Index rti)
+{
+#if PG96 || PG10
+	ListCell *lc;
+	foreach (lc, root->append_rel_list)
+	{
+		AppendRelInfo *appinfo = lfirst(lc);
+		if (appinfo->child_relid == rti)
+			return appinfo;
+	}
+#else
+	if (root->append_rel_array[rti])
+		return root->append_rel_array[rti];
+#endif
+	ereport(ERROR,
+			(errcode(ERRCODE_INTERNAL_ERROR), errmsg("no appendrelinfo found for index %d", rti)));
+	pg_unreachable();
+}
+
+static PathTarget *
+translate_target_to_chunk(PlannerInfo *root, PathTarget *target, AppendRelInfo *appinfo)
+{
+	PathTarget *chunk_target = copy_pathtarget(target);
+
+	chunk_target->exprs =
+		(List *) adjust_appendrel_attrs_compat(root, (Node *) chunk_target->exprs, appinfo);
+
+	return chunk_target;
+}
+
+/*
+ * A bucketing expression whose buckets never cross a chunk boundary.
+ */
+typedef struct ChunkAlignedBucket
+{
+	Oid type;
+	int64 period;
+	int64 origin;
+} ChunkAlignedBucket;
+
+/*
+ * Check if the expression is a time_bucket() call with constant arguments on
+ * the time column of the hypertable. If so, fill in the bucket width and
+ * origin in the same units as the internal representation of time.
+ */
+static bool
+time_bucket_on_time_dimension(PlannerInfo *root, Index relid, Dimension *dim, Node *expr,
+							  ChunkAlignedBucket *bucket)
+{
+	FuncExpr *func;
+	Node *width;
+	Node *origin = NULL;
+	Var *var;
+	char *funcname;
+
+	if (!IsA(expr, FuncExpr))
+		return false;
+
+	func = castNode(FuncExpr, expr);
+
+	if (list_length(func->args) < 2 || list_length(func->args) > 3 ||
+		get_func_namespace(func->funcid) != ts_extension_schema_oid())
+		return false;
+
+	funcname = get_func_name(func->funcid);
+	if (funcname == NULL || strcmp(funcname, "time_bucket") != 0)
+		return false;
+
+	var = lsecond(func->args);
+	if (!IsA(var, Var) || var->varno != relid || var->varattno != dim->column_attno ||
+		var->vartype != dim->fd.column_type)
+		return false;
+
+	width = eval_const_expressions(root, linitial(func->args));
+	if (!IsA(width, Const) || castNode(Const, width)->constisnull)
+		return false;
+
+	if (list_length(func->args) == 3)
+	{
+		origin = eval_const_expressions(root, lthird(func->args));
+		if (!IsA(origin, Const) || castNode(Const, origin)->constisnull)
+			return false;
+	}
+
+	bucket->type = var->vartype;
+
+	switch (var->vartype)
+	{
+		case INT2OID:
+			bucket->period = DatumGetInt16(castNode(Const, width)->constvalue);
+			bucket->origin = origin ? DatumGetInt16(castNode(Const, origin)->constvalue) : 0;
+			break;
+		case INT4OID:
+			bucket->period = DatumGetInt32(castNode(Const, width)->constvalue);
+			bucket->origin = origin ? DatumGetInt32(castNode(Const, origin)->constvalue) : 0;
+			break;
+		case INT8OID:
+			bucket->period = DatumGetInt64(castNode(Const, width)->constvalue);
+			bucket->origin = origin ? DatumGetInt64(castNode(Const, origin)->constvalue) : 0;
+			break;
+		case TIMESTAMPOID:
+		case TIMESTAMPTZOID:
+		{
+			Interval *interval = DatumGetIntervalP(castNode(Const, width)->constvalue);
+
+			if (interval->month != 0)
+				return false;
+
+			bucket->period = interval->time + interval->day * USECS_PER_DAY;
+			bucket->origin = origin ? DatumGetTimestamp(castNode(Const, origin)->constvalue) :
+									  TIME_BUCKET_DEFAULT_ORIGIN;
+			/* bucket boundaries in internal time are shifted by the epoch */
+			bucket->origin += TS_EPOCH_DIFF_MICROSECONDS;
+			break;
+		}
+		default:
+			return false;
+	}
+
+	return bucket->period > 0;
+}
+
+static bool
+bucket_boundary_aligned(ChunkAlignedBucket *bucket, int64 boundary)
+{
+	int64 remainder;
+
+	/* open-ended slices cannot be crossed by a bucket */
+	if (boundary == DIMENSION_SLICE_MINVALUE || boundary == DIMENSION_SLICE_MAXVALUE)
+		return true;
+
+	/* avoid overflow when shifting by the origin */
+	if ((bucket->origin > 0 && boundary < PG_INT64_MIN + bucket->origin) ||
+		(bucket->origin < 0 && boundary > PG_INT64_MAX + bucket->origin))
+		return false;
+
+	remainder = (boundary - bucket->origin) % bucket->period;
+
+	return remainder == 0;
+}
+
+static bool
+group_exprs_contain_column(List *group_exprs, Index relid, AttrNumber attno)
+{
+	ListCell *lc;
+
+	foreach (lc, group_exprs)
+	{
+		Var *var = lfirst(lc);
+
+		if (IsA(var, Var) && var->varno == relid && var->varattno == attno &&
+			var->varlevelsup == 0)
+			return true;
+	}
+
+	return false;
+}
+
+/*
+ * Check whether every group is guaranteed to be contained in a single
+ * chunk. This is the case when the query groups by time_bucket() on the time
+ * dimension and all chunk boundaries are bucket boundaries, so that no bucket
+ * spans more than one chunk. Groups can then be fully aggregated per chunk
+ * without a finalize step.
+ *
+ * With more than one dimension, a bucket is split over all chunks in the
+ * same time slice, so the query also has to group by the columns of all other
+ * dimensions. Each group then maps to exactly one partition of these
+ * dimensions.
+ */
+static bool
+groups_contained_in_chunks(PlannerInfo *root, Hypertable *ht, Index relid, List *group_exprs,
+						   List *chunk_paths)
+{
+	Dimension *dim = hyperspace_get_open_dimension(ht->space, 0);
+	ChunkAlignedBucket bucket;
+	bool found = false;
+	ListCell *lc;
+	int i;
+
+	if (dim == NULL || dim->partitioning != NULL)
+		return false;
+
+	for (i = 0; i < ht->space->num_dimensions; i++)
+	{
+		Dimension *other = &ht->space->dimensions[i];
+
+		if (other != dim && !group_exprs_contain_column(group_exprs, relid, other->column_attno))
+			return false;
+	}
+
+	foreach (lc, group_exprs)
+	{
+		if (time_bucket_on_time_dimension(root, relid, dim, lfirst(lc), &bucket))
+		{
+			found = true;
+			break;
+		}
+	}
+
+	if (!found)
+		return false;
+
+	foreach (lc, chunk_paths)
+	{
+		Path *path = lfirst(lc);
+		RangeTblEntry *rte = planner_rt_fetch(path->parent->relid, root);
+		Chunk *chunk = ts_chunk_get_by_relid(rte->relid, ht->space->num_dimensions, false);
+		DimensionSlice *slice;
+
+		if (chunk == NULL)
+			return false;
+
+		slice = ts_hypercube_get_slice_by_dimension_id(chunk->cube, dim->fd.id);
+
+		if (slice == NULL || !bucket_boundary_aligned(&bucket, slice->fd.range_start) ||
+			!bucket_boundary_aligned(&bucket, slice->fd.range_end))
+			return false;
+	}
+
+	return true;
+}
+
+/*
+ * Get the paths of the chunks from the input path of the aggregation. Returns
+ * NIL if the input is not a plain append of chunk scans.
+ */
+static List *
+get_chunk_paths(Path *path)
+{
+	ListCell *lc;
+	List *subpaths;
+
+	if (IsA(path, ProjectionPath))
+		path = castNode(ProjectionPath, path)->subpath;
+
+	switch (nodeTag(path))
+	{
+		case T_AppendPath:
+			subpaths = castNode(AppendPath, path)->subpaths;
+			break;
+		case T_MergeAppendPath:
+			subpaths = castNode(MergeAppendPath, path)->subpaths;
+			break;
+		default:
+			/*
+			 * This includes ConstraintAwareAppend, which would lose execution
+			 * time exclusion if we pushed aggregates below it.
+			 */
+			return NIL;
+	}
+
+	if (path->parallel_aware || PATH_REQ_OUTER(path) != NULL)
+		return NIL;
+
+	foreach (lc, subpaths)
+	{
+		Path *subpath = lfirst(lc);
+
+		if (subpath->parent->reloptkind != RELOPT_OTHER_MEMBER_REL)
+			return NIL;
+	}
+
+	return subpaths;
+}
+
+static Path *
+create_chunk_append_path(PlannerInfo *root, RelOptInfo *output_rel, List *subpaths,
+						 PathTarget *target)
+{
+	AppendPath *append;
+
+#if PG96
+	append = create_append_path(output_rel, subpaths, NULL, 0);
+#elif PG10
+	append = create_append_path(output_rel, subpaths, NULL, 0, NIL);
+#else
+	append = create_append_path(root, output_rel, subpaths, NIL, NULL, 0, false, NIL, -1);
+#endif
+	append->path.pathtarget = target;
+
+	return &append->path;
+}
+
+/*
+ * Add an aggregation path that aggregates each chunk separately below the
+ * Append instead of aggregating all tuples above it:
+ *
+ * Finalize HashAggregate
+ *   ->  Append
+ *         ->  Partial HashAggregate
+ *               ->  Scan on chunk 1
+ *         ->  Partial HashAggregate
+ *               ->  Scan on chunk 2
+ *
+ * Partial aggregation uses the combine and serialization support functions of
+ * the aggregates, the same way parallel aggregation does. When the query groups
+ * by a time_bucket() on the time dimension that never crosses a chunk
+ * boundary, every group is complete within a chunk and the chunks are
+ * aggregated fully without any finalize step, which keeps only one chunk's
+ * groups in memory at a time.
+ *
+ * Per-chunk aggregation needs one hash table per chunk to fit in work_mem,
+ * so the chunk aggregates are always hashed.
+ */
+static void
+plan_add_chunk_agg(PlannerInfo *root, Hypertable *ht, RelOptInfo *input_rel,
+				   RelOptInfo *output_rel)
+{
+	Query *parse = root->parse;
+	Path *input_path = input_rel->cheapest_total_path;
+	PathTarget *input_target = input_path->pathtarget;
+	PathTarget *target = root->upper_targets[UPPERREL_GROUP_AGG];
+	PathTarget *partial_target = NULL;
+	AggClauseCosts agg_costs;
+	AggClauseCosts agg_partial_costs;
+	AggClauseCosts agg_final_costs;
+	List *group_exprs;
+	List *chunk_paths;
+	List *chunk_aggs = NIL;
+	bool full_chunk_agg;
+	double d_num_groups;
+	Path *append;
+	ListCell *lc;
+
+	chunk_paths = get_chunk_paths(input_path);
+
+	/* nothing to gain for a single chunk */
+	if (list_length(chunk_paths) < 2)
+		return;
+
+	MemSet(&agg_costs, 0, sizeof(AggClauseCosts));
+	get_agg_clause_costs(root, (Node *) target->exprs, AGGSPLIT_SIMPLE, &agg_costs);
+	get_agg_clause_costs(root, parse->havingQual, AGGSPLIT_SIMPLE, &agg_costs);
+
+	if (agg_costs.numOrderedAggs > 0)
+		return;
+
+	group_exprs = get_sortgrouplist_exprs(parse->groupClause, parse->targetList);
+	full_chunk_agg =
+		groups_contained_in_chunks(root, ht, input_rel->relid, group_exprs, chunk_paths);
+
+	/* partial aggregation requires every aggregate to support it */
+	if (!full_chunk_agg && (agg_costs.hasNonPartial || agg_costs.hasNonSerial))
+		return;
+
+	d_num_groups = ts_plan_estimate_num_groups(root, input_path->rows);
+
+	if (!full_chunk_agg)
+	{
+		partial_target = ts_make_partial_grouping_target(root, target);
+
+		MemSet(&agg_partial_costs, 0, sizeof(AggClauseCosts));
+		MemSet(&agg_final_costs, 0, sizeof(AggClauseCosts));
+		get_agg_clause_costs(root,
+							 (Node *) partial_target->exprs,
+							 AGGSPLIT_INITIAL_SERIAL,
+							 &agg_partial_costs);
+		get_agg_clause_costs(root,
+							 (Node *) target->exprs,
+							 AGGSPLIT_FINAL_DESERIAL,
+							 &agg_final_costs);
+		get_agg_clause_costs(root, parse->havingQual, AGGSPLIT_FINAL_DESERIAL, &agg_final_costs);
+	}
+
+	foreach (lc, chunk_paths)
+	{
+		Path *chunk_path = lfirst(lc);
+		RelOptInfo *chunk_rel = chunk_path->parent;
+		AppendRelInfo *appinfo = get_appendrelinfo(root, chunk_rel->relid);
+		double chunk_groups = clamp_row_est(Min(d_num_groups, chunk_path->rows));
+		AggClauseCosts *costs = full_chunk_agg ? &agg_costs : &agg_partial_costs;
+		Path *agg;
+
+		if (ts_estimate_hashagg_tablesize(chunk_path, costs, chunk_groups) >= work_mem * 1024L)
+			return;
+
+		/* compute the grouping columns on the chunk */
+		chunk_path = (Path *) create_projection_path(root,
+													 chunk_rel,
+													 chunk_path,
+													 translate_target_to_chunk(root,
+																			   input_target,
+																			   appinfo));
+
+		if (full_chunk_agg)
+			agg = (Path *) create_agg_path(root,
+										   output_rel,
+										   chunk_path,
+										   translate_target_to_chunk(root, target, appinfo),
+										   AGG_HASHED,
+										   AGGSPLIT_SIMPLE,
+										   parse->groupClause,
+										   (List *)
+											   adjust_appendrel_attrs_compat(root,
+																			 parse->havingQual,
+																			 appinfo),
+										   &agg_costs,
+										   chunk_groups);
+		else
+			agg = (Path *) create_agg_path(root,
+										   output_rel,
+										   chunk_path,
+										   translate_target_to_chunk(root, partial_target, appinfo),
+										   AGG_HASHED,
+										   AGGSPLIT_INITIAL_SERIAL,
+										   parse->groupClause,
+										   NIL,
+										   &agg_partial_costs,
+										   chunk_groups);
+
+		chunk_aggs = lappend(chunk_aggs, agg);
+	}
+
+	if (full_chunk_agg)
+	{
+		add_path(output_rel, create_chunk_append_path(root, output_rel, chunk_aggs, target));
+		return;
+	}
+
+	append = create_chunk_append_path(root, output_rel, chunk_aggs, partial_target);
+
+	/*
+	 * Combine the partial groups with a hash table if it fits in work_mem.
+	 * Otherwise sort them, unless the grouping columns cannot be sorted, in
+	 * which case the hash table is used anyway, like the regular planner does.
+	 */
+	if (!grouping_is_sortable(parse->groupClause) ||
+		ts_estimate_hashagg_tablesize(append, &agg_final_costs, d_num_groups) < work_mem * 1024L)
+		add_path(output_rel,
+				 (Path *) create_agg_path(root,
+										  output_rel,
+										  append,
+										  target,
+										  AGG_HASHED,
+										  AGGSPLIT_FINAL_DESERIAL,
+										  parse->groupClause,
+										  (List *) parse->havingQual,
+										  &agg_final_costs,
+										  d_num_groups));
+	else
+		add_path(output_rel,
+				 (Path *) create_agg_path(root,
+										  output_rel,
+										  (Path *) create_sort_path(root,
+																	output_rel,
+																	append,
+																	root->group_pathkeys,
+																	-1.0),
+										  target,
+										  AGG_SORTED,
+										  AGGSPLIT_FINAL_DESERIAL,
+										  parse->groupClause,
+										  (List *) parse->havingQual,
+										  &agg_final_costs,
+										  d_num_groups));
+}
+
+void
+ts_plan_add_chunk_agg(PlannerInfo *root, RelOptInfo *input_rel, RelOptInfo *output_rel)
+{
+	Query *parse = root->parse;
+	RangeTblEntry *rte;
+	Hypertable *ht;
+	Cache *hcache;
+
+	if (!ts_guc_enable_chunk_aggregation || parse->groupingSets || !parse->hasAggs ||
+		parse->groupClause == NIL || !grouping_is_hashable(parse->groupClause) ||
+		input_rel->reloptkind != RELOPT_BASEREL || input_rel->cheapest_total_path == NULL)
+		return;
+
+	rte = planner_rt_fetch(input_rel->relid, root);
+
+	if (rte->rtekind != RTE_RELATION || !rte->inh)
+		return;
+
+	hcache = ts_hypertable_cache_pin();
+	ht = ts_hypertable_cache_get_entry(hcache, rte->relid);
+
+	if (ht != NULL)
+		plan_add_chunk_agg(root, ht, input_rel, output_rel);
+
+	ts_cache_release(hcache);
+}
@@ -0,0 +1,14 @@
+/*
+ * This file and its contents are licensed under the Apache License 2.0.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-APACHE for a copy of the license.
+ */
+#ifndef TIMESCALEDB_PLAN_CHUNK_AGG_H
+#define TIMESCALEDB_PLAN_CHUNK_AGG_H
+
+#include <nodes/relation.h>
+
+extern void ts_plan_add_chunk_agg(PlannerInfo *root, RelOptInfo *input_rel,
+								  RelOptInfo *output_rel);
+
+#endif /* TIMESCALEDB_PLAN_CHUNK_AGG_H */
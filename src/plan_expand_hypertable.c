@@ -33,6 +33,7 @@
 #include "extension.h"
 #include "chunk.h"
 #include "extension_constants.h"
+#include "stats.h"
 
 typedef struct CollectQualCtx
 {
@@ -326,6 +327,10 @@ ts_plan_expand_hypertable_chunks(Hypertable *ht, PlannerInfo *root, Oid parent_o
 	Index rti = rel->relid;
 	List *appinfos = NIL;
 	PlanRowMark *oldrc;
+	TimescaleDBPrivate *priv = rel->fdw_private;
+	uint64 scans_start = ts_stats.scans_total;
+	instr_time start;
+	instr_time duration;
 	CollectQualCtx ctx = {
 		.root = root,
 		.rel = rel,
@@ -342,6 +347,8 @@ ts_plan_expand_hypertable_chunks(Hypertable *ht, PlannerInfo *root, Oid parent_o
 	/* mark the parent as an append relation */
 	rte->inh = true;
 
+	INSTR_TIME_SET_CURRENT(start);
+
 	init_chunk_exclusion_func();
 
 	/* Walk the tree and find restrictions or chunk exclusion functions */
@@ -349,6 +356,28 @@ ts_plan_expand_hypertable_chunks(Hypertable *ht, PlannerInfo *root, Oid parent_o
 
 	inh_oids = get_chunk_oids(&ctx, root, rel, ht);
 
+	INSTR_TIME_SET_CURRENT(duration);
+	INSTR_TIME_SUBTRACT(duration, start);
+
+	if (priv != NULL)
+	{
+		priv->chunks_expanded = list_length(inh_oids);
+		priv->expand_catalog_scans = ts_stats.scans_total - scans_start;
+		priv->expand_time_us = INSTR_TIME_GET_MICROSEC(duration);
+	}
+
+	ts_stats_add(STATS_CHUNKS_PLANNED, list_length(inh_oids));
+
+	if (ts_guc_track_plan_exclusion)
+	{
+		List *all_oids = find_inheritance_children(ht->main_table_relid, NoLock);
+
+		if (list_length(all_oids) > list_length(inh_oids))
+			ts_stats_add(STATS_CHUNKS_EXCLUDED_PLAN, list_length(all_oids) - list_length(inh_oids));
+
+		list_free(all_oids);
+	}
+
 	/*
 	 * the simple_*_array structures have already been set, we need to add the
 	 * children to them
@@ -53,8 +53,10 @@
 #include "planner.h"
 #include "plan_expand_hypertable.h"
 #include "plan_add_hashagg.h"
+#include "plan_chunk_agg.h"
 #include "plan_agg_bookend.h"
 #include "plan_ordered_append.h"
+#include "skip_scan.h"
 
 void _planner_init(void);
 void _planner_fini(void);
@@ -194,7 +196,9 @@ should_optimize_append(const Path *path)
 		if (contain_mutable_functions((Node *) rinfo->clause))
 			return true;
 	}
-	return false;
+
+	/* Chunk summaries can only be checked at execution time */
+	return ts_guc_enable_chunk_summary_exclusion && rel->baserestrictinfo != NIL;
 }
 
 static inline bool
@@ -546,9 +550,12 @@ timescale_create_upper_paths_hook(PlannerInfo *root, UpperRelationKind stage, Re
 	if (UPPERREL_GROUP_AGG == stage)
 	{
 		ts_plan_add_hashagg(root, input_rel, output_rel);
+		ts_plan_add_chunk_agg(root, input_rel, output_rel);
 		if (parse->hasAggs)
 			ts_preprocess_first_last_aggregates(root, root->processed_tlist);
 	}
+	else if (UPPERREL_DISTINCT == stage)
+		ts_skip_scan_add_paths(root, input_rel, output_rel);
 }
 
 void
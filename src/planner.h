@@ -9,6 +9,10 @@
 typedef struct TimescaleDBPrivate
 {
 	bool appends_ordered;
+	/* Details of the hypertable expansion, shown by EXPLAIN ANALYZE VERBOSE */
+	int chunks_expanded;
+	int expand_catalog_scans;
+	int expand_time_us;
 } TimescaleDBPrivate;
 
 #endif /* TIMESCALEDB_PLANNER_H */
@@ -159,7 +159,7 @@ ts_estimate_hashagg_tablesize(struct Path *path, const struct AggClauseCosts *ag
 }
 
 /* copied verbatim from planner.c */
-struct PathTarget *
+TSDLLEXPORT struct PathTarget *
 ts_make_partial_grouping_target(struct PlannerInfo *root, PathTarget *grouping_target)
 {
 	struct Query *parse = root->parse;
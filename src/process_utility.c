@@ -47,6 +47,7 @@
 #include "catalog.h"
 #include "chunk.h"
 #include "chunk_index.h"
+#include "chunk_statistics.h"
 #include "compat.h"
 #include "copy.h"
 #include "errors.h"
@@ -243,6 +244,10 @@ process_copy(Node *parsetree, const char *query_string, char *completion_tag)
 	if (ht == NULL)
 	{
 		ts_cache_release(hcache);
+
+		/* Copying directly into a chunk bypasses the tracking of time ranges */
+		ts_chunk_statistics_invalidate_for_copy(relid);
+
 		return false;
 	}
 
@@ -355,6 +360,16 @@ foreach_chunk_relation(RangeVar *rv, process_chunk_t process_chunk, void *arg)
 	return foreach_chunk_relid(RangeVarGetRelid(rv, NoLock, true), process_chunk, arg);
 }
 
+/* Refreshes the cached statistics of a chunk after it has been analyzed */
+static void
+refresh_chunk_statistics(Hypertable *ht, Oid chunk_relid, void *arg)
+{
+	Chunk *chunk = ts_chunk_get_by_relid(chunk_relid, 0, false);
+
+	if (NULL != chunk)
+		ts_chunk_statistics_refresh(ht, chunk);
+}
+
 /*
  * PG11 modified  how vacuum works (see:
  * https://github.com/postgres/postgres/commit/11d8d72c27a64ea4e30adce11cf6c4f3dd3e60db)
@@ -432,6 +447,13 @@ process_vacuum(Node *parsetree, ProcessUtilityContext context)
 	stmt->relation->schemaname = NameStr(ht->fd.schema_name);
 	ExecVacuum(stmt, is_toplevel);
 
+	/*
+	 * The vacuum might have run in its own transactions, so the hypertable is
+	 * looked up again
+	 */
+	if (stmt->options & VACOPT_ANALYZE)
+		foreach_chunk_relid(hypertable_oid, refresh_chunk_statistics, NULL);
+
 	return true;
 }
 #else
@@ -472,7 +494,7 @@ process_vacuum(Node *parsetree, ProcessUtilityContext context)
 	Oid hypertable_oid;
 	Cache *hcache;
 	Hypertable *ht;
-	bool affects_hypertable = false;
+	List *hypertable_relids = NIL;
 
 	if (stmt->rels == NIL)
 		/* Vacuum is for all tables */
@@ -487,18 +509,27 @@ process_vacuum(Node *parsetree, ProcessUtilityContext context)
 		if (!OidIsValid(hypertable_oid))
 			continue;
 
-		affects_hypertable = true;
+		hypertable_relids = lappend_oid(hypertable_relids, hypertable_oid);
 		ht = ts_hypertable_cache_get_entry(hcache, hypertable_oid);
 		ctx.ht_vacuum_rel = vacuum_rel;
 		foreach_chunk(ht, add_chunk_to_vacuum, &ctx);
 	}
 	ts_cache_release(hcache);
-	if (!affects_hypertable)
+	if (hypertable_relids == NIL)
 		return false;
 
 	stmt->rels = list_concat(ctx.chunk_rels, stmt->rels);
 	PreventCommandDuringRecovery((stmt->options & VACOPT_VACUUM) ? "VACUUM" : "ANALYZE");
 	ExecVacuum(stmt, is_toplevel);
+
+	/*
+	 * The vacuum might have run in its own transactions, so the hypertables
+	 * are looked up again
+	 */
+	if (stmt->options & VACOPT_ANALYZE)
+		foreach (lc, hypertable_relids)
+			foreach_chunk_relid(lfirst_oid(lc), refresh_chunk_statistics, NULL);
+
 	return true;
 }
 #endif
@@ -1238,6 +1269,8 @@ typedef struct HypertableIndexOptions
 	 * transaction for all the chunks
 	 */
 	bool multitransaction;
+	/* true if the index should not be built on chunks at the write frontier */
+	bool deferred;
 	IndexInfo *indexinfo;
 	List *attnames;
 	int n_ht_atts;
@@ -1280,6 +1313,9 @@ process_index_chunk(Hypertable *ht, Oid chunk_relid, void *arg)
 	IndexStmt *stmt = transformIndexStmt(chunk_relid, info->stmt, NULL);
 	Chunk *chunk = ts_chunk_get_by_relid(chunk_relid, ht->space->num_dimensions, true);
 
+	if (info->extended_options.deferred && ts_chunk_is_at_write_frontier(ht, chunk))
+		return;
+
 	ts_chunk_index_create_from_stmt(stmt, chunk->fd.id, chunk_relid, ht->fd.id, info->obj.objectId);
 }
 
@@ -1326,6 +1362,19 @@ process_index_chunk_multitransaction(int32 hypertable_id, Oid chunk_relid, void
 	}
 #endif
 
+	if (info->extended_options.deferred)
+	{
+		Hypertable *ht = ts_hypertable_get_by_id(hypertable_id);
+
+		chunk = ts_chunk_get_by_relid(chunk_relid, ht->space->num_dimensions, true);
+
+		if (ts_chunk_is_at_write_frontier(ht, chunk))
+		{
+			CommitTransactionCommand();
+			return;
+		}
+	}
+
 	/*
 	 * Change user since chunks are typically located in an internal schema
 	 * and chunk indexes require metadata changes. In the single-transaction
@@ -1380,6 +1429,7 @@ process_index_chunk_multitransaction(int32 hypertable_id, Oid chunk_relid, void
 typedef enum HypertableIndexFlags
 {
 	HypertableIndexFlagMultiTransaction = 0,
+	HypertableIndexFlagDeferred,
 #ifdef DEBUG
 	HypertableIndexFlagBarrierTable,
 	HypertableIndexFlagMaxChunks,
@@ -1388,6 +1438,7 @@ typedef enum HypertableIndexFlags
 
 static const WithClauseDefinition index_with_clauses[] = {
 	[HypertableIndexFlagMultiTransaction] = {.arg_name = "transaction_per_chunk", .type_id = BOOLOID,},
+	[HypertableIndexFlagDeferred] = {.arg_name = "deferred", .type_id = BOOLOID,},
 #ifdef DEBUG
 	[HypertableIndexFlagBarrierTable] = {.arg_name = "barrier_table", .type_id = REGCLASSOID,},
 	[HypertableIndexFlagMaxChunks] = {.arg_name = "max_chunks", .type_id = INT4OID, .default_val = Int32GetDatum(-1)},
@@ -1463,6 +1514,8 @@ process_index_start(Node *parsetree, const char *queryString)
 
 	info.extended_options.multitransaction =
 		DatumGetBool(parsed_with_clauses[HypertableIndexFlagMultiTransaction].parsed);
+	info.extended_options.deferred =
+		DatumGetBool(parsed_with_clauses[HypertableIndexFlagDeferred].parsed);
 #ifdef DEBUG
 	info.extended_options.max_chunks =
 		DatumGetInt32(parsed_with_clauses[HypertableIndexFlagMaxChunks].parsed);
@@ -1484,6 +1537,12 @@ process_index_start(Node *parsetree, const char *queryString)
 				 errmsg(
 					 "cannot use timescaledb.transaction_per_chunk with UNIQUE or PRIMARY KEY")));
 
+	/* Uniqueness cannot be enforced on chunks that lack the index */
+	if (info.extended_options.deferred && (stmt->unique || stmt->primary || stmt->isconstraint))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("cannot use timescaledb.deferred with UNIQUE or PRIMARY KEY")));
+
 	ts_indexing_verify_index(ht->space, stmt);
 
 	if (info.extended_options.multitransaction)
@@ -1496,6 +1555,9 @@ process_index_start(Node *parsetree, const char *queryString)
 														   info.extended_options.multitransaction);
 	info.obj.objectId = root_table_index.objectId;
 
+	if (info.extended_options.deferred && OidIsValid(info.obj.objectId))
+		ts_chunk_index_set_deferred(ht->fd.id, get_rel_name(info.obj.objectId));
+
 	/* CREATE INDEX on the chunks */
 
 	/* create chunk indexes using the same transaction for all the chunks */
@@ -8,15 +8,18 @@
 #include <access/xact.h>
 #include <storage/lmgr.h>
 #include <storage/bufmgr.h>
+#include <utils/memutils.h>
 #include <utils/rel.h>
 #include <utils/tqual.h>
 
 #include "scanner.h"
+#include "stats.h"
 
 enum ScannerType
 {
 	ScannerTypeHeap,
 	ScannerTypeIndex,
+	ScannerTypeSessionIndex,
 };
 
 typedef union ScanDesc
@@ -25,6 +28,38 @@ typedef union ScanDesc
 	HeapScanDesc heap_scan;
 } ScanDesc;
 
+/*
+ * The relations of an index scan kept open by a scan session. Scans are
+ * matched on relation and lock mode. The scan descriptor only exists while a
+ * scan is running, so that no buffer pins are held between scans.
+ */
+typedef struct ScanSessionEntry
+{
+	Oid table;
+	Oid index;
+	LOCKMODE lockmode;
+	bool in_use;
+	SubTransactionId in_use_subid; /* subtransaction of the current scan */
+	SubTransactionId subid;		   /* subtransaction that opened the relations */
+	Relation tablerel;
+	Relation indexrel;
+	IndexScanDesc scan;
+} ScanSessionEntry;
+
+struct ScanSession
+{
+	MemoryContext mcxt;
+	List *entries;
+	List *begin_subids; /* subtransaction of every begin not ended yet */
+};
+
+/*
+ * The session that index scans are currently routed through, if any. There
+ * is at most one active session; nested ts_scan_session_begin() calls join
+ * it.
+ */
+static ScanSession *active_session = NULL;
+
 /*
  * InternalScannerCtx is the context passed to Scanner functions.
  * It holds a pointer to the user-given ScannerCtx as well as
@@ -36,6 +71,7 @@ typedef struct InternalScannerCtx
 	TupleInfo tinfo;
 	ScanDesc scan;
 	ScannerCtx *sctx;
+	ScanSessionEntry *entry;
 } InternalScannerCtx;
 
 /*
@@ -130,7 +166,74 @@ index_scanner_close(InternalScannerCtx *ctx)
 }
 
 /*
- * Two scanners by type: heap and index scanners.
+ * Functions implementing index scans through a scan session. The relations
+ * are opened on first use and stay open until the session ends.
+ */
+static ScanSessionEntry *
+scan_session_get_entry(ScanSession *session, ScannerCtx *sctx)
+{
+	ScanSessionEntry *entry;
+	ListCell *lc;
+	MemoryContext old;
+
+	foreach (lc, session->entries)
+	{
+		entry = lfirst(lc);
+
+		/* An entry in use belongs to a scan further up the stack */
+		if (!entry->in_use && entry->table == sctx->table && entry->index == sctx->index &&
+			entry->lockmode == sctx->lockmode)
+			return entry;
+	}
+
+	old = MemoryContextSwitchTo(session->mcxt);
+	entry = palloc0(sizeof(ScanSessionEntry));
+	entry->table = sctx->table;
+	entry->index = sctx->index;
+	entry->lockmode = sctx->lockmode;
+	entry->subid = GetCurrentSubTransactionId();
+	entry->tablerel = heap_open(sctx->table, sctx->lockmode);
+	entry->indexrel = index_open(sctx->index, sctx->lockmode);
+	session->entries = lappend(session->entries, entry);
+	MemoryContextSwitchTo(old);
+
+	return entry;
+}
+
+static Relation
+session_index_scanner_open(InternalScannerCtx *ctx)
+{
+	ctx->entry = scan_session_get_entry(active_session, ctx->sctx);
+	ctx->entry->in_use = true;
+	ctx->entry->in_use_subid = GetCurrentSubTransactionId();
+	ctx->tablerel = ctx->entry->tablerel;
+	ctx->indexrel = ctx->entry->indexrel;
+	return ctx->indexrel;
+}
+
+static ScanDesc
+session_index_scanner_beginscan(InternalScannerCtx *ctx)
+{
+	ctx->entry->scan = index_scanner_beginscan(ctx).index_scan;
+	return ctx->scan;
+}
+
+static void
+session_index_scanner_endscan(InternalScannerCtx *ctx)
+{
+	index_scanner_endscan(ctx);
+	ctx->entry->scan = NULL;
+}
+
+static void
+session_index_scanner_close(InternalScannerCtx *ctx)
+{
+	ctx->entry->in_use = false;
+}
+
+/*
+ * Scanners by type: heap and index scanners, and index scanners that reuse
+ * the relations and scan descriptors of the active scan session.
  */
 static Scanner scanners[] = {
 	[ScannerTypeHeap] = {
@@ -146,6 +249,13 @@ static Scanner scanners[] = {
 		.getnext = index_scanner_getnext,
 		.endscan = index_scanner_endscan,
 		.closeheap = index_scanner_close,
+	},
+	[ScannerTypeSessionIndex] = {
+		.openheap = session_index_scanner_open,
+		.beginscan = session_index_scanner_beginscan,
+		.getnext = index_scanner_getnext,
+		.endscan = session_index_scanner_endscan,
+		.closeheap = session_index_scanner_close,
 	}
 };
 
@@ -167,7 +277,11 @@ ts_scanner_scan(ScannerCtx *ctx)
 		.sctx = ctx,
 	};
 
-	if (OidIsValid(ctx->index))
+	ts_stats_count_scan(ctx->table);
+
+	if (OidIsValid(ctx->index) && active_session != NULL && ctx->norderbys == 0)
+		scanner = &scanners[ScannerTypeSessionIndex];
+	else if (OidIsValid(ctx->index))
 		scanner = &scanners[ScannerTypeIndex];
 	else
 		scanner = &scanners[ScannerTypeHeap];
@@ -258,3 +372,157 @@ ts_scanner_scan_one(ScannerCtx *ctx, bool fail_if_not_found, char *item_type)
 			return false;
 	}
 }
+
+/*
+ * Begin a scan session.
+ *
+ * While a session is active, catalog index scans made through
+ * ts_scanner_scan() keep their table and index open. This saves the cost of
+ * opening and closing the relations for callers that issue many small
+ * catalog scans in a row, like chunk lookups during inserts and planning.
+ *
+ * Sessions nest: a session begun while another one is active joins it, and
+ * the relations are closed when the outermost session ends. A session must
+ * be ended in the same (sub)transaction it was begun in. The relations are
+ * released with the resource owner on abort. Aborting the (sub)transaction
+ * that began the session forgets the session, while aborting a nested
+ * subtransaction only forgets the scans opened inside it.
+ */
+ScanSession *
+ts_scan_session_begin(void)
+{
+	MemoryContext old;
+
+	if (active_session == NULL)
+	{
+		MemoryContext mcxt =
+			AllocSetContextCreate(CurrentMemoryContext, "Scan session", ALLOCSET_SMALL_SIZES);
+
+		active_session = MemoryContextAllocZero(mcxt, sizeof(ScanSession));
+		active_session->mcxt = mcxt;
+	}
+
+	old = MemoryContextSwitchTo(active_session->mcxt);
+	active_session->begin_subids =
+		lappend_int(active_session->begin_subids, GetCurrentSubTransactionId());
+	MemoryContextSwitchTo(old);
+
+	return active_session;
+}
+
+void
+ts_scan_session_end(ScanSession *session)
+{
+	ListCell *lc;
+
+	Assert(session == active_session);
+	Assert(session->begin_subids != NIL);
+	Assert(llast_int(session->begin_subids) == GetCurrentSubTransactionId());
+
+	session->begin_subids =
+		list_truncate(session->begin_subids, list_length(session->begin_subids) - 1);
+
+	if (session->begin_subids != NIL)
+		return;
+
+	foreach (lc, session->entries)
+	{
+		ScanSessionEntry *entry = lfirst(lc);
+
+		Assert(!entry->in_use && entry->scan == NULL);
+		index_close(entry->indexrel, entry->lockmode);
+		heap_close(entry->tablerel, entry->lockmode);
+	}
+
+	active_session = NULL;
+	MemoryContextDelete(session->mcxt);
+}
+
+static void
+scan_session_xact_abort(XactEvent event, void *arg)
+{
+	switch (event)
+	{
+		case XACT_EVENT_ABORT:
+		case XACT_EVENT_PARALLEL_ABORT:
+			active_session = NULL;
+			break;
+		default:
+			break;
+	}
+}
+
+/*
+ * On subtransaction abort, the resource owner releases the relations opened
+ * in the aborted subtransaction and its children. If the session was begun
+ * there, it is forgotten. Otherwise, the session lives on in an outer
+ * subtransaction. It then drops the entries whose relations were released,
+ * frees the entries of scans that were cut short, and forgets the nested
+ * begins that will never be ended. The scan descriptor of a scan that was cut
+ * short is dropped without ending it, since the resource owner already
+ * released its buffer pins and index reference.
+ */
+static void
+scan_session_subxact_abort(SubXactEvent event, SubTransactionId mySubid,
+						   SubTransactionId parentSubid, void *arg)
+{
+	List *entries = NIL;
+	ListCell *lc;
+	MemoryContext old;
+	int nbegins = 0;
+
+	if (event != SUBXACT_EVENT_ABORT_SUB || active_session == NULL)
+		return;
+
+	if (linitial_int(active_session->begin_subids) >= mySubid)
+	{
+		active_session = NULL;
+		return;
+	}
+
+	/* Forget the begins whose ends were skipped by the abort */
+	foreach (lc, active_session->begin_subids)
+	{
+		if (lfirst_int(lc) >= mySubid)
+			break;
+		nbegins++;
+	}
+
+	active_session->begin_subids = list_truncate(active_session->begin_subids, nbegins);
+
+	old = MemoryContextSwitchTo(active_session->mcxt);
+
+	foreach (lc, active_session->entries)
+	{
+		ScanSessionEntry *entry = lfirst(lc);
+
+		if (entry->subid >= mySubid)
+			continue;
+
+		/* A scan that errored out in the subtransaction never closed */
+		if (entry->in_use && entry->in_use_subid >= mySubid)
+		{
+			entry->in_use = false;
+			entry->scan = NULL;
+		}
+
+		entries = lappend(entries, entry);
+	}
+
+	MemoryContextSwitchTo(old);
+	active_session->entries = entries;
+}
+
+void
+_scanner_init(void)
+{
+	RegisterXactCallback(scan_session_xact_abort, NULL);
+	RegisterSubXactCallback(scan_session_subxact_abort, NULL);
+}
+
+void
+_scanner_fini(void)
+{
+	UnregisterXactCallback(scan_session_xact_abort, NULL);
+	UnregisterSubXactCallback(scan_session_subxact_abort, NULL);
+}
@@ -99,9 +99,15 @@ typedef struct ScannerCtx
 	ScanTupleResult (*tuple_found)(TupleInfo *ti, void *data);
 } ScannerCtx;
 
+typedef struct ScanSession ScanSession;
+
 /* Performs an index scan or heap scan and returns the number of matching
  * tuples. */
 extern int ts_scanner_scan(ScannerCtx *ctx);
 extern bool ts_scanner_scan_one(ScannerCtx *ctx, bool fail_if_not_found, char *item_type);
 
+/* Reuse catalog relations and index scans across ts_scanner_scan() calls */
+extern ScanSession *ts_scan_session_begin(void);
+extern void ts_scan_session_end(ScanSession *session);
+
 #endif /* TIMESCALEDB_SCANNER_H */
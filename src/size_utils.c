@@ -0,0 +1,702 @@
+/*
+ * This file and its contents are licensed under the Apache License 2.0.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-APACHE for a copy of the license.
+ */
+#include <postgres.h>
+#include <math.h>
+#include <access/htup_details.h>
+#include <catalog/namespace.h>
+#include <catalog/pg_class.h>
+#include <catalog/pg_type.h>
+#include <fmgr.h>
+#include <funcapi.h>
+#include <miscadmin.h>
+#include <utils/array.h>
+#include <utils/builtins.h>
+#include <utils/lsyscache.h>
+#include <utils/rangetypes.h>
+#include <utils/syscache.h>
+#include <utils/tuplestore.h>
+#include <utils/typcache.h>
+
+#include "compat.h"
+#include "catalog.h"
+#include "chunk.h"
+#include "dimension.h"
+#include "hypercube.h"
+#include "hypertable.h"
+#include "hypertable_cache.h"
+#include "scanner.h"
+
+/*
+ * Native implementations of the size utilities in sql/size_utils.sql.
+ *
+ * The chunks of a hypertable are found with a single scan of the chunk
+ * catalog and resolved to their relation OIDs directly, instead of joining
+ * the catalog with pg_class on relation names. Sizes are summed with the
+ * same functions that back pg_total_relation_size() and friends, but without
+ * going through SQL for every chunk.
+ */
+
+TS_FUNCTION_INFO_V1(ts_hypertable_relation_size);
+TS_FUNCTION_INFO_V1(ts_chunk_relation_size);
+TS_FUNCTION_INFO_V1(ts_indexes_relation_size);
+TS_FUNCTION_INFO_V1(ts_hypertable_approximate_row_count);
+
+/*
+ * Set up a tuplestore to materialize the result of a set-returning function.
+ */
+static Tuplestorestate *
+size_utils_materialize_begin(FunctionCallInfo fcinfo, TupleDesc *tupdesc)
+{
+	ReturnSetInfo *rsinfo = (ReturnSetInfo *) fcinfo->resultinfo;
+	Tuplestorestate *tupstore;
+	MemoryContext oldcontext;
+
+	if (rsinfo == NULL || !IsA(rsinfo, ReturnSetInfo))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("set-valued function called in context that cannot accept a set")));
+
+	if (!(rsinfo->allowedModes & SFRM_Materialize))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("materialize mode required, but it is not allowed in this context")));
+
+	if (get_call_result_type(fcinfo, NULL, tupdesc) != TYPEFUNC_COMPOSITE)
+		elog(ERROR, "return type must be a row type");
+
+	oldcontext = MemoryContextSwitchTo(rsinfo->econtext->ecxt_per_query_memory);
+	*tupdesc = CreateTupleDescCopy(*tupdesc);
+	tupstore = tuplestore_begin_heap(true, false, work_mem);
+	rsinfo->returnMode = SFRM_Materialize;
+	rsinfo->setResult = tupstore;
+	rsinfo->setDesc = *tupdesc;
+	MemoryContextSwitchTo(oldcontext);
+
+	return tupstore;
+}
+
+/*
+ * Call one of PostgreSQL's relation size functions. These return NULL,
+ * rather than failing, in case the relation was concurrently dropped, so
+ * DirectFunctionCall cannot be used.
+ */
+static bool
+relation_size_call(PGFunction sizefunc, Oid relid, int64 *size)
+{
+	FunctionCallInfoData fcinfo;
+	Datum result;
+
+	if (!OidIsValid(relid))
+		return false;
+
+	InitFunctionCallInfoData(fcinfo, NULL, 1, InvalidOid, NULL, NULL);
+	fcinfo.arg[0] = ObjectIdGetDatum(relid);
+	fcinfo.argnull[0] = false;
+
+	result = sizefunc(&fcinfo);
+
+	if (fcinfo.isnull)
+		return false;
+
+	*size = DatumGetInt64(result);
+
+	return true;
+}
+
+/* Size of the main fork of a relation, like pg_relation_size(relid) */
+static bool
+relation_main_fork_size(Oid relid, int64 *size)
+{
+	FunctionCallInfoData fcinfo;
+	Datum result;
+
+	if (!OidIsValid(relid))
+		return false;
+
+	InitFunctionCallInfoData(fcinfo, NULL, 2, InvalidOid, NULL, NULL);
+	fcinfo.arg[0] = ObjectIdGetDatum(relid);
+	fcinfo.arg[1] = CStringGetTextDatum("main");
+	fcinfo.argnull[0] = false;
+	fcinfo.argnull[1] = false;
+
+	result = pg_relation_size(&fcinfo);
+
+	if (fcinfo.isnull)
+		return false;
+
+	*size = DatumGetInt64(result);
+
+	return true;
+}
+
+static Oid
+get_toastrelid(Oid relid)
+{
+	HeapTuple tuple = SearchSysCache1(RELOID, ObjectIdGetDatum(relid));
+	Oid toastrelid;
+
+	if (!HeapTupleIsValid(tuple))
+		return InvalidOid;
+
+	toastrelid = ((Form_pg_class) GETSTRUCT(tuple))->reltoastrelid;
+	ReleaseSysCache(tuple);
+
+	return toastrelid;
+}
+
+typedef struct ChunkSize
+{
+	int64 table_bytes;
+	int64 index_bytes;
+	int64 toast_bytes;
+	int64 total_bytes;
+	bool has_toast;
+} ChunkSize;
+
+/*
+ * Get the size of a chunk's table, the same way as pg_total_relation_size(),
+ * pg_indexes_size() and pg_total_relation_size(reltoastrelid) would.
+ *
+ * The total size is computed as the table size (which includes TOAST) plus
+ * the index size, so that the indexes are only opened once.
+ */
+static bool
+chunk_size_get(Chunk *chunk, ChunkSize *size)
+{
+	int64 table_size;
+
+	if (!relation_size_call(pg_table_size, chunk->table_id, &table_size) ||
+		!relation_size_call(pg_indexes_size, chunk->table_id, &size->index_bytes))
+		return false;
+
+	size->total_bytes = table_size + size->index_bytes;
+	size->has_toast = relation_size_call(pg_total_relation_size,
+										 get_toastrelid(chunk->table_id),
+										 &size->toast_bytes);
+
+	if (!size->has_toast)
+		size->toast_bytes = 0;
+
+	size->table_bytes = size->total_bytes - size->index_bytes - size->toast_bytes;
+
+	return true;
+}
+
+enum Anum_hypertable_relation_size
+{
+	Anum_hypertable_relation_size_table_bytes = 1,
+	Anum_hypertable_relation_size_index_bytes,
+	Anum_hypertable_relation_size_toast_bytes,
+	Anum_hypertable_relation_size_total_bytes,
+	_Anum_hypertable_relation_size_max,
+};
+
+#define Natts_hypertable_relation_size (_Anum_hypertable_relation_size_max - 1)
+
+/*
+ * Get the size of a hypertable, i.e., the sum of the sizes of its chunks.
+ *
+ * Like the aggregate it replaces, this returns a single row of NULLs if the
+ * table is not a hypertable or has no chunks.
+ */
+Datum
+ts_hypertable_relation_size(PG_FUNCTION_ARGS)
+{
+	Oid relid = PG_GETARG_OID(0);
+	TupleDesc tupdesc;
+	Tuplestorestate *tupstore = size_utils_materialize_begin(fcinfo, &tupdesc);
+	Cache *hcache = ts_hypertable_cache_pin();
+	Hypertable *ht = ts_hypertable_cache_get_entry(hcache, relid);
+	Datum values[Natts_hypertable_relation_size];
+	bool nulls[Natts_hypertable_relation_size] = { true, true, true, true };
+	int64 index_bytes = 0;
+	int64 toast_bytes = 0;
+	int64 total_bytes = 0;
+	bool found = false;
+	bool has_toast = false;
+
+	if (NULL != ht)
+	{
+		Chunk **chunks;
+		uint64 num_chunks;
+		uint64 i;
+
+		chunks = ts_chunk_get_by_hypertable_id(ht->fd.id, 0, CurrentMemoryContext, &num_chunks);
+
+		for (i = 0; i < num_chunks; i++)
+		{
+			ChunkSize size;
+
+			if (!chunk_size_get(chunks[i], &size))
+				continue;
+
+			found = true;
+			total_bytes += size.total_bytes;
+			index_bytes += size.index_bytes;
+			toast_bytes += size.toast_bytes;
+			has_toast = has_toast || size.has_toast;
+		}
+	}
+
+	ts_cache_release(hcache);
+
+	if (found)
+	{
+		values[AttrNumberGetAttrOffset(Anum_hypertable_relation_size_table_bytes)] =
+			Int64GetDatum(total_bytes - index_bytes - toast_bytes);
+		values[AttrNumberGetAttrOffset(Anum_hypertable_relation_size_index_bytes)] =
+			Int64GetDatum(index_bytes);
+		values[AttrNumberGetAttrOffset(Anum_hypertable_relation_size_toast_bytes)] =
+			Int64GetDatum(toast_bytes);
+		values[AttrNumberGetAttrOffset(Anum_hypertable_relation_size_total_bytes)] =
+			Int64GetDatum(total_bytes);
+		memset(nulls, false, sizeof(nulls));
+		nulls[AttrNumberGetAttrOffset(Anum_hypertable_relation_size_toast_bytes)] = !has_toast;
+	}
+
+	tuplestore_putvalues(tupstore, tupdesc, values, nulls);
+
+	return (Datum) 0;
+}
+
+/*
+ * Order dimensions by interval length and then column name, with closed
+ * dimensions (that have no interval length) last.
+ */
+static int
+dimension_cmp_interval_and_name(const void *left, const void *right)
+{
+	const Dimension *d1 = *((const Dimension **) left);
+	const Dimension *d2 = *((const Dimension **) right);
+
+	if (IS_OPEN_DIMENSION(d1) != IS_OPEN_DIMENSION(d2))
+		return IS_OPEN_DIMENSION(d1) ? -1 : 1;
+
+	if (IS_OPEN_DIMENSION(d1) && d1->fd.interval_length != d2->fd.interval_length)
+		return d1->fd.interval_length < d2->fd.interval_length ? -1 : 1;
+
+	return strncmp(NameStr(d1->fd.column_name), NameStr(d2->fd.column_name), NAMEDATALEN);
+}
+
+enum Anum_chunk_relation_size
+{
+	Anum_chunk_relation_size_chunk_id = 1,
+	Anum_chunk_relation_size_chunk_table,
+	Anum_chunk_relation_size_partitioning_columns,
+	Anum_chunk_relation_size_partitioning_column_types,
+	Anum_chunk_relation_size_partitioning_hash_functions,
+	Anum_chunk_relation_size_ranges,
+	Anum_chunk_relation_size_table_bytes,
+	Anum_chunk_relation_size_index_bytes,
+	Anum_chunk_relation_size_toast_bytes,
+	Anum_chunk_relation_size_total_bytes,
+	_Anum_chunk_relation_size_max,
+};
+
+#define Natts_chunk_relation_size (_Anum_chunk_relation_size_max - 1)
+
+/*
+ * Get the size of each chunk of a hypertable, along with the chunk's
+ * partitioning columns and ranges. Chunks are returned in chunk ID order.
+ */
+Datum
+ts_chunk_relation_size(PG_FUNCTION_ARGS)
+{
+	Oid relid = PG_GETARG_OID(0);
+	TupleDesc tupdesc;
+	Tuplestorestate *tupstore = size_utils_materialize_begin(fcinfo, &tupdesc);
+	Cache *hcache = ts_hypertable_cache_pin();
+	Hypertable *ht = ts_hypertable_cache_get_entry(hcache, relid);
+	TypeCacheEntry *rangetypcache;
+	Dimension **dims;
+	Datum *colnames;
+	Datum *coltypes;
+	Datum *hashfuncs;
+	bool *hashfuncs_nulls;
+	Datum *ranges;
+	Chunk **chunks;
+	uint64 num_chunks;
+	uint64 i;
+	int num_dims;
+	int j;
+
+	if (NULL == ht)
+	{
+		ts_cache_release(hcache);
+		return (Datum) 0;
+	}
+
+	num_dims = ht->space->num_dimensions;
+	dims = palloc(sizeof(Dimension *) * num_dims);
+
+	for (j = 0; j < num_dims; j++)
+		dims[j] = &ht->space->dimensions[j];
+
+	qsort(dims, num_dims, sizeof(Dimension *), dimension_cmp_interval_and_name);
+
+	colnames = palloc(sizeof(Datum) * num_dims);
+	coltypes = palloc(sizeof(Datum) * num_dims);
+	hashfuncs = palloc(sizeof(Datum) * num_dims);
+	hashfuncs_nulls = palloc(sizeof(bool) * num_dims);
+	ranges = palloc(sizeof(Datum) * num_dims);
+	rangetypcache = lookup_type_cache(INT8RANGEOID, TYPECACHE_RANGE_INFO);
+
+	chunks =
+		ts_chunk_get_by_hypertable_id(ht->fd.id, num_dims, CurrentMemoryContext, &num_chunks);
+
+	for (i = 0; i < num_chunks; i++)
+	{
+		Chunk *chunk = chunks[i];
+		Datum values[Natts_chunk_relation_size];
+		bool nulls[Natts_chunk_relation_size] = { false };
+		ChunkSize size;
+		int num_slices = 0;
+		int dims_lbound = 1;
+
+		if (!chunk_size_get(chunk, &size))
+			continue;
+
+		for (j = 0; j < num_dims; j++)
+		{
+			Dimension *dim = dims[j];
+			DimensionSlice *slice = ts_hypercube_get_slice_by_dimension_id(chunk->cube, dim->fd.id);
+			RangeBound lower = {
+				.inclusive = true,
+				.lower = true,
+			};
+			RangeBound upper = {
+				.inclusive = false,
+				.lower = false,
+			};
+
+			if (NULL == slice)
+				continue;
+
+			colnames[num_slices] = NameGetDatum(&dim->fd.column_name);
+			coltypes[num_slices] = ObjectIdGetDatum(dim->fd.column_type);
+
+			if (NULL != dim->partitioning)
+			{
+				hashfuncs[num_slices] =
+					CStringGetTextDatum(psprintf("%s.%s",
+												 NameStr(dim->fd.partitioning_func_schema),
+												 NameStr(dim->fd.partitioning_func)));
+				hashfuncs_nulls[num_slices] = false;
+			}
+			else
+			{
+				hashfuncs[num_slices] = (Datum) 0;
+				hashfuncs_nulls[num_slices] = true;
+			}
+
+			lower.val = Int64GetDatum(slice->fd.range_start);
+			upper.val = Int64GetDatum(slice->fd.range_end);
+			ranges[num_slices] =
+				RangeTypeGetDatum(make_range(rangetypcache, &lower, &upper, false));
+			num_slices++;
+		}
+
+		values[AttrNumberGetAttrOffset(Anum_chunk_relation_size_chunk_id)] =
+			Int32GetDatum(chunk->fd.id);
+		values[AttrNumberGetAttrOffset(Anum_chunk_relation_size_chunk_table)] =
+			CStringGetTextDatum(quote_qualified_identifier(NameStr(chunk->fd.schema_name),
+														   NameStr(chunk->fd.table_name)));
+		values[AttrNumberGetAttrOffset(Anum_chunk_relation_size_partitioning_columns)] =
+			PointerGetDatum(
+				construct_array(colnames, num_slices, NAMEOID, NAMEDATALEN, false, 'c'));
+		values[AttrNumberGetAttrOffset(Anum_chunk_relation_size_partitioning_column_types)] =
+			PointerGetDatum(
+				construct_array(coltypes, num_slices, REGTYPEOID, sizeof(Oid), true, 'i'));
+		values[AttrNumberGetAttrOffset(Anum_chunk_relation_size_partitioning_hash_functions)] =
+			PointerGetDatum(construct_md_array(hashfuncs,
+											   hashfuncs_nulls,
+											   1,
+											   &num_slices,
+											   &dims_lbound,
+											   TEXTOID,
+											   -1,
+											   false,
+											   'i'));
+		values[AttrNumberGetAttrOffset(Anum_chunk_relation_size_ranges)] =
+			PointerGetDatum(construct_array(ranges,
+											num_slices,
+											INT8RANGEOID,
+											rangetypcache->typlen,
+											rangetypcache->typbyval,
+											rangetypcache->typalign));
+		values[AttrNumberGetAttrOffset(Anum_chunk_relation_size_table_bytes)] =
+			Int64GetDatum(size.table_bytes);
+		values[AttrNumberGetAttrOffset(Anum_chunk_relation_size_index_bytes)] =
+			Int64GetDatum(size.index_bytes);
+		values[AttrNumberGetAttrOffset(Anum_chunk_relation_size_toast_bytes)] =
+			Int64GetDatum(size.toast_bytes);
+		nulls[AttrNumberGetAttrOffset(Anum_chunk_relation_size_toast_bytes)] = !size.has_toast;
+		values[AttrNumberGetAttrOffset(Anum_chunk_relation_size_total_bytes)] =
+			Int64GetDatum(size.total_bytes);
+
+		tuplestore_putvalues(tupstore, tupdesc, values, nulls);
+	}
+
+	ts_cache_release(hcache);
+
+	return (Datum) 0;
+}
+
+typedef struct IndexSizeCtx
+{
+	Chunk **chunks;
+	uint64 num_chunks;
+	Tuplestorestate *tupstore;
+	TupleDesc tupdesc;
+	const char *schema_name;
+	NameData index_name;
+	int64 total_bytes;
+	bool found;
+} IndexSizeCtx;
+
+enum Anum_indexes_relation_size
+{
+	Anum_indexes_relation_size_index_name = 1,
+	Anum_indexes_relation_size_total_bytes,
+	_Anum_indexes_relation_size_max,
+};
+
+#define Natts_indexes_relation_size (_Anum_indexes_relation_size_max - 1)
+
+static void
+index_size_emit(IndexSizeCtx *ctx)
+{
+	Datum values[Natts_indexes_relation_size];
+	bool nulls[Natts_indexes_relation_size] = { false };
+
+	if (!ctx->found)
+		return;
+
+	values[AttrNumberGetAttrOffset(Anum_indexes_relation_size_index_name)] = CStringGetTextDatum(
+		quote_qualified_identifier(ctx->schema_name, NameStr(ctx->index_name)));
+	values[AttrNumberGetAttrOffset(Anum_indexes_relation_size_total_bytes)] =
+		Int64GetDatum(ctx->total_bytes);
+
+	tuplestore_putvalues(ctx->tupstore, ctx->tupdesc, values, nulls);
+
+	ctx->total_bytes = 0;
+	ctx->found = false;
+}
+
+static Chunk *
+index_size_get_chunk(IndexSizeCtx *ctx, int32 chunk_id)
+{
+	uint64 low = 0;
+	uint64 high = ctx->num_chunks;
+
+	/* The chunks are ordered by ID */
+	while (low < high)
+	{
+		uint64 mid = low + (high - low) / 2;
+
+		if (ctx->chunks[mid]->fd.id == chunk_id)
+			return ctx->chunks[mid];
+
+		if (ctx->chunks[mid]->fd.id < chunk_id)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+
+	return NULL;
+}
+
+static ScanTupleResult
+index_size_tuple_found(TupleInfo *ti, void *data)
+{
+	IndexSizeCtx *ctx = data;
+	FormData_chunk_index *chunk_index = (FormData_chunk_index *) GETSTRUCT(ti->tuple);
+	Chunk *chunk = index_size_get_chunk(ctx, chunk_index->chunk_id);
+	int64 size;
+
+	/* Tuples are ordered by hypertable index name, so group consecutive tuples */
+	if (namestrcmp(&ctx->index_name, NameStr(chunk_index->hypertable_index_name)) != 0)
+	{
+		index_size_emit(ctx);
+		namecpy(&ctx->index_name, &chunk_index->hypertable_index_name);
+	}
+
+	if (NULL == chunk || !OidIsValid(chunk->table_id))
+		return SCAN_CONTINUE;
+
+	if (relation_main_fork_size(get_relname_relid(NameStr(chunk_index->index_name),
+												  get_rel_namespace(chunk->table_id)),
+								&size))
+	{
+		ctx->total_bytes += size;
+		ctx->found = true;
+	}
+
+	return SCAN_CONTINUE;
+}
+
+/*
+ * Get the size of each index on a hypertable, i.e., the sum of the sizes of
+ * the corresponding indexes on the chunks.
+ */
+Datum
+ts_indexes_relation_size(PG_FUNCTION_ARGS)
+{
+	Oid relid = PG_GETARG_OID(0);
+	Catalog *catalog = ts_catalog_get();
+	Cache *hcache = ts_hypertable_cache_pin();
+	Hypertable *ht = ts_hypertable_cache_get_entry(hcache, relid);
+	ScanKeyData scankey[1];
+	IndexSizeCtx ctx = { 0 };
+	ScannerCtx scanctx = {
+		.table = catalog_get_table_id(catalog, CHUNK_INDEX),
+		.index = catalog_get_index(catalog,
+								   CHUNK_INDEX,
+								   CHUNK_INDEX_HYPERTABLE_ID_HYPERTABLE_INDEX_NAME_IDX),
+		.nkeys = 1,
+		.scankey = scankey,
+		.tuple_found = index_size_tuple_found,
+		.data = &ctx,
+		.lockmode = AccessShareLock,
+		.scandirection = ForwardScanDirection,
+	};
+
+	ctx.tupstore = size_utils_materialize_begin(fcinfo, &ctx.tupdesc);
+
+	if (NULL == ht)
+	{
+		ts_cache_release(hcache);
+		return (Datum) 0;
+	}
+
+	ctx.schema_name = pstrdup(NameStr(ht->fd.schema_name));
+	ctx.chunks = ts_chunk_get_by_hypertable_id(ht->fd.id, 0, CurrentMemoryContext, &ctx.num_chunks);
+
+	ScanKeyInit(&scankey[0],
+				Anum_chunk_index_hypertable_id_hypertable_index_name_idx_hypertable_id,
+				BTEqualStrategyNumber,
+				F_INT4EQ,
+				Int32GetDatum(ht->fd.id));
+
+	ts_scanner_scan(&scanctx);
+	index_size_emit(&ctx);
+
+	ts_cache_release(hcache);
+
+	return (Datum) 0;
+}
+
+enum Anum_approximate_row_count
+{
+	Anum_approximate_row_count_schema_name = 1,
+	Anum_approximate_row_count_table_name,
+	Anum_approximate_row_count_row_estimate,
+	_Anum_approximate_row_count_max,
+};
+
+#define Natts_approximate_row_count (_Anum_approximate_row_count_max - 1)
+
+static void
+approximate_row_count_put(Tuplestorestate *tupstore, TupleDesc tupdesc, Hypertable *ht)
+{
+	Datum values[Natts_approximate_row_count];
+	bool nulls[Natts_approximate_row_count] = { false };
+	Chunk **chunks;
+	uint64 num_chunks;
+	uint64 i;
+	double reltuples = 0;
+	bool found = false;
+
+	chunks = ts_chunk_get_by_hypertable_id(ht->fd.id, 0, CurrentMemoryContext, &num_chunks);
+
+	for (i = 0; i < num_chunks; i++)
+	{
+		HeapTuple tuple;
+
+		if (!OidIsValid(chunks[i]->table_id))
+			continue;
+
+		tuple = SearchSysCache1(RELOID, ObjectIdGetDatum(chunks[i]->table_id));
+
+		if (!HeapTupleIsValid(tuple))
+			continue;
+
+		reltuples += ((Form_pg_class) GETSTRUCT(tuple))->reltuples;
+		found = true;
+		ReleaseSysCache(tuple);
+	}
+
+	pfree(chunks);
+
+	/* Hypertables without chunks are not part of the result */
+	if (!found)
+		return;
+
+	values[AttrNumberGetAttrOffset(Anum_approximate_row_count_schema_name)] =
+		NameGetDatum(&ht->fd.schema_name);
+	values[AttrNumberGetAttrOffset(Anum_approximate_row_count_table_name)] =
+		NameGetDatum(&ht->fd.table_name);
+	values[AttrNumberGetAttrOffset(Anum_approximate_row_count_row_estimate)] =
+		Int64GetDatum((int64) rint(reltuples));
+
+	tuplestore_putvalues(tupstore, tupdesc, values, nulls);
+}
+
+static int
+hypertable_cmp_name(const void *left, const void *right)
+{
+	const Hypertable *ht1 = *((const Hypertable **) left);
+	const Hypertable *ht2 = *((const Hypertable **) right);
+	int cmp = namestrcmp((Name) &ht1->fd.schema_name, NameStr(ht2->fd.schema_name));
+
+	if (cmp != 0)
+		return cmp;
+
+	return namestrcmp((Name) &ht1->fd.table_name, NameStr(ht2->fd.table_name));
+}
+
+/*
+ * Get the approximate row count of a hypertable, or of all hypertables if
+ * the argument is NULL, based on the row estimates of the chunks in
+ * pg_class. Hypertables are returned in name order.
+ */
+Datum
+ts_hypertable_approximate_row_count(PG_FUNCTION_ARGS)
+{
+	TupleDesc tupdesc;
+	Tuplestorestate *tupstore = size_utils_materialize_begin(fcinfo, &tupdesc);
+
+	if (!PG_ARGISNULL(0))
+	{
+		Cache *hcache = ts_hypertable_cache_pin();
+		Hypertable *ht = ts_hypertable_cache_get_entry(hcache, PG_GETARG_OID(0));
+
+		if (NULL != ht)
+			approximate_row_count_put(tupstore, tupdesc, ht);
+
+		ts_cache_release(hcache);
+	}
+	else
+	{
+		List *hypertables = ts_hypertable_get_all();
+		Hypertable **sorted;
+		ListCell *lc;
+		int num_hypertables = list_length(hypertables);
+		int i = 0;
+
+		sorted = palloc(sizeof(Hypertable *) * (num_hypertables + 1));
+
+		foreach (lc, hypertables)
+			sorted[i++] = lfirst(lc);
+
+		qsort(sorted, num_hypertables, sizeof(Hypertable *), hypertable_cmp_name);
+
+		for (i = 0; i < num_hypertables; i++)
+			approximate_row_count_put(tupstore, tupdesc, sorted[i]);
+	}
+
+	return (Datum) 0;
+}
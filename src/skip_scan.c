@@ -0,0 +1,687 @@
+/*
+ * This file and its contents are licensed under the Apache License 2.0.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-APACHE for a copy of the license.
+ */
+#include <postgres.h>
+#include <access/sdir.h>
+#include <access/skey.h>
+#include <access/stratnum.h>
+#include <catalog/pg_am.h>
+#include <catalog/pg_type.h>
+#include <executor/executor.h>
+#include <nodes/execnodes.h>
+#include <nodes/extensible.h>
+#include <nodes/makefuncs.h>
+#include <nodes/nodeFuncs.h>
+#include <nodes/plannodes.h>
+#include <optimizer/clauses.h>
+#include <optimizer/pathnode.h>
+#include <optimizer/paths.h>
+#include <parser/parsetree.h>
+#include <utils/datum.h>
+#include <utils/lsyscache.h>
+
+#include "compat-msvc-enter.h"
+#include <optimizer/cost.h>
+#include "compat-msvc-exit.h"
+
+#include "compat.h"
+#include "constraint_aware_append.h"
+#include "guc.h"
+#include "hypertable_cache.h"
+#include "skip_scan.h"
+
+/*
+ * SkipScan
+ *
+ * A SkipScan node sits on top of a btree IndexScan (or IndexOnlyScan) whose
+ * leading index column is the single DISTINCT (ON) column of a query. Instead
+ * of reading every tuple from the index, it returns the first tuple for a
+ * distinct value and then repositions the index scan to the next distinct
+ * value by rescanning with an additional scan key on the leading column:
+ *
+ *   SELECT DISTINCT ON (device_id) * FROM metrics ORDER BY device_id, time DESC;
+ *
+ * becomes one index descent per device instead of a full scan. For
+ * hypertables the node is applied per chunk below the (Merge)Append so that
+ * chunk exclusion and the Unique node on top keep working unchanged.
+ *
+ * The extra scan key is added to the index qual at plan time as
+ * "col > NULL" (or "col < NULL" depending on scan direction), which is never
+ * true. At execution time the flags and argument of that scan key are
+ * updated before every rescan to walk through the following stages:
+ *
+ *   SS_NULLS_FIRST: col IS NULL, if NULLs come first in scan order
+ *   SS_NOT_NULL:    col IS NOT NULL, to find the first non-NULL value
+ *   SS_VALUES:      col > prev (or col < prev), to find the next value
+ *   SS_NULLS_LAST:  col IS NULL, if NULLs come last in scan order
+ */
+typedef enum SkipScanStage
+{
+	SS_BEGIN = 0,
+	SS_NULLS_FIRST,
+	SS_NOT_NULL,
+	SS_VALUES,
+	SS_NULLS_LAST,
+	SS_END,
+} SkipScanStage;
+
+typedef struct SkipScanState
+{
+	CustomScanState csstate;
+	PlanState *child;
+	ScanKey skip_key;
+	int skip_key_flags;
+	SkipScanStage stage;
+	bool needs_rescan;
+	bool nulls_first;
+	AttrNumber distinct_attno;
+	bool distinct_by_val;
+	int distinct_typ_len;
+	Datum prev_value;
+} SkipScanState;
+
+static void
+skip_scan_free_prev_value(SkipScanState *state)
+{
+	if (state->stage == SS_VALUES && !state->distinct_by_val)
+		pfree(DatumGetPointer(state->prev_value));
+	state->prev_value = (Datum) 0;
+}
+
+static void
+skip_scan_switch_stage(SkipScanState *state, SkipScanStage stage)
+{
+	ScanKey key = state->skip_key;
+
+	skip_scan_free_prev_value(state);
+
+	switch (stage)
+	{
+		case SS_NULLS_FIRST:
+		case SS_NULLS_LAST:
+			key->sk_flags = SK_ISNULL | SK_SEARCHNULL;
+			key->sk_argument = (Datum) 0;
+			break;
+		case SS_NOT_NULL:
+			key->sk_flags = SK_ISNULL | SK_SEARCHNOTNULL;
+			key->sk_argument = (Datum) 0;
+			break;
+		case SS_VALUES:
+			key->sk_flags = state->skip_key_flags;
+			break;
+		case SS_BEGIN:
+		case SS_END:
+			break;
+	}
+
+	state->stage = stage;
+	state->needs_rescan = true;
+}
+
+/*
+ * Remember the distinct value of the tuple we are about to return and set up
+ * the scan key so the next rescan starts at the following distinct value.
+ */
+static void
+skip_scan_update_key(SkipScanState *state, TupleTableSlot *slot)
+{
+	Datum value;
+	bool isnull;
+
+	value = slot_getattr(slot, state->distinct_attno, &isnull);
+
+	/* the scan key in these stages excludes NULLs */
+	Assert(!isnull);
+
+	if (state->stage != SS_VALUES)
+		skip_scan_switch_stage(state, SS_VALUES);
+	else
+		skip_scan_free_prev_value(state);
+
+	state->prev_value = datumCopy(value, state->distinct_by_val, state->distinct_typ_len);
+	state->skip_key->sk_argument = state->prev_value;
+	state->needs_rescan = true;
+}
+
+static void
+skip_scan_begin(CustomScanState *node, EState *estate, int eflags)
+{
+	SkipScanState *state = (SkipScanState *) node;
+	CustomScan *cscan = (CustomScan *) node->ss.ps.plan;
+	ScanKey keys = NULL;
+	int nkeys = 0;
+
+	state->child = ExecInitNode(linitial(cscan->custom_plans), estate, eflags);
+	node->custom_ps = list_make1(state->child);
+
+	/* Index scans do not set up their scan keys for EXPLAIN without ANALYZE */
+	if (eflags & EXEC_FLAG_EXPLAIN_ONLY)
+		return;
+
+	switch (nodeTag(state->child))
+	{
+		case T_IndexScanState:
+			keys = castNode(IndexScanState, state->child)->iss_ScanKeys;
+			nkeys = castNode(IndexScanState, state->child)->iss_NumScanKeys;
+			break;
+		case T_IndexOnlyScanState:
+			keys = castNode(IndexOnlyScanState, state->child)->ioss_ScanKeys;
+			nkeys = castNode(IndexOnlyScanState, state->child)->ioss_NumScanKeys;
+			break;
+		default:
+			elog(ERROR, "invalid child of skip scan: %u", nodeTag(state->child));
+			break;
+	}
+
+	/*
+	 * The skip qual is the first index qual and therefore the first scan
+	 * key, see skip_scan_plan_create.
+	 */
+	if (nkeys < 1 || keys[0].sk_attno != 1)
+		elog(ERROR, "skip scan key not found");
+
+	state->skip_key = &keys[0];
+	state->skip_key_flags = keys[0].sk_flags & ~SK_ISNULL;
+	state->stage = SS_BEGIN;
+	state->needs_rescan = true;
+}
+
+static TupleTableSlot *
+skip_scan_exec(CustomScanState *node)
+{
+	SkipScanState *state = (SkipScanState *) node;
+	ExprContext *econtext = node->ss.ps.ps_ExprContext;
+	TupleTableSlot *slot;
+#if PG96
+	TupleTableSlot *resultslot;
+	ExprDoneCond isDone;
+
+	if (node->ss.ps.ps_TupFromTlist)
+	{
+		resultslot = ExecProject(node->ss.ps.ps_ProjInfo, &isDone);
+
+		if (isDone == ExprMultipleResult)
+			return resultslot;
+
+		node->ss.ps.ps_TupFromTlist = false;
+	}
+#endif
+
+	ResetExprContext(econtext);
+
+	while (true)
+	{
+		if (state->stage == SS_BEGIN)
+			skip_scan_switch_stage(state, state->nulls_first ? SS_NULLS_FIRST : SS_NOT_NULL);
+
+		if (state->stage == SS_END)
+			return NULL;
+
+		if (state->needs_rescan)
+		{
+			ExecReScan(state->child);
+			state->needs_rescan = false;
+		}
+
+		slot = ExecProcNode(state->child);
+
+		if (TupIsNull(slot))
+		{
+			/* the current stage is exhausted so move on to the next one */
+			switch (state->stage)
+			{
+				case SS_NULLS_FIRST:
+					skip_scan_switch_stage(state, SS_NOT_NULL);
+					break;
+				case SS_NOT_NULL:
+				case SS_VALUES:
+					skip_scan_switch_stage(state, state->nulls_first ? SS_END : SS_NULLS_LAST);
+					break;
+				default:
+					skip_scan_switch_stage(state, SS_END);
+					break;
+			}
+			continue;
+		}
+
+		switch (state->stage)
+		{
+			case SS_NULLS_FIRST:
+				/* only one tuple is needed for the NULL group */
+				skip_scan_switch_stage(state, SS_NOT_NULL);
+				break;
+			case SS_NULLS_LAST:
+				skip_scan_switch_stage(state, SS_END);
+				break;
+			default:
+				skip_scan_update_key(state, slot);
+				break;
+		}
+
+		if (!node->ss.ps.ps_ProjInfo)
+			return slot;
+
+		econtext->ecxt_scantuple = slot;
+
+#if PG96
+		resultslot = ExecProject(node->ss.ps.ps_ProjInfo, &isDone);
+
+		if (isDone != ExprEndResult)
+		{
+			node->ss.ps.ps_TupFromTlist = (isDone == ExprMultipleResult);
+			return resultslot;
+		}
+#else
+		return ExecProject(node->ss.ps.ps_ProjInfo);
+#endif
+	}
+}
+
+static void
+skip_scan_end(CustomScanState *node)
+{
+	SkipScanState *state = (SkipScanState *) node;
+
+	ExecEndNode(state->child);
+}
+
+static void
+skip_scan_rescan(CustomScanState *node)
+{
+	SkipScanState *state = (SkipScanState *) node;
+
+#if PG96
+	node->ss.ps.ps_TupFromTlist = false;
+#endif
+	skip_scan_free_prev_value(state);
+	state->stage = SS_BEGIN;
+	state->needs_rescan = true;
+}
+
+static CustomExecMethods skip_scan_state_methods = {
+	.BeginCustomScan = skip_scan_begin,
+	.ExecCustomScan = skip_scan_exec,
+	.EndCustomScan = skip_scan_end,
+	.ReScanCustomScan = skip_scan_rescan,
+};
+
+static Node *
+skip_scan_state_create(CustomScan *cscan)
+{
+	SkipScanState *state;
+
+	state = (SkipScanState *) newNode(sizeof(SkipScanState), T_CustomScanState);
+	state->csstate.methods = &skip_scan_state_methods;
+	state->distinct_attno = linitial_int(cscan->custom_private);
+	state->distinct_by_val = lsecond_int(cscan->custom_private);
+	state->distinct_typ_len = lthird_int(cscan->custom_private);
+	state->nulls_first = lfourth_int(cscan->custom_private);
+
+	return (Node *) state;
+}
+
+static CustomScanMethods skip_scan_plan_methods = {
+	.CustomName = "SkipScan",
+	.CreateCustomScanState = skip_scan_state_create,
+};
+
+/*
+ * Build the qual used to skip to the next distinct value. The qual compares
+ * the leading index column against a NULL placeholder which gets replaced by
+ * the previous distinct value during execution.
+ */
+static Expr *
+skip_scan_build_qual(IndexOptInfo *index, ScanDirection dir, Var *distinct_var)
+{
+	bool increasing = ScanDirectionIsBackward(dir) == index->reverse_sort[0];
+	StrategyNumber strategy = increasing ? BTGreaterStrategyNumber : BTLessStrategyNumber;
+	Oid opno;
+	Var *var;
+	OpExpr *qual;
+
+	opno = get_opfamily_member(index->opfamily[0],
+							   index->opcintype[0],
+							   index->opcintype[0],
+							   strategy);
+
+	if (!OidIsValid(opno))
+		elog(ERROR,
+			 "missing operator %d(%u,%u) in opfamily %u",
+			 strategy,
+			 index->opcintype[0],
+			 index->opcintype[0],
+			 index->opfamily[0]);
+
+	/* index quals reference index columns instead of table columns */
+	var = makeVar(INDEX_VAR,
+				  1,
+				  distinct_var->vartype,
+				  distinct_var->vartypmod,
+				  distinct_var->varcollid,
+				  0);
+
+	qual = (OpExpr *) make_opclause(opno,
+									BOOLOID,
+									false,
+									(Expr *) var,
+									(Expr *) makeNullConst(index->opcintype[0],
+														   -1,
+														   index->indexcollations[0]),
+									InvalidOid,
+									index->indexcollations[0]);
+	qual->opfuncid = get_opcode(opno);
+
+	return (Expr *) qual;
+}
+
+static Plan *
+skip_scan_plan_create(PlannerInfo *root, RelOptInfo *rel, CustomPath *path, List *tlist,
+					  List *clauses, List *custom_plans)
+{
+	SkipScanPath *sspath = (SkipScanPath *) path;
+	IndexOptInfo *index = sspath->index_path->indexinfo;
+	CustomScan *cscan = makeNode(CustomScan);
+	Plan *plan = linitial(custom_plans);
+	Var *distinct_var = NULL;
+	AttrNumber distinct_attno = InvalidAttrNumber;
+	ScanDirection dir;
+	int16 typlen;
+	bool typbyval;
+	ListCell *lc;
+
+	/* find the distinct column in the output of the index scan */
+	foreach (lc, plan->targetlist)
+	{
+		TargetEntry *tle = lfirst(lc);
+
+		if (IsA(tle->expr, Var) && castNode(Var, tle->expr)->varno == rel->relid &&
+			castNode(Var, tle->expr)->varattno == index->indexkeys[0])
+		{
+			distinct_var = castNode(Var, tle->expr);
+			distinct_attno = tle->resno;
+			break;
+		}
+	}
+
+	if (distinct_var == NULL)
+		elog(ERROR, "skip scan column not found in index scan target list");
+
+	switch (nodeTag(plan))
+	{
+		case T_IndexScan:
+		{
+			IndexScan *scan = castNode(IndexScan, plan);
+
+			dir = scan->indexorderdir;
+			scan->indexqual = lcons(skip_scan_build_qual(index, dir, distinct_var), scan->indexqual);
+			break;
+		}
+		case T_IndexOnlyScan:
+		{
+			IndexOnlyScan *scan = castNode(IndexOnlyScan, plan);
+
+			dir = scan->indexorderdir;
+			scan->indexqual = lcons(skip_scan_build_qual(index, dir, distinct_var), scan->indexqual);
+			break;
+		}
+		default:
+			elog(ERROR, "invalid child of skip scan: %u", nodeTag(plan));
+			pg_unreachable();
+	}
+
+	get_typlenbyval(distinct_var->vartype, &typlen, &typbyval);
+
+	/*
+	 * The scan node keeps the chunk as its scan relation so that
+	 * ConstraintAwareAppend can still exclude it at execution time. All
+	 * restriction clauses are already checked by the index scan below us.
+	 */
+	cscan->scan.scanrelid = rel->relid;
+	cscan->scan.plan.targetlist = tlist;
+	cscan->custom_scan_tlist = plan->targetlist;
+	cscan->custom_plans = custom_plans;
+	cscan->custom_private = list_make4_int(distinct_attno,
+										   typbyval,
+										   typlen,
+										   index->nulls_first[0] != ScanDirectionIsBackward(dir));
+	cscan->flags = path->flags;
+	cscan->methods = &skip_scan_plan_methods;
+
+	return &cscan->scan.plan;
+}
+
+static CustomPathMethods skip_scan_path_methods = {
+	.CustomName = "SkipScan",
+	.PlanCustomPath = skip_scan_plan_create,
+};
+
+/*
+ * Check that the leading column of the index is the column the pathkey
+ * refers to.
+ */
+static bool
+skip_scan_pathkey_matches_index(PathKey *pathkey, IndexOptInfo *index)
+{
+	ListCell *lc;
+
+	foreach (lc, pathkey->pk_eclass->ec_members)
+	{
+		EquivalenceMember *em = lfirst(lc);
+		Expr *expr = em->em_expr;
+
+		while (IsA(expr, RelabelType))
+			expr = castNode(RelabelType, expr)->arg;
+
+		if (IsA(expr, Var) && castNode(Var, expr)->varno == index->rel->relid &&
+			castNode(Var, expr)->varattno == index->indexkeys[0] &&
+			castNode(Var, expr)->varlevelsup == 0)
+			return true;
+	}
+
+	return false;
+}
+
+static Path *
+skip_scan_path_create(PlannerInfo *root, IndexPath *index_path, PathKey *pathkey,
+					  double ndistinct)
+{
+	IndexOptInfo *index = index_path->indexinfo;
+	SkipScanPath *path;
+	ListCell *lc;
+
+	if (index->relam != BTREE_AM_OID || index->ncolumns < 1 || index->indexkeys[0] <= 0)
+		return NULL;
+
+	/* parallel index scans cannot be repositioned by a single worker */
+	if (index_path->path.parallel_aware)
+		return NULL;
+
+	if (index_path->path.pathkeys == NIL || linitial(index_path->path.pathkeys) != pathkey ||
+		!skip_scan_pathkey_matches_index(pathkey, index))
+		return NULL;
+
+	/* array keys make btree do its own repositioning so leave those alone */
+	foreach (lc, index_path->indexquals)
+	{
+		if (IsA(lfirst(lc), ScalarArrayOpExpr))
+			return NULL;
+	}
+
+	ndistinct = clamp_row_est(Min(ndistinct, index_path->path.rows));
+
+	path = (SkipScanPath *) newNode(sizeof(SkipScanPath), T_CustomPath);
+	path->cpath.path.pathtype = T_CustomScan;
+	path->cpath.path.parent = index_path->path.parent;
+	path->cpath.path.pathtarget = index_path->path.pathtarget;
+	path->cpath.path.param_info = index_path->path.param_info;
+	path->cpath.path.pathkeys = index_path->path.pathkeys;
+	path->cpath.path.parallel_aware = false;
+	path->cpath.path.parallel_safe = false;
+	path->cpath.path.parallel_workers = 0;
+	path->cpath.path.rows = ndistinct;
+
+	/*
+	 * Every distinct value costs one index descent, which is roughly the
+	 * startup cost of the index scan, plus fetching the tuple itself. If the
+	 * index scan is estimated to return a single row the chunk is most likely
+	 * going to be excluded so we do not penalize it further.
+	 */
+	path->cpath.path.startup_cost = index_path->path.startup_cost;
+	if (index_path->path.rows > 1)
+		path->cpath.path.total_cost =
+			ndistinct * index_path->path.startup_cost +
+			(ndistinct / index_path->path.rows) * index_path->path.total_cost;
+	else
+		path->cpath.path.total_cost = index_path->path.total_cost;
+
+	path->cpath.flags = 0;
+	path->cpath.custom_paths = list_make1(index_path);
+	path->cpath.methods = &skip_scan_path_methods;
+	path->index_path = index_path;
+
+	return &path->cpath.path;
+}
+
+/*
+ * Walk down the input of a Unique path and replace index scans on the
+ * distinct column with SkipScan paths. Returns NULL if no index scan could be
+ * replaced.
+ */
+static Path *
+skip_scan_replace_path(PlannerInfo *root, Path *path, PathKey *pathkey, double ndistinct)
+{
+	switch (nodeTag(path))
+	{
+		case T_IndexPath:
+			return skip_scan_path_create(root, castNode(IndexPath, path), pathkey, ndistinct);
+		case T_ProjectionPath:
+		{
+			ProjectionPath *proj = castNode(ProjectionPath, path);
+			Path *subpath = skip_scan_replace_path(root, proj->subpath, pathkey, ndistinct);
+
+			if (subpath == NULL)
+				return NULL;
+
+			return (Path *) create_projection_path(root, path->parent, subpath, path->pathtarget);
+		}
+		case T_MergeAppendPath:
+		{
+			MergeAppendPath *merge = castNode(MergeAppendPath, path);
+			List *subpaths = NIL;
+			bool replaced = false;
+			ListCell *lc;
+
+			foreach (lc, merge->subpaths)
+			{
+				Path *child = lfirst(lc);
+				Path *skip = skip_scan_replace_path(root, child, pathkey, ndistinct);
+
+				/* chunks without a matching index are scanned as before */
+				if (skip != NULL)
+				{
+					replaced = true;
+					child = skip;
+				}
+				subpaths = lappend(subpaths, child);
+			}
+
+			if (!replaced)
+				return NULL;
+
+#if PG96
+			return (Path *) create_merge_append_path(root,
+													 path->parent,
+													 subpaths,
+													 path->pathkeys,
+													 PATH_REQ_OUTER(path));
+#else
+			return (Path *) create_merge_append_path(root,
+													 path->parent,
+													 subpaths,
+													 path->pathkeys,
+													 PATH_REQ_OUTER(path),
+													 merge->partitioned_rels);
+#endif
+		}
+		case T_CustomPath:
+		{
+			RangeTblEntry *rte = planner_rt_fetch(path->parent->relid, root);
+			Path *subpath;
+			Cache *hcache;
+			Hypertable *ht;
+
+			if (!ts_is_constraint_aware_append_path(path))
+				return NULL;
+
+			subpath = skip_scan_replace_path(root,
+											 linitial(castNode(CustomPath, path)->custom_paths),
+											 pathkey,
+											 ndistinct);
+			if (subpath == NULL)
+				return NULL;
+
+			hcache = ts_hypertable_cache_pin();
+			ht = ts_hypertable_cache_get_entry(hcache, rte->relid);
+			path = ts_constraint_aware_append_path_create(root, ht, subpath);
+			ts_cache_release(hcache);
+
+			return path;
+		}
+		default:
+			return NULL;
+	}
+}
+
+/*
+ * Add DISTINCT paths that use SkipScan. Called from the create_upper_paths
+ * hook for the UPPERREL_DISTINCT stage after PostgreSQL has added its own
+ * paths. Only sort-based Unique paths on a single distinct column can make use
+ * of a SkipScan below them.
+ */
+void
+ts_skip_scan_add_paths(PlannerInfo *root, RelOptInfo *input_rel, RelOptInfo *output_rel)
+{
+	List *new_paths = NIL;
+	PathKey *pathkey;
+	ListCell *lc;
+
+	if (!ts_guc_enable_skip_scan || list_length(root->distinct_pathkeys) != 1)
+		return;
+
+	pathkey = linitial(root->distinct_pathkeys);
+
+	foreach (lc, output_rel->pathlist)
+	{
+		UpperUniquePath *unique;
+		Path *subpath;
+
+		if (!IsA(lfirst(lc), UpperUniquePath))
+			continue;
+
+		unique = castNode(UpperUniquePath, lfirst(lc));
+
+		if (unique->numkeys != 1)
+			continue;
+
+		subpath = skip_scan_replace_path(root, unique->subpath, pathkey, unique->path.rows);
+
+		if (subpath != NULL)
+			new_paths = lappend(new_paths,
+								create_upper_unique_path(root,
+														 output_rel,
+														 subpath,
+														 unique->numkeys,
+														 unique->path.rows));
+	}
+
+	foreach (lc, new_paths)
+		add_path(output_rel, lfirst(lc));
+}
+
+void
+_skip_scan_init(void)
+{
+	RegisterCustomScanMethods(&skip_scan_plan_methods);
+}
@@ -0,0 +1,23 @@
+/*
+ * This file and its contents are licensed under the Apache License 2.0.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-APACHE for a copy of the license.
+ */
+#ifndef TIMESCALEDB_SKIP_SCAN_H
+#define TIMESCALEDB_SKIP_SCAN_H
+
+#include <postgres.h>
+#include <nodes/relation.h>
+#include <nodes/extensible.h>
+
+typedef struct SkipScanPath
+{
+	CustomPath cpath;
+	IndexPath *index_path;
+} SkipScanPath;
+
+void ts_skip_scan_add_paths(PlannerInfo *root, RelOptInfo *input_rel, RelOptInfo *output_rel);
+
+void _skip_scan_init(void);
+
+#endif /* TIMESCALEDB_SKIP_SCAN_H */
@@ -0,0 +1,170 @@
+/*
+ * This file and its contents are licensed under the Apache License 2.0.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-APACHE for a copy of the license.
+ */
+#include <postgres.h>
+#include <fmgr.h>
+#include <funcapi.h>
+#include <miscadmin.h>
+#include <utils/builtins.h>
+#include <utils/lsyscache.h>
+#include <utils/tuplestore.h>
+
+#include "compat.h"
+#include "stats.h"
+
+TSDLLEXPORT Stats ts_stats;
+
+static const char *stats_counter_names[_STATS_MAX_COUNTERS] = {
+	[STATS_CHUNK_DISPATCH_HITS] = "chunk_dispatch_hits",
+	[STATS_CHUNK_DISPATCH_MISSES] = "chunk_dispatch_misses",
+	[STATS_SUBSPACE_STORE_EVICTIONS] = "subspace_store_evictions",
+	[STATS_CHUNKS_CREATED] = "chunks_created",
+	[STATS_CHUNKS_PLANNED] = "chunks_planned",
+	[STATS_CHUNKS_EXCLUDED_PLAN] = "chunks_excluded_plan",
+	[STATS_CHUNKS_EXCLUDED_EXEC] = "chunks_excluded_exec",
+};
+
+/* Counters that also track the time spent */
+static const bool stats_counter_timed[_STATS_MAX_COUNTERS] = {
+	[STATS_CHUNKS_CREATED] = true,
+};
+
+/*
+ * Count a scan of a (catalog) relation.
+ *
+ * The number of relations scanned through the scanner is small, so a linear
+ * search is cheaper than hashing.
+ */
+void
+ts_stats_count_scan(Oid relid)
+{
+	int i;
+
+	ts_stats.scans_total++;
+
+	for (i = 0; i < ts_stats.num_scan_relations; i++)
+	{
+		if (ts_stats.scans[i].relid == relid)
+		{
+			ts_stats.scans[i].count++;
+			return;
+		}
+	}
+
+	if (ts_stats.num_scan_relations >= STATS_MAX_SCAN_RELATIONS)
+	{
+		ts_stats.scans_other++;
+		return;
+	}
+
+	ts_stats.scans[ts_stats.num_scan_relations].relid = relid;
+	ts_stats.scans[ts_stats.num_scan_relations].count = 1;
+	ts_stats.num_scan_relations++;
+}
+
+enum Anum_stats
+{
+	Anum_stats_name = 1,
+	Anum_stats_calls,
+	Anum_stats_total_time,
+	_Anum_stats_max,
+};
+
+#define Natts_stats (_Anum_stats_max - 1)
+
+static void
+stats_put(Tuplestorestate *tupstore, TupleDesc tupdesc, const char *name, uint64 calls,
+		  instr_time *time)
+{
+	Datum values[Natts_stats];
+	bool nulls[Natts_stats] = { false };
+
+	values[AttrNumberGetAttrOffset(Anum_stats_name)] = CStringGetTextDatum(name);
+	values[AttrNumberGetAttrOffset(Anum_stats_calls)] = Int64GetDatum(calls);
+
+	if (time != NULL)
+		values[AttrNumberGetAttrOffset(Anum_stats_total_time)] =
+			Float8GetDatum(INSTR_TIME_GET_MILLISEC(*time));
+	else
+		nulls[AttrNumberGetAttrOffset(Anum_stats_total_time)] = true;
+
+	tuplestore_putvalues(tupstore, tupdesc, values, nulls);
+}
+
+TS_FUNCTION_INFO_V1(ts_stats_get);
+
+/*
+ * Return the counters of the current backend, one row per counter. Catalog
+ * scans are reported per relation as "catalog_scans.<relation>".
+ */
+Datum
+ts_stats_get(PG_FUNCTION_ARGS)
+{
+	ReturnSetInfo *rsinfo = (ReturnSetInfo *) fcinfo->resultinfo;
+	Tuplestorestate *tupstore;
+	TupleDesc tupdesc;
+	MemoryContext oldcontext;
+	int i;
+
+	if (rsinfo == NULL || !IsA(rsinfo, ReturnSetInfo))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("set-valued function called in context that cannot accept a set")));
+
+	if (!(rsinfo->allowedModes & SFRM_Materialize))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("materialize mode required, but it is not allowed in this context")));
+
+	if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
+		elog(ERROR, "return type must be a row type");
+
+	oldcontext = MemoryContextSwitchTo(rsinfo->econtext->ecxt_per_query_memory);
+	tupstore = tuplestore_begin_heap(true, false, work_mem);
+	rsinfo->returnMode = SFRM_Materialize;
+	rsinfo->setResult = tupstore;
+	rsinfo->setDesc = tupdesc;
+	MemoryContextSwitchTo(oldcontext);
+
+	for (i = 0; i < _STATS_MAX_COUNTERS; i++)
+		stats_put(tupstore,
+				  tupdesc,
+				  stats_counter_names[i],
+				  ts_stats.counters[i],
+				  stats_counter_timed[i] ? &ts_stats.times[i] : NULL);
+
+	for (i = 0; i < ts_stats.num_scan_relations; i++)
+	{
+		Oid relid = ts_stats.scans[i].relid;
+		char *relname = get_rel_name(relid);
+
+		/* The relation might have been dropped since it was scanned */
+		if (relname == NULL)
+			continue;
+
+		stats_put(tupstore,
+				  tupdesc,
+				  psprintf("catalog_scans.%s", relname),
+				  ts_stats.scans[i].count,
+				  NULL);
+	}
+
+	if (ts_stats.scans_other > 0)
+		stats_put(tupstore, tupdesc, "catalog_scans.other", ts_stats.scans_other, NULL);
+
+	tuplestore_donestoring(tupstore);
+
+	return (Datum) 0;
+}
+
+TS_FUNCTION_INFO_V1(ts_stats_reset);
+
+Datum
+ts_stats_reset(PG_FUNCTION_ARGS)
+{
+	MemSet(&ts_stats, 0, sizeof(ts_stats));
+
+	PG_RETURN_VOID();
+}
@@ -0,0 +1,78 @@
+/*
+ * This file and its contents are licensed under the Apache License 2.0.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-APACHE for a copy of the license.
+ */
+#ifndef TIMESCALEDB_STATS_H
+#define TIMESCALEDB_STATS_H
+
+#include <postgres.h>
+#include <portability/instr_time.h>
+
+#include "export.h"
+
+/*
+ * Per-backend counters for the hot paths of inserts and planning. They are
+ * plain increments so that they can stay enabled at all times, and are
+ * exposed through the timescaledb_information.stats view.
+ */
+typedef enum StatsCounter
+{
+	STATS_CHUNK_DISPATCH_HITS,
+	STATS_CHUNK_DISPATCH_MISSES,
+	STATS_SUBSPACE_STORE_EVICTIONS,
+	STATS_CHUNKS_CREATED,
+	STATS_CHUNKS_PLANNED,
+	STATS_CHUNKS_EXCLUDED_PLAN,
+	STATS_CHUNKS_EXCLUDED_EXEC,
+	_STATS_MAX_COUNTERS,
+} StatsCounter;
+
+/* Catalog scans are counted per relation, for up to this many relations */
+#define STATS_MAX_SCAN_RELATIONS 64
+
+typedef struct StatsScanCount
+{
+	Oid relid;
+	uint64 count;
+} StatsScanCount;
+
+typedef struct Stats
+{
+	uint64 counters[_STATS_MAX_COUNTERS];
+	/* Time spent in the counters that are timed, like chunk creation */
+	instr_time times[_STATS_MAX_COUNTERS];
+	int num_scan_relations;
+	StatsScanCount scans[STATS_MAX_SCAN_RELATIONS];
+	/* Scans of relations that did not fit in the array above */
+	uint64 scans_other;
+	uint64 scans_total;
+} Stats;
+
+extern TSDLLEXPORT Stats ts_stats;
+
+#define ts_stats_count(counter) (ts_stats.counters[(counter)]++)
+#define ts_stats_add(counter, n) (ts_stats.counters[(counter)] += (n))
+
+/*
+ * Time a counted operation:
+ *
+ *     instr_time start;
+ *
+ *     INSTR_TIME_SET_CURRENT(start);
+ *     ...
+ *     ts_stats_count_time(STATS_CHUNKS_CREATED, start);
+ */
+static inline void
+ts_stats_count_time(StatsCounter counter, instr_time start)
+{
+	instr_time end;
+
+	INSTR_TIME_SET_CURRENT(end);
+	INSTR_TIME_ACCUM_DIFF(ts_stats.times[counter], end, start);
+	ts_stats.counters[counter]++;
+}
+
+extern void ts_stats_count_scan(Oid relid);
+
+#endif /* TIMESCALEDB_STATS_H */
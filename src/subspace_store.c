@@ -10,6 +10,7 @@
 #include "dimension_slice.h"
 #include "dimension_vector.h"
 #include "hypercube.h"
+#include "stats.h"
 #include "subspace_store.h"
 
 /*
@@ -162,6 +163,8 @@ ts_subspace_store_add(SubspaceStore *store, const Hypercube *hc, void *object,
 			 * root.
 			 */
 			node->descendants -= items_removed;
+
+			ts_stats_add(STATS_SUBSPACE_STORE_EVICTIONS, items_removed);
 		}
 
 		match = ts_dimension_vec_find_slice(node->vector, target->fd.range_start);
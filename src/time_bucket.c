@@ -8,6 +8,7 @@
 #include <utils/datetime.h>
 #include <utils/date.h>
 #include <fmgr.h>
+#include <utils/memutils.h>
 
 #include "compat.h"
 
@@ -103,16 +104,13 @@ ts_int64_bucket(PG_FUNCTION_ARGS)
  * date_trunc.
  */
 #define DEFAULT_ORIGIN (JAN_3_2000)
-#define TIME_BUCKET_TS(period, timestamp, result, shift)                                           \
+/*
+ * Bucket a timestamp with a shift that has already been reduced modulo the
+ * period, i.e., abs(shift) < period.
+ */
+#define TIME_BUCKET_TS_SHIFTED(period, timestamp, result, shift)                                   \
 	do                                                                                             \
 	{                                                                                              \
-		if (period <= 0)                                                                           \
-			ereport(ERROR,                                                                         \
-					(errcode(ERRCODE_INVALID_PARAMETER_VALUE),                                     \
-					 errmsg("period must be greater then 0")));                                    \
-		/* shift = shift % period, but use TMODULO */                                              \
-		TMODULO(shift, result, period);                                                            \
-                                                                                                   \
 		if ((shift > 0 && timestamp < DT_NOBEGIN + shift) ||                                       \
 			(shift < 0 && timestamp > DT_NOEND + shift))                                           \
 			ereport(ERROR,                                                                         \
@@ -138,6 +136,18 @@ ts_int64_bucket(PG_FUNCTION_ARGS)
 		result += shift;                                                                           \
 	} while (0)
 
+#define TIME_BUCKET_TS(period, timestamp, result, shift)                                           \
+	do                                                                                             \
+	{                                                                                              \
+		if (period <= 0)                                                                           \
+			ereport(ERROR,                                                                         \
+					(errcode(ERRCODE_INVALID_PARAMETER_VALUE),                                     \
+					 errmsg("period must be greater then 0")));                                    \
+		/* shift = shift % period, but use TMODULO */                                              \
+		TMODULO(shift, result, period);                                                            \
+		TIME_BUCKET_TS_SHIFTED(period, timestamp, result, shift);                                  \
+	} while (0)
+
 /* Returns the period in the same representation as Postgres Timestamps.
  * (i.e. in microseconds if  HAVE_INT64_TIMESTAMP, seconds otherwise).
  * Note that this is not our internal representation (microseconds).
@@ -164,26 +174,79 @@ get_interval_period_timestamp_units(Interval *interval)
 #endif
 }
 
-TS_FUNCTION_INFO_V1(ts_timestamp_bucket);
+/*
+ * Bucket width and origin of a timestamp time_bucket call, with the origin
+ * reduced modulo the width.
+ */
+typedef struct TimestampBucketArgs
+{
+	int64 period;
+	Timestamp shift;
+} TimestampBucketArgs;
 
-Datum
-ts_timestamp_bucket(PG_FUNCTION_ARGS)
+/*
+ * Get the bucket width and origin of a timestamp time_bucket call.
+ *
+ * The width is almost always a constant so converting and validating the
+ * interval for every row is wasted work. When the width and origin are
+ * constant for the call site, they are computed on the first call and kept in
+ * fn_extra, leaving a single division per row.
+ */
+static void
+timestamp_bucket_get_args(FunctionCallInfo fcinfo, TimestampBucketArgs *args)
 {
-	Interval *interval = PG_GETARG_INTERVAL_P(0);
-	Timestamp timestamp = PG_GETARG_TIMESTAMP(1);
+	FmgrInfo *flinfo = fcinfo->flinfo;
+	Timestamp result;
+
+	if (flinfo != NULL && flinfo->fn_extra != NULL)
+	{
+		*args = *((TimestampBucketArgs *) flinfo->fn_extra);
+		return;
+	}
+
+	args->period = get_interval_period_timestamp_units(PG_GETARG_INTERVAL_P(0));
 
 	/*
 	 * USE NARGS and not IS_NULL to differentiate a NULL argument from a call
 	 * with 2 parameters
 	 */
-	Timestamp origin = (PG_NARGS() > 2 ? PG_GETARG_TIMESTAMP(2) : DEFAULT_ORIGIN);
+	args->shift = (PG_NARGS() > 2 ? PG_GETARG_TIMESTAMP(2) : DEFAULT_ORIGIN);
+
+	/* invalid periods are reported by the caller for finite timestamps */
+	if (args->period <= 0)
+		return;
+
+	/* shift = shift % period, but use TMODULO */
+	TMODULO(args->shift, result, args->period);
+
+	if (flinfo != NULL && get_fn_expr_arg_stable(flinfo, 0) &&
+		(PG_NARGS() <= 2 || get_fn_expr_arg_stable(flinfo, 2)))
+	{
+		flinfo->fn_extra = MemoryContextAlloc(flinfo->fn_mcxt, sizeof(TimestampBucketArgs));
+		*((TimestampBucketArgs *) flinfo->fn_extra) = *args;
+	}
+}
+
+TS_FUNCTION_INFO_V1(ts_timestamp_bucket);
+
+Datum
+ts_timestamp_bucket(PG_FUNCTION_ARGS)
+{
+	Timestamp timestamp = PG_GETARG_TIMESTAMP(1);
 	Timestamp result;
-	int64 period = get_interval_period_timestamp_units(interval);
+	TimestampBucketArgs args;
+
+	timestamp_bucket_get_args(fcinfo, &args);
 
 	if (TIMESTAMP_NOT_FINITE(timestamp))
 		PG_RETURN_TIMESTAMP(timestamp);
 
-	TIME_BUCKET_TS(period, timestamp, result, origin);
+	if (args.period <= 0)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("period must be greater then 0")));
+
+	TIME_BUCKET_TS_SHIFTED(args.period, timestamp, result, args.shift);
 
 	PG_RETURN_TIMESTAMP(result);
 }
@@ -193,21 +256,21 @@ TS_FUNCTION_INFO_V1(ts_timestamptz_bucket);
 Datum
 ts_timestamptz_bucket(PG_FUNCTION_ARGS)
 {
-	Interval *interval = PG_GETARG_INTERVAL_P(0);
 	TimestampTz timestamp = PG_GETARG_TIMESTAMPTZ(1);
-
-	/*
-	 * USE NARGS and not IS_NULL to differentiate a NULL argument from a call
-	 * with 2 parameters
-	 */
-	TimestampTz origin = (PG_NARGS() > 2 ? PG_GETARG_TIMESTAMPTZ(2) : DEFAULT_ORIGIN);
 	TimestampTz result;
-	int64 period = get_interval_period_timestamp_units(interval);
+	TimestampBucketArgs args;
+
+	timestamp_bucket_get_args(fcinfo, &args);
 
 	if (TIMESTAMP_NOT_FINITE(timestamp))
 		PG_RETURN_TIMESTAMPTZ(timestamp);
 
-	TIME_BUCKET_TS(period, timestamp, result, origin);
+	if (args.period <= 0)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("period must be greater then 0")));
+
+	TIME_BUCKET_TS_SHIFTED(args.period, timestamp, result, args.shift);
 
 	PG_RETURN_TIMESTAMPTZ(result);
 }
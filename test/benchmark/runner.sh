@@ -0,0 +1,64 @@
+#!/usr/bin/env bash
+
+# Run the benchmarks for each scale (number of chunks) and write the results
+# as JSON lines to ${BENCH_OUTPUT}. The benchmarks run in a fresh database per
+# scale on an existing PostgreSQL instance.
+
+set -u
+set -e
+
+CURRENT_DIR=$(dirname $0)
+PG_BINDIR=${PG_BINDIR:-}
+PSQL=${PSQL:-${PG_BINDIR:+${PG_BINDIR}/}psql}
+TEST_PGHOST=${TEST_PGHOST:-localhost}
+TEST_PGPORT=${TEST_PGPORT:-5432}
+TEST_ROLE_SUPERUSER=${TEST_ROLE_SUPERUSER:-super_user}
+BENCH_SCALES=${BENCH_SCALES:-1000 10000 100000}
+BENCH_OUTPUT=${BENCH_OUTPUT:-benchmark.json}
+BENCH_DBNAME=${BENCH_DBNAME:-benchmark}
+# Only run the benchmarks matching this pattern (e.g., "micro|query")
+BENCH_FILTER=${BENCH_FILTER:-.}
+
+# Read the extension version from version.config
+read -r VERSION < ${CURRENT_DIR}/../../version.config
+EXT_VERSION=${VERSION##version = }
+
+PSQL_OPTS="-X -q -v ON_ERROR_STOP=1 -h ${TEST_PGHOST} -p ${TEST_PGPORT} -U ${TEST_ROLE_SUPERUSER}"
+
+function cleanup {
+  ${PSQL} ${PSQL_OPTS} -d postgres -c "DROP DATABASE IF EXISTS \"${BENCH_DBNAME}\";" >/dev/null
+}
+
+trap cleanup EXIT
+
+: > ${BENCH_OUTPUT}
+
+for scale in ${BENCH_SCALES}; do
+  echo "Running benchmarks with ${scale} chunks"
+
+  cleanup
+  ${PSQL} ${PSQL_OPTS} -d postgres -c "CREATE DATABASE \"${BENCH_DBNAME}\";"
+  ${PSQL} ${PSQL_OPTS} -d ${BENCH_DBNAME} -c "SET client_min_messages=error; CREATE EXTENSION timescaledb;"
+
+  # Data file for COPY, written and read by the server
+  BENCH_DATA=$(mktemp -u /tmp/timescaledb_bench_XXXXXX).csv
+
+  for bench in functions setup micro ingest query; do
+    if [[ ${bench} != functions && ${bench} != setup && ! ${bench} =~ ${BENCH_FILTER} ]]; then
+      continue
+    fi
+
+    ${PSQL} ${PSQL_OPTS} -d ${BENCH_DBNAME} \
+      -v MODULE_PATHNAME="'timescaledb-${EXT_VERSION}'" \
+      -v SCALE=${scale} \
+      -v BENCH_DATA="'${BENCH_DATA}'" \
+      -f ${CURRENT_DIR}/sql/${bench}.sql >/dev/null
+  done
+  rm -f ${BENCH_DATA}
+
+  ${PSQL} ${PSQL_OPTS} -d ${BENCH_DBNAME} -At \
+    -c "SELECT row_to_json(r) FROM (SELECT ${scale} AS scale, * FROM bench_results ORDER BY id) r;" \
+    >> ${BENCH_OUTPUT}
+done
+
+echo "Benchmark results written to ${BENCH_OUTPUT}"
@@ -0,0 +1,56 @@
+#!/usr/bin/env bash
+
+# Grow a hypertable to each of the chunk counts in ${BENCH_SCALES} with
+# synthetic catalog entries and check that operations that touch a constant
+# number of chunks (planning, inserts, show_chunks and drop_chunks) do not
+# get more expensive than chunks^${SCALE_MAX_EXPONENT}. The measurements are
+# also written as JSON lines to ${BENCH_OUTPUT}.
+
+set -u
+set -e
+
+CURRENT_DIR=$(dirname $0)
+PG_BINDIR=${PG_BINDIR:-}
+PSQL=${PSQL:-${PG_BINDIR:+${PG_BINDIR}/}psql}
+TEST_PGHOST=${TEST_PGHOST:-localhost}
+TEST_PGPORT=${TEST_PGPORT:-5432}
+TEST_ROLE_SUPERUSER=${TEST_ROLE_SUPERUSER:-super_user}
+BENCH_SCALES=${BENCH_SCALES:-1000 10000 100000}
+BENCH_OUTPUT=${BENCH_OUTPUT:-scale.json}
+BENCH_DBNAME=${BENCH_DBNAME:-benchmark_scale}
+SCALE_MAX_EXPONENT=${SCALE_MAX_EXPONENT:-0.5}
+
+# Read the extension version from version.config
+read -r VERSION < ${CURRENT_DIR}/../../version.config
+EXT_VERSION=${VERSION##version = }
+
+PSQL_OPTS="-X -q -v ON_ERROR_STOP=1 -h ${TEST_PGHOST} -p ${TEST_PGPORT} -U ${TEST_ROLE_SUPERUSER}"
+
+function cleanup {
+  ${PSQL} ${PSQL_OPTS} -d postgres -c "DROP DATABASE IF EXISTS \"${BENCH_DBNAME}\";" >/dev/null
+}
+
+trap cleanup EXIT
+
+cleanup
+${PSQL} ${PSQL_OPTS} -d postgres -c "CREATE DATABASE \"${BENCH_DBNAME}\";"
+${PSQL} ${PSQL_OPTS} -d ${BENCH_DBNAME} -c "SET client_min_messages=error; CREATE EXTENSION timescaledb;"
+
+for sql in functions scale_setup; do
+  ${PSQL} ${PSQL_OPTS} -d ${BENCH_DBNAME} \
+    -v MODULE_PATHNAME="'timescaledb-${EXT_VERSION}'" \
+    -f ${CURRENT_DIR}/sql/${sql}.sql >/dev/null
+done
+
+for scale in ${BENCH_SCALES}; do
+  echo "Measuring with ${scale} chunks"
+  ${PSQL} ${PSQL_OPTS} -d ${BENCH_DBNAME} -v SCALE=${scale} \
+    -f ${CURRENT_DIR}/sql/scale_step.sql >/dev/null
+done
+
+${PSQL} ${PSQL_OPTS} -d ${BENCH_DBNAME} -At \
+  -c "SELECT row_to_json(r) FROM (SELECT * FROM scale_results ORDER BY name, scale) r;" \
+  > ${BENCH_OUTPUT}
+
+${PSQL} ${PSQL_OPTS} -d ${BENCH_DBNAME} -v MAX_EXPONENT=${SCALE_MAX_EXPONENT} \
+  -f ${CURRENT_DIR}/sql/scale_check.sql
@@ -0,0 +1,79 @@
+-- This file and its contents are licensed under the Apache License 2.0.
+-- Please see the included NOTICE for copyright information and
+-- LICENSE-APACHE for a copy of the license.
+
+-- Benchmark functions and the table that collects their results
+CREATE TYPE bench_result AS (
+    name text,
+    iterations bigint,
+    total_ms float8,
+    ops_per_sec float8,
+    p50_us float8,
+    p95_us float8,
+    p99_us float8,
+    max_us float8
+);
+
+CREATE TABLE bench_results(
+    id serial,
+    name text,
+    iterations bigint,
+    total_ms float8,
+    ops_per_sec float8,
+    p50_us float8,
+    p95_us float8,
+    p99_us float8,
+    max_us float8
+);
+
+CREATE FUNCTION bench_record(name text, r bench_result) RETURNS void LANGUAGE SQL AS
+$BODY$
+    INSERT INTO bench_results(name, iterations, total_ms, ops_per_sec, p50_us, p95_us, p99_us, max_us)
+    VALUES (name, (r).iterations, (r).total_ms, (r).ops_per_sec, (r).p50_us, (r).p95_us, (r).p99_us, (r).max_us);
+$BODY$;
+
+CREATE FUNCTION bench_calculate_point(hypertable regclass, sample text, iterations bigint)
+    RETURNS bench_result
+    AS :MODULE_PATHNAME, 'ts_bench_calculate_point' LANGUAGE C VOLATILE STRICT;
+
+CREATE FUNCTION bench_chunk_find(hypertable regclass, sample text, iterations bigint)
+    RETURNS bench_result
+    AS :MODULE_PATHNAME, 'ts_bench_chunk_find' LANGUAGE C VOLATILE STRICT;
+
+CREATE FUNCTION bench_subspace_store_get(hypertable regclass, sample text, iterations bigint, max_items int = 0)
+    RETURNS bench_result
+    AS :MODULE_PATHNAME, 'ts_bench_subspace_store_get' LANGUAGE C VOLATILE STRICT;
+
+CREATE FUNCTION bench_plan(query text, iterations bigint)
+    RETURNS bench_result
+    AS :MODULE_PATHNAME, 'ts_bench_plan' LANGUAGE C VOLATILE STRICT;
+
+-- Time each execution of a SQL statement
+CREATE FUNCTION bench_sql(name text, statement text, iterations int)
+RETURNS bench_result LANGUAGE plpgsql AS
+$BODY$
+DECLARE
+    latencies float8[] := '{}';
+    start timestamptz;
+    result bench_result;
+BEGIN
+    FOR i IN 1..iterations LOOP
+        start := clock_timestamp();
+        EXECUTE statement;
+        latencies := latencies || (extract(epoch FROM clock_timestamp() - start) * 1000000)::float8;
+    END LOOP;
+
+    SELECT name,
+           iterations,
+           sum(l) / 1000,
+           iterations / (sum(l) / 1000000),
+           percentile_cont(0.50) WITHIN GROUP (ORDER BY l),
+           percentile_cont(0.95) WITHIN GROUP (ORDER BY l),
+           percentile_cont(0.99) WITHIN GROUP (ORDER BY l),
+           max(l)
+    INTO result
+    FROM unnest(latencies) l;
+
+    RETURN result;
+END
+$BODY$;
@@ -0,0 +1,27 @@
+-- This file and its contents are licensed under the Apache License 2.0.
+-- Please see the included NOTICE for copyright information and
+-- LICENSE-APACHE for a copy of the license.
+
+-- Ingest into the most recent chunks of the hypertable, with COPY and with
+-- INSERT, and ingest that creates new chunks
+SET timezone TO 'UTC';
+
+SELECT max(time) - interval '10 hours' AS ingest_start FROM bench
+\gset
+
+COPY (SELECT :'ingest_start'::timestamptz + i * interval '360 ms', i % 100, random()
+      FROM generate_series(0, 99999) i) TO :BENCH_DATA WITH (FORMAT csv);
+
+SELECT bench_record('copy_100k_rows',
+    bench_sql('copy_100k_rows', format('COPY bench FROM %L WITH (FORMAT csv)', :BENCH_DATA), 10));
+
+SELECT bench_record('insert_1k_rows',
+    bench_sql('insert_1k_rows',
+              format($$INSERT INTO bench SELECT %L::timestamptz + i * interval '36 s', i %% 100, random() FROM generate_series(0, 999) i$$,
+                     :'ingest_start'),
+              100));
+
+SELECT bench_record('insert_new_chunk',
+    bench_sql('insert_new_chunk',
+              $$INSERT INTO bench VALUES ('2000-01-01'::timestamptz + nextval('bench_new_chunk') * interval '1 hour', 1, 0)$$,
+              100));
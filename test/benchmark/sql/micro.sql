@@ -0,0 +1,15 @@
+-- This file and its contents are licensed under the Apache License 2.0.
+-- Please see the included NOTICE for copyright information and
+-- LICENSE-APACHE for a copy of the license.
+
+-- C-level benchmarks of the functions on the insert path
+SET timezone TO 'UTC';
+
+SELECT bench_record('calculate_point',
+    bench_calculate_point('bench', 'SELECT * FROM bench_sample', 1000000));
+SELECT bench_record('subspace_store_get',
+    bench_subspace_store_get('bench', 'SELECT * FROM bench_sample', 1000000));
+SELECT bench_record('subspace_store_get_evicting',
+    bench_subspace_store_get('bench', 'SELECT * FROM bench_sample', 100000, 10));
+SELECT bench_record('chunk_find',
+    bench_chunk_find('bench', 'SELECT * FROM bench_sample', 10000));
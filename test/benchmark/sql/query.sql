@@ -0,0 +1,23 @@
+-- This file and its contents are licensed under the Apache License 2.0.
+-- Please see the included NOTICE for copyright information and
+-- LICENSE-APACHE for a copy of the license.
+
+-- Planning and execution of queries with time predicates of constant width,
+-- at the start and at the end of the hypertable
+SET timezone TO 'UTC';
+
+SELECT '2000-01-01'::timestamptz + (:SCALE - 1) * interval '1 hour' AS last_chunk_start,
+       '2000-01-01'::timestamptz + :SCALE * interval '1 hour' AS last_chunk_end
+\gset
+
+SELECT bench_record('plan_first_chunk',
+    bench_plan($$SELECT * FROM bench WHERE time >= '2000-01-01 00:00' AND time < '2000-01-01 01:00'$$, 1000));
+SELECT bench_record('plan_last_chunk',
+    bench_plan(format($$SELECT * FROM bench WHERE time >= %L AND time < %L$$, :'last_chunk_start', :'last_chunk_end'), 1000));
+SELECT bench_record('plan_ten_chunks',
+    bench_plan($$SELECT * FROM bench WHERE time >= '2000-01-01 00:00' AND time < '2000-01-01 10:00'$$, 1000));
+
+SELECT bench_record('select_last_chunk',
+    bench_sql('select_last_chunk', format($$SELECT count(*) FROM bench WHERE time >= %L AND time < %L$$, :'last_chunk_start', :'last_chunk_end'), 1000));
+SELECT bench_record('select_ten_chunks',
+    bench_sql('select_ten_chunks', $$SELECT count(*) FROM bench WHERE time >= '2000-01-01 00:00' AND time < '2000-01-01 10:00'$$, 1000));
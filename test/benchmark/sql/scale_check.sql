@@ -0,0 +1,41 @@
+-- This file and its contents are licensed under the Apache License 2.0.
+-- Please see the included NOTICE for copyright information and
+-- LICENSE-APACHE for a copy of the license.
+
+-- Check that the cost of the measured operations grows sub-linearly with
+-- the number of chunks. The growth is expressed as the exponent k in
+-- time ~ chunks^k between the smallest and the largest scale, computed from
+-- the median latencies. A linear algorithm has k = 1.
+CREATE VIEW scale_growth AS
+SELECT lo.name,
+       lo.scale AS min_scale,
+       hi.scale AS max_scale,
+       lo.p50_us AS min_scale_p50_us,
+       hi.p50_us AS max_scale_p50_us,
+       round((ln(hi.p50_us / lo.p50_us) / ln(hi.scale::float8 / lo.scale))::numeric, 2) AS exponent
+FROM scale_results lo
+INNER JOIN scale_results hi ON (hi.name = lo.name)
+WHERE lo.scale = (SELECT min(scale) FROM scale_results)
+AND hi.scale = (SELECT max(scale) FROM scale_results)
+AND hi.scale > lo.scale;
+
+\pset footer off
+SELECT * FROM scale_growth ORDER BY name;
+
+SET scale.max_exponent = :'MAX_EXPONENT';
+
+DO $BODY$
+DECLARE
+    violations text;
+BEGIN
+    SELECT string_agg(format('%s (%s)', name, exponent), ', ' ORDER BY name)
+    INTO violations
+    FROM scale_growth
+    WHERE exponent > current_setting('scale.max_exponent')::numeric;
+
+    IF violations IS NOT NULL THEN
+        RAISE EXCEPTION 'operations grow faster than chunks^%: %',
+              current_setting('scale.max_exponent'), violations;
+    END IF;
+END
+$BODY$;
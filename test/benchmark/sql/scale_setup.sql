@@ -0,0 +1,73 @@
+-- This file and its contents are licensed under the Apache License 2.0.
+-- Please see the included NOTICE for copyright information and
+-- LICENSE-APACHE for a copy of the license.
+
+-- Hypertable for the scale tests. It has a few real chunks at both ends of
+-- its time range, which the measured operations touch, while synthetic
+-- catalog entries (without tables) make up the bulk of the chunks in
+-- between. This makes it cheap to grow the catalog to hundreds of thousands
+-- of chunks and exercises exactly the cost of the catalog lookups.
+SET timezone TO 'UTC';
+
+CREATE TABLE scale(time timestamptz NOT NULL, device int NOT NULL, value float8);
+SELECT create_hypertable('scale', 'time', chunk_time_interval => interval '1 hour');
+
+-- Chunks that are dropped one at a time, hours -100 to -71
+INSERT INTO scale
+SELECT '2000-01-01'::timestamptz + h * interval '1 hour', 1, 0 FROM generate_series(-100, -71) h;
+-- Head window, hours 0 to 4
+INSERT INTO scale
+SELECT '2000-01-01'::timestamptz + h * interval '1 hour', 1, 0 FROM generate_series(0, 4) h;
+-- Tail window, which is where inserts and queries typically go, hours
+-- 1000000 to 1000004. The synthetic chunks start at hour 10.
+INSERT INTO scale
+SELECT '2000-01-01'::timestamptz + h * interval '1 hour', 1, 0 FROM generate_series(1000000, 1000004) h;
+
+CREATE SEQUENCE scale_drop START -99 MINVALUE -100;
+
+CREATE TABLE scale_results(scale int, name text, p50_us float8, p95_us float8);
+
+-- Add synthetic chunks until the hypertable has num_chunks chunks
+CREATE FUNCTION scale_add_synthetic_chunks(hypertable regclass, num_chunks int)
+RETURNS int LANGUAGE plpgsql AS
+$BODY$
+DECLARE
+    ht_id int;
+    dim_id int;
+    slice_length bigint;
+    num_existing int;
+    num_synthetic int;
+BEGIN
+    SELECT h.id, d.id, d.interval_length INTO ht_id, dim_id, slice_length
+    FROM _timescaledb_catalog.hypertable h
+    INNER JOIN _timescaledb_catalog.dimension d ON (d.hypertable_id = h.id)
+    WHERE format('%I.%I', h.schema_name, h.table_name)::regclass = hypertable;
+
+    SELECT count(*), count(*) FILTER (WHERE table_name LIKE '\_synthetic\_%')
+    INTO num_existing, num_synthetic
+    FROM _timescaledb_catalog.chunk
+    WHERE hypertable_id = ht_id;
+
+    WITH slices AS (
+        INSERT INTO _timescaledb_catalog.dimension_slice(dimension_id, range_start, range_end)
+        SELECT dim_id, (10 + i) * slice_length, (11 + i) * slice_length
+        FROM generate_series(num_synthetic, num_synthetic + num_chunks - num_existing - 1) i
+        RETURNING id
+    ), chunks AS (
+        INSERT INTO _timescaledb_catalog.chunk(hypertable_id, schema_name, table_name)
+        SELECT ht_id, '_timescaledb_internal', format('_synthetic_%s_chunk', id)
+        FROM slices
+        RETURNING id, table_name
+    )
+    INSERT INTO _timescaledb_catalog.chunk_constraint(chunk_id, dimension_slice_id, constraint_name, hypertable_constraint_name)
+    SELECT id, split_part(table_name, '_', 3)::int, format('constraint_%s', split_part(table_name, '_', 3)), NULL
+    FROM chunks;
+
+    RETURN greatest(num_chunks - num_existing, 0);
+END
+$BODY$;
+
+CREATE FUNCTION scale_record(scale int, name text, r bench_result) RETURNS void LANGUAGE SQL AS
+$BODY$
+    INSERT INTO scale_results VALUES (scale, name, (r).p50_us, (r).p95_us);
+$BODY$;
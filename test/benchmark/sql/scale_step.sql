@@ -0,0 +1,26 @@
+-- This file and its contents are licensed under the Apache License 2.0.
+-- Please see the included NOTICE for copyright information and
+-- LICENSE-APACHE for a copy of the license.
+
+-- Grow the hypertable to :SCALE chunks and measure operations that only
+-- touch a constant number of chunks
+SET timezone TO 'UTC';
+
+SELECT scale_add_synthetic_chunks('scale', :SCALE);
+VACUUM ANALYZE _timescaledb_catalog.dimension_slice, _timescaledb_catalog.chunk, _timescaledb_catalog.chunk_constraint;
+
+-- The tail window is hour 1000000, which starts at 2114-01-29 16:00
+SELECT scale_record(:SCALE, 'plan_head_window',
+    bench_plan($$SELECT * FROM scale WHERE time >= '2000-01-01 00:00' AND time < '2000-01-01 01:00'$$, 200));
+SELECT scale_record(:SCALE, 'plan_tail_window',
+    bench_plan($$SELECT * FROM scale WHERE time >= '2114-01-29 16:00' AND time < '2114-01-29 17:00'$$, 200));
+SELECT scale_record(:SCALE, 'insert_tail',
+    bench_sql('insert_tail', $$INSERT INTO scale VALUES ('2114-01-29 16:30', 1, 0)$$, 200));
+SELECT scale_record(:SCALE, 'show_chunks_tail_window',
+    bench_sql('show_chunks_tail_window',
+              $$SELECT count(*) FROM show_chunks('scale', newer_than => '2114-01-29 16:00'::timestamptz, older_than => '2114-01-29 21:00'::timestamptz)$$,
+              200));
+SELECT scale_record(:SCALE, 'drop_chunks_oldest',
+    bench_sql('drop_chunks_oldest',
+              $$SELECT drop_chunks(older_than => '2000-01-01'::timestamptz + nextval('scale_drop') * interval '1 hour', table_name => 'scale')$$,
+              5));
@@ -0,0 +1,32 @@
+-- This file and its contents are licensed under the Apache License 2.0.
+-- Please see the included NOTICE for copyright information and
+-- LICENSE-APACHE for a copy of the license.
+
+-- The hypertable that the benchmarks run on, with :SCALE chunks of one hour
+-- each
+SET timezone TO 'UTC';
+
+CREATE TABLE bench(time timestamptz NOT NULL, device int NOT NULL, value float8);
+SELECT create_hypertable('bench', 'time', chunk_time_interval => interval '1 hour');
+
+-- Create the chunks in batches to stay within max_locks_per_transaction
+SELECT format($$INSERT INTO bench SELECT t, 1, 0 FROM generate_series(%L::timestamptz, %L::timestamptz, '1 hour') t$$,
+              '2000-01-01'::timestamptz + b * interval '1 hour',
+              '2000-01-01'::timestamptz + least(b + 999, :SCALE - 1) * interval '1 hour')
+FROM generate_series(0, :SCALE - 1, 1000) b
+\gexec
+
+-- Tuples spread over all the chunks, for the routing benchmarks. The sample
+-- is drawn once with a fixed seed, so that every benchmark and every run
+-- routes the same tuples in the same order.
+SELECT setseed(0);
+CREATE TABLE bench_sample AS
+SELECT t AS time, (random() * 100)::int AS device, random() AS value
+FROM generate_series('2000-01-01'::timestamptz, '2000-01-01'::timestamptz + (:SCALE - 1) * interval '1 hour', interval '1 hour') t
+ORDER BY random()
+LIMIT 1000;
+
+-- Chunks created by the ingest benchmarks come after the existing ones
+CREATE SEQUENCE bench_new_chunk START :SCALE;
+
+VACUUM ANALYZE;
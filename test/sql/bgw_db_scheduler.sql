@@ -543,3 +543,102 @@ SELECT * FROM sorted_bgw_log;
 select * from _timescaledb_internal.bgw_job_stat;
 
 SELECT * FROM insert_job(NULL,NULL,NULL,NULL,NULL,NULL);
+
+--
+-- Test persistent job runners
+--
+\c :TEST_DBNAME :ROLE_SUPERUSER
+ALTER SYSTEM SET timescaledb.bgw_job_runners TO 1;
+SELECT pg_reload_conf();
+SELECT pg_sleep(0.001);
+SHOW timescaledb.bgw_job_runners;
+
+TRUNCATE bgw_log;
+TRUNCATE _timescaledb_internal.bgw_job_stat;
+SELECT ts_bgw_params_reset_time();
+DELETE FROM _timescaledb_config.bgw_job;
+INSERT INTO _timescaledb_config.bgw_job (application_name, job_type, schedule_INTERVAL, max_runtime, max_retries, retry_period) VALUES
+('test_runner_job', 'bgw_test_job_1', INTERVAL '100ms', INTERVAL '100s', 3, INTERVAL '1s');
+
+--A job runner does not exit when its job is done, so the mock timer cannot
+--wait on it. Advance the time by hand instead.
+SELECT ts_bgw_params_mock_wait_returns_immediately(:WAIT_FOR_OTHER_TO_ADVANCE);
+
+--The job is dispatched to a new runner, which stays alive after the job
+SELECT ts_bgw_db_scheduler_test_run(500);
+SELECT wait_for_job_1_to_run(1);
+SELECT wait_application_pid('TimescaleDB Job Runner') AS runner_pid \gset
+
+--The next run is dispatched to the same runner. Its log messages continue
+--the numbering of the first run instead of starting over at 0.
+SELECT ts_bgw_params_reset_time(100000, true);
+SELECT wait_for_job_1_to_run(2);
+SELECT wait_application_pid('TimescaleDB Job Runner') = :runner_pid AS same_runner;
+
+--The runners exit with the scheduler
+SELECT ts_bgw_params_reset_time(500000, true);
+SELECT ts_bgw_db_scheduler_test_wait_for_scheduler_finish();
+SELECT count(*) FROM pg_stat_activity WHERE application_name = 'TimescaleDB Job Runner';
+
+SELECT * FROM sorted_bgw_log;
+SELECT job_id, last_run_success, total_runs, total_successes, total_failures, total_crashes
+FROM _timescaledb_internal.bgw_job_stat;
+
+--A runner whose job exceeds its max_runtime is terminated and not put back
+--into the pool
+TRUNCATE bgw_log;
+TRUNCATE _timescaledb_internal.bgw_job_stat;
+SELECT ts_bgw_params_reset_time();
+DELETE FROM _timescaledb_config.bgw_job;
+INSERT INTO _timescaledb_config.bgw_job (application_name, job_type, schedule_INTERVAL, max_runtime, max_retries, retry_period) VALUES
+('test_job_3_long', 'bgw_test_job_3_long', INTERVAL '5000ms', INTERVAL '20ms', 3, INTERVAL '50ms');
+
+SELECT ts_bgw_params_mock_wait_returns_immediately(:IMMEDIATELY_SET_UNTIL);
+SELECT ts_bgw_db_scheduler_test_run_and_wait_for_scheduler_finish(200);
+SELECT job_id, last_finish, next_start, last_run_success, total_runs, total_successes, total_failures, total_crashes, consecutive_crashes
+FROM _timescaledb_internal.bgw_job_stat;
+SELECT * FROM sorted_bgw_log;
+SELECT count(*) FROM pg_stat_activity WHERE application_name IN ('TimescaleDB Job Runner', 'test_job_3_long');
+
+SELECT ts_bgw_params_mock_wait_returns_immediately(:WAIT_ON_JOB);
+ALTER SYSTEM RESET timescaledb.bgw_job_runners;
+SELECT pg_reload_conf();
+SELECT pg_sleep(0.001);
+SHOW timescaledb.bgw_job_runners;
+
+--
+-- Test job class limits
+--
+\c :TEST_DBNAME :ROLE_SUPERUSER
+ALTER SYSTEM SET timescaledb.bgw_reorder_max_concurrency TO 1;
+SELECT pg_reload_conf();
+SELECT pg_sleep(0.001);
+SHOW timescaledb.bgw_reorder_max_concurrency;
+
+TRUNCATE bgw_log;
+TRUNCATE _timescaledb_internal.bgw_job_stat;
+SELECT ts_bgw_params_reset_time();
+DELETE FROM _timescaledb_config.bgw_job;
+--Jobs get the class of their job type. There are no policies for these jobs,
+--so they fail, but that does not change when they are started.
+INSERT INTO _timescaledb_config.bgw_job (application_name, job_type, schedule_INTERVAL, max_runtime, max_retries, retry_period) VALUES
+('test_reorder_1', 'reorder', INTERVAL '1h', INTERVAL '100s', 3, INTERVAL '1h'),
+('test_reorder_2', 'reorder', INTERVAL '1h', INTERVAL '100s', 3, INTERVAL '1h'),
+('test_drop_chunks', 'drop_chunks', INTERVAL '1h', INTERVAL '100s', 3, INTERVAL '1h');
+
+--All jobs are due, but only one reorder job may run at a time. The second
+--reorder job waits, and does not hold back the drop_chunks job.
+SELECT ts_bgw_db_scheduler_test_run_and_wait_for_scheduler_finish(50);
+SELECT job_id, last_start, total_runs
+FROM _timescaledb_internal.bgw_job_stat ORDER BY job_id;
+
+--The waiting reorder job starts once no other reorder job runs
+SELECT ts_bgw_db_scheduler_test_run_and_wait_for_scheduler_finish(50);
+SELECT job_id, last_start, total_runs
+FROM _timescaledb_internal.bgw_job_stat ORDER BY job_id;
+SELECT * FROM sorted_bgw_log;
+
+ALTER SYSTEM RESET timescaledb.bgw_reorder_max_concurrency;
+SELECT pg_reload_conf();
+SELECT pg_sleep(0.001);
+SHOW timescaledb.bgw_reorder_max_concurrency;
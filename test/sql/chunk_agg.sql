@@ -0,0 +1,56 @@
+-- This file and its contents are licensed under the Apache License 2.0.
+-- Please see the included NOTICE for copyright information and
+-- LICENSE-APACHE for a copy of the license.
+
+\set PREFIX 'EXPLAIN (costs off) '
+
+CREATE TABLE chunk_agg(time int NOT NULL, dev int, val int);
+SELECT create_hypertable('chunk_agg', 'time', chunk_time_interval => 100);
+
+INSERT INTO chunk_agg SELECT t, d, t * d FROM generate_series(0, 299) t, generate_series(1, 3) d;
+ANALYZE chunk_agg;
+
+SET timescaledb.enable_chunkwise_aggregation TO true;
+
+-- buckets never cross chunk boundaries, chunks are aggregated fully
+SELECT time_bucket(50, time) AS bucket, count(*), sum(val) FROM chunk_agg GROUP BY bucket ORDER BY bucket;
+
+-- groups span all chunks, chunks are aggregated partially
+SELECT dev, count(*), min(val), max(val), sum(val) FROM chunk_agg GROUP BY dev ORDER BY dev;
+
+-- buckets crossing chunk boundaries with a HAVING clause
+SELECT time_bucket(30, time) AS bucket, dev, sum(val) FROM chunk_agg GROUP BY bucket, dev HAVING sum(val) > 20000 ORDER BY bucket, dev;
+
+-- with space partitioning a bucket is split over all chunks in the same time
+-- slice, so chunks are only aggregated fully when grouping by the space column
+CREATE TABLE chunk_agg_space(time int NOT NULL, dev int, val int);
+SELECT create_hypertable('chunk_agg_space', 'time', 'dev', 2, chunk_time_interval => 100);
+INSERT INTO chunk_agg_space SELECT t, d, t * d FROM generate_series(0, 299) t, generate_series(1, 4) d ORDER BY t, d;
+ANALYZE chunk_agg_space;
+
+:PREFIX SELECT time_bucket(100, time) AS bucket, count(*), sum(val) FROM chunk_agg_space GROUP BY bucket ORDER BY bucket;
+SELECT time_bucket(100, time) AS bucket, count(*), sum(val) FROM chunk_agg_space GROUP BY bucket ORDER BY bucket;
+
+:PREFIX SELECT time_bucket(100, time) AS bucket, dev, count(*), sum(val) FROM chunk_agg_space GROUP BY bucket, dev ORDER BY bucket, dev;
+SELECT time_bucket(100, time) AS bucket, dev, count(*), sum(val) FROM chunk_agg_space GROUP BY bucket, dev ORDER BY bucket, dev;
+
+-- when the partial groups of all chunks do not fit in work_mem, they are
+-- sorted and combined with a GroupAggregate, unless the grouping type cannot
+-- be sorted, like xid
+CREATE TABLE chunk_agg_groups(time int NOT NULL, dev int, xdev xid, val int);
+SELECT create_hypertable('chunk_agg_groups', 'time', chunk_time_interval => 100);
+INSERT INTO chunk_agg_groups SELECT t, d, d::text::xid, t FROM generate_series(0, 299) t, generate_series(1, 180) d;
+ANALYZE chunk_agg_groups;
+SET work_mem TO '64kB';
+
+:PREFIX SELECT dev, avg(val), avg(val * 2), avg(val * 3), avg(val * 4) FROM chunk_agg_groups GROUP BY dev;
+SELECT count(*), count(DISTINCT dev), round(sum(a)) AS total FROM (SELECT dev, avg(val) AS a, avg(val * 2), avg(val * 3), avg(val * 4) FROM chunk_agg_groups GROUP BY dev) g;
+
+:PREFIX SELECT xdev, avg(val), avg(val * 2), avg(val * 3), avg(val * 4) FROM chunk_agg_groups GROUP BY xdev;
+SELECT count(*), count(DISTINCT xdev::text), round(sum(a)) AS total FROM (SELECT xdev, avg(val) AS a, avg(val * 2), avg(val * 3), avg(val * 4) FROM chunk_agg_groups GROUP BY xdev) g;
+RESET work_mem;
+
+-- results must not change with chunk-wise aggregation disabled
+RESET timescaledb.enable_chunkwise_aggregation;
+SELECT time_bucket(50, time) AS bucket, count(*), sum(val) FROM chunk_agg GROUP BY bucket ORDER BY bucket;
+SELECT time_bucket(100, time) AS bucket, count(*), sum(val) FROM chunk_agg_space GROUP BY bucket ORDER BY bucket;
@@ -0,0 +1,118 @@
+-- This file and its contents are licensed under the Apache License 2.0.
+-- Please see the included NOTICE for copyright information and
+-- LICENSE-APACHE for a copy of the license.
+
+CREATE TABLE chunk_stats_test(time timestamptz NOT NULL, device int, temp float);
+SELECT create_hypertable('chunk_stats_test', 'time', chunk_time_interval => INTERVAL '1 day');
+CREATE VIEW chunk_stats AS
+SELECT c.table_name,
+       _timescaledb_internal.to_timestamp(s.min_time) AS min_time,
+       _timescaledb_internal.to_timestamp(s.max_time) AS max_time,
+       s.row_count,
+       s.total_bytes > 0 AS has_size
+FROM _timescaledb_catalog.chunk_statistics s
+INNER JOIN _timescaledb_catalog.chunk c ON (c.id = s.chunk_id)
+ORDER BY c.id;
+
+INSERT INTO chunk_stats_test VALUES
+    ('2018-01-01 01:00', 1, 1.0),
+    ('2018-01-01 02:00', 1, 2.0),
+    ('2018-01-02 01:00', 1, 3.0);
+
+-- new chunks start with a padded time range around the first row
+SELECT * FROM chunk_stats;
+
+-- statistics are collected by ANALYZE
+ANALYZE chunk_stats_test;
+SELECT * FROM chunk_stats;
+
+-- the modification time only changes when the statistics change
+CREATE TABLE chunk_stats_before AS SELECT * FROM _timescaledb_catalog.chunk_statistics;
+INSERT INTO chunk_stats_test VALUES ('2017-12-31 23:00', 1, 4.0);
+ANALYZE chunk_stats_test;
+SELECT c.table_name,
+       s.last_modified = b.last_modified AS same_modified,
+       s.last_updated > b.last_updated AS updated
+FROM _timescaledb_catalog.chunk_statistics s
+INNER JOIN chunk_stats_before b ON (b.chunk_id = s.chunk_id)
+INNER JOIN _timescaledb_catalog.chunk c ON (c.id = s.chunk_id)
+ORDER BY c.id;
+SELECT * FROM chunk_stats;
+
+-- deleted rows stay within the time range until vacuumed
+DELETE FROM chunk_stats_test WHERE time > '2018-01-02';
+ANALYZE chunk_stats_test;
+SELECT * FROM chunk_stats;
+
+-- statistics are removed with the chunk
+SELECT drop_chunks(older_than => '2018-01-02'::timestamptz, table_name => 'chunk_stats_test');
+SELECT * FROM chunk_stats;
+DROP TABLE chunk_stats_test;
+SELECT count(*) FROM _timescaledb_catalog.chunk_statistics;
+
+-- the time ranges can exclude chunks whose slice matches the query
+\ir include/scanned_chunks.sql
+CREATE TABLE sparse(time timestamptz NOT NULL, value float);
+SELECT create_hypertable('sparse', 'time', chunk_time_interval => INTERVAL '7 days');
+INSERT INTO sparse VALUES
+    ('2018-01-01 00:00', 1.0),
+    ('2018-01-01 01:00', 2.0),
+    ('2018-01-10 00:00', 3.0);
+ANALYZE sparse;
+SELECT * FROM chunk_stats;
+SELECT * FROM scanned_chunks($$SELECT * FROM sparse WHERE time > '2018-01-03'$$);
+SET timescaledb.enable_chunk_time_range_exclusion TO on;
+SELECT * FROM scanned_chunks($$SELECT * FROM sparse WHERE time > '2018-01-03'$$);
+SELECT * FROM scanned_chunks($$SELECT * FROM sparse WHERE time > '2018-01-03' ORDER BY time LIMIT 1$$);
+SELECT * FROM scanned_chunks($$SELECT * FROM sparse WHERE time < '2017-12-31'$$);
+
+-- inserts extend the time range, but not beyond the slice
+INSERT INTO sparse VALUES ('2018-01-03 12:00', 4.0);
+SELECT * FROM chunk_stats;
+SELECT * FROM scanned_chunks($$SELECT * FROM sparse WHERE time > '2018-01-03'$$);
+
+-- writing directly into a chunk makes the time range unknown
+INSERT INTO _timescaledb_internal._hyper_2_4_chunk VALUES ('2018-01-04 00:00', 5.0);
+SELECT * FROM chunk_stats;
+SELECT * FROM scanned_chunks($$SELECT * FROM sparse WHERE time < '2018-01-05'$$);
+
+-- so does updating the time column, but only in the chunks written
+ANALYZE sparse;
+UPDATE sparse SET time = time + INTERVAL '1 hour' WHERE time < '2018-01-02';
+SELECT * FROM chunk_stats;
+UPDATE sparse SET time = time + INTERVAL '1 hour' WHERE value = 1.0;
+SELECT * FROM chunk_stats;
+
+-- the time range is made unknown each time a prepared write executes
+ANALYZE sparse;
+PREPARE insert_into_chunk AS
+INSERT INTO _timescaledb_internal._hyper_2_4_chunk VALUES ('2018-01-09 00:00', 6.0);
+EXECUTE insert_into_chunk;
+DELETE FROM sparse WHERE value = 6.0;
+ANALYZE sparse;
+SELECT * FROM chunk_stats;
+EXECUTE insert_into_chunk;
+SELECT * FROM chunk_stats;
+DEALLOCATE insert_into_chunk;
+
+-- the time range is extended before a row outside of it is inserted, so
+-- queries run by triggers during the insert find the row
+ANALYZE sparse;
+CREATE FUNCTION sparse_count_after() RETURNS trigger LANGUAGE plpgsql AS $$
+BEGIN
+    RAISE NOTICE 'rows after 2018-01-03 13:00: %',
+        (SELECT count(*) FROM sparse WHERE time > '2018-01-03 13:00');
+    RETURN NULL;
+END
+$$;
+CREATE TRIGGER sparse_count_after AFTER INSERT ON sparse
+FOR EACH ROW EXECUTE PROCEDURE sparse_count_after();
+SELECT * FROM chunk_stats;
+INSERT INTO sparse VALUES ('2018-01-03 14:00', 7.0);
+SELECT * FROM chunk_stats;
+DROP TRIGGER sparse_count_after ON sparse;
+DROP FUNCTION sparse_count_after();
+
+RESET timescaledb.enable_chunk_time_range_exclusion;
+DROP FUNCTION scanned_chunks(text);
+DROP TABLE sparse;
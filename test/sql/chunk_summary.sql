@@ -0,0 +1,53 @@
+-- This file and its contents are licensed under the Apache License 2.0.
+-- Please see the included NOTICE for copyright information and
+-- LICENSE-APACHE for a copy of the license.
+
+\ir include/scanned_chunks.sql
+CREATE VIEW summary_indexes AS
+SELECT c.table_name, format('%I.%I', c.schema_name, ci.index_name)::regclass AS index
+FROM _timescaledb_catalog.chunk_index ci
+INNER JOIN _timescaledb_catalog.chunk c ON (c.id = ci.chunk_id)
+WHERE ci.hypertable_index_name = 'summary_test_temp_idx'
+ORDER BY c.id;
+
+CREATE TABLE summary_test(time timestamptz NOT NULL, device int, temp float);
+SELECT create_hypertable('summary_test', 'time', chunk_time_interval => INTERVAL '1 day');
+
+-- a BRIN index on the hypertable is created on every chunk and summarizes
+-- the column per block range
+CREATE INDEX summary_test_temp_idx ON summary_test USING brin (temp);
+INSERT INTO summary_test VALUES
+    ('2018-01-01 01:00', 1, 10.0),
+    ('2018-01-01 02:00', 1, 15.0),
+    ('2018-01-02 01:00', 1, 20.0),
+    ('2018-01-02 02:00', 1, 25.0),
+    ('2018-01-03 01:00', 1, 100.0),
+    ('2018-01-03 02:00', 1, 120.0);
+SELECT * FROM summary_indexes;
+
+SELECT * FROM scanned_chunks($$SELECT * FROM summary_test WHERE temp > 50$$);
+SET timescaledb.enable_chunk_summary_exclusion TO on;
+
+-- chunks cannot be excluded before their block ranges are summarized
+SELECT * FROM scanned_chunks($$SELECT * FROM summary_test WHERE temp > 50$$);
+SELECT table_name, brin_summarize_new_values(index) FROM summary_indexes;
+SELECT * FROM scanned_chunks($$SELECT * FROM summary_test WHERE temp > 50$$);
+SELECT * FROM scanned_chunks($$SELECT * FROM summary_test WHERE temp > 50 ORDER BY time LIMIT 1$$);
+SELECT * FROM scanned_chunks($$SELECT * FROM summary_test WHERE 50 < temp$$);
+SELECT * FROM scanned_chunks($$SELECT * FROM summary_test WHERE temp = 22$$);
+SELECT * FROM scanned_chunks($$SELECT * FROM summary_test WHERE temp < 5$$);
+SELECT * FROM summary_test WHERE temp > 50 ORDER BY time;
+
+-- inserts widen the summaries of summarized block ranges
+INSERT INTO summary_test VALUES ('2018-01-01 03:00', 1, 60.0);
+SELECT * FROM scanned_chunks($$SELECT * FROM summary_test WHERE temp > 50$$);
+SELECT * FROM summary_test WHERE temp > 50 ORDER BY time;
+
+-- new chunks start out without summaries
+INSERT INTO summary_test VALUES ('2018-01-04 01:00', 1, 5.0);
+SELECT * FROM scanned_chunks($$SELECT * FROM summary_test WHERE temp > 50$$);
+
+RESET timescaledb.enable_chunk_summary_exclusion;
+DROP TABLE summary_test;
+DROP VIEW summary_indexes;
+DROP FUNCTION scanned_chunks(text);
@@ -0,0 +1,18 @@
+-- This file and its contents are licensed under the Apache License 2.0.
+-- Please see the included NOTICE for copyright information and
+-- LICENSE-APACHE for a copy of the license.
+
+-- Get the chunks that the plan of a query scans
+CREATE FUNCTION scanned_chunks(query text) RETURNS SETOF text LANGUAGE plpgsql AS
+$BODY$
+DECLARE
+    line text;
+BEGIN
+    FOR line IN EXECUTE 'EXPLAIN (costs off) ' || query
+    LOOP
+        IF line ~ ' on _hyper_[0-9]+_[0-9]+_chunk( |$)' THEN
+            RETURN NEXT substring(line from ' on (_hyper_[0-9]+_[0-9]+_chunk)(?: |$)');
+        END IF;
+    END LOOP;
+END
+$BODY$;
@@ -0,0 +1,51 @@
+-- This file and its contents are licensed under the Apache License 2.0.
+-- Please see the included NOTICE for copyright information and
+-- LICENSE-APACHE for a copy of the license.
+
+-- Chunk lookups run their catalog scans in a scan session. Sessions are
+-- begun and ended in every subtransaction that looks up chunks, and must
+-- keep working after savepoints roll back.
+CREATE TABLE scan_session(time int NOT NULL, device int, value float);
+SELECT create_hypertable('scan_session', 'time', chunk_time_interval => 10);
+
+BEGIN;
+INSERT INTO scan_session VALUES (1, 1, 1.0), (11, 1, 2.0);
+SAVEPOINT a;
+INSERT INTO scan_session VALUES (21, 1, 3.0), (31, 1, 4.0);
+ROLLBACK TO SAVEPOINT a;
+-- the chunks created in the rolled back subtransaction are not found
+SELECT count(*) FROM show_chunks('scan_session');
+INSERT INTO scan_session VALUES (2, 1, 5.0), (21, 1, 6.0);
+SAVEPOINT b;
+-- fails after the first row has been routed to a new chunk
+\set ON_ERROR_STOP 0
+INSERT INTO scan_session VALUES (41, 1, 7.0), (42, 1, 1 / (random() * 0)::int);
+\set ON_ERROR_STOP 1
+ROLLBACK TO SAVEPOINT b;
+INSERT INTO scan_session VALUES (12, 1, 8.0), (41, 1, 9.0);
+SAVEPOINT c;
+INSERT INTO scan_session VALUES (3, 1, 10.0);
+RELEASE SAVEPOINT c;
+COMMIT;
+
+SELECT * FROM scan_session ORDER BY time;
+SELECT count(*) FROM show_chunks('scan_session');
+
+-- subtransactions that fail inside a statement
+DO $$
+BEGIN
+    FOR i IN 1..3 LOOP
+        BEGIN
+            INSERT INTO scan_session VALUES (i * 10 + 50, 1, i), (i * 10 + 51, 1, 1 / (random() * 0)::int);
+        EXCEPTION WHEN division_by_zero THEN
+            INSERT INTO scan_session VALUES (i * 10 + 52, 1, i), (4, 1, i);
+        END;
+    END LOOP;
+END
+$$;
+
+SELECT * FROM scan_session ORDER BY time, value;
+SELECT count(*) FROM show_chunks('scan_session');
+SELECT * FROM scan_session WHERE time > 40 AND time < 80 ORDER BY time;
+
+DROP TABLE scan_session;
@@ -67,3 +67,11 @@ SELECT * FROM hypertable_relation_size_pretty(NULL);
 SELECT * FROM indexes_relation_size(NULL);
 SELECT * FROM indexes_relation_size_pretty(NULL);
 
+
+-- tables that are not hypertables have no size and no row estimate
+CREATE TABLE not_hypertable(time TIMESTAMP, value INT);
+INSERT INTO not_hypertable VALUES('2004-01-01 10:00:01', 1);
+SELECT * FROM hypertable_relation_size('not_hypertable');
+SELECT * FROM chunk_relation_size('not_hypertable');
+SELECT * FROM indexes_relation_size('not_hypertable');
+SELECT * FROM hypertable_approximate_row_count('not_hypertable');
@@ -0,0 +1,37 @@
+-- This file and its contents are licensed under the Apache License 2.0.
+-- Please see the included NOTICE for copyright information and
+-- LICENSE-APACHE for a copy of the license.
+
+\set PREFIX 'EXPLAIN (costs off) '
+
+CREATE TABLE skip_scan(time int NOT NULL, dev int, val int);
+CREATE INDEX ON skip_scan(dev, time DESC);
+
+SELECT create_hypertable('skip_scan', 'time', chunk_time_interval => 100, create_default_indexes => false);
+
+INSERT INTO skip_scan SELECT t, d, t * d FROM generate_series(0, 299) t, generate_series(1, 5) d;
+INSERT INTO skip_scan VALUES (50, NULL, 0), (150, NULL, 1);
+ANALYZE skip_scan;
+
+SET enable_seqscan TO off;
+
+-- latest value per device, NULLs come last in scan order
+:PREFIX SELECT DISTINCT ON (dev) dev, time, val FROM skip_scan ORDER BY dev, time DESC;
+SELECT DISTINCT ON (dev) dev, time, val FROM skip_scan ORDER BY dev, time DESC;
+
+-- backward scan, NULLs come first in scan order
+:PREFIX SELECT DISTINCT dev FROM skip_scan ORDER BY dev DESC;
+SELECT DISTINCT dev FROM skip_scan ORDER BY dev DESC;
+
+-- additional restrictions are applied before skipping
+:PREFIX SELECT DISTINCT ON (dev) dev, time FROM skip_scan WHERE time < 150 ORDER BY dev, time DESC;
+SELECT DISTINCT ON (dev) dev, time FROM skip_scan WHERE time < 150 ORDER BY dev, time DESC;
+
+-- skip scan must not be used when distinct on more than one column
+:PREFIX SELECT DISTINCT dev, time FROM skip_scan ORDER BY dev, time DESC;
+
+-- results must not change with skip scan disabled
+SET timescaledb.enable_skip_scan TO false;
+:PREFIX SELECT DISTINCT ON (dev) dev, time, val FROM skip_scan ORDER BY dev, time DESC;
+SELECT DISTINCT ON (dev) dev, time, val FROM skip_scan ORDER BY dev, time DESC;
+RESET timescaledb.enable_skip_scan;
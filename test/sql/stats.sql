@@ -0,0 +1,58 @@
+-- This file and its contents are licensed under the Apache License 2.0.
+-- Please see the included NOTICE for copyright information and
+-- LICENSE-APACHE for a copy of the license.
+
+CREATE TABLE stats_test(time timestamptz, device int, temp float);
+SELECT create_hypertable('stats_test', 'time', chunk_time_interval => INTERVAL '1 day');
+CREATE VIEW counters AS
+SELECT name, calls, total_time IS NOT NULL AS timed
+FROM timescaledb_information.stats
+WHERE name NOT LIKE 'catalog\_scans.%'
+ORDER BY name;
+
+-- chunk routing and creation
+SELECT _timescaledb_internal.stats_reset();
+INSERT INTO stats_test VALUES
+    ('2018-01-01 01:00', 1, 1.0),
+    ('2018-01-01 02:00', 1, 2.0),
+    ('2018-01-02 01:00', 1, 3.0);
+SELECT * FROM counters;
+SELECT count(*) > 0 AS has_catalog_scans FROM timescaledb_information.stats WHERE name LIKE 'catalog\_scans.%';
+
+-- evictions from the chunk insert state cache
+SELECT _timescaledb_internal.stats_reset();
+SET timescaledb.max_open_chunks_per_insert = 1;
+INSERT INTO stats_test VALUES
+    ('2018-01-01 03:00', 1, 4.0),
+    ('2018-01-02 02:00', 1, 5.0),
+    ('2018-01-01 04:00', 1, 6.0);
+RESET timescaledb.max_open_chunks_per_insert;
+SELECT * FROM counters;
+
+-- chunk exclusion at plan time and at execution time
+SELECT _timescaledb_internal.stats_reset();
+SET timescaledb.track_plan_exclusion = on;
+SELECT count(*) FROM stats_test WHERE time < '2018-01-01 12:00';
+SELECT count(*) FROM stats_test WHERE time < '2018-01-01 12:00'::timestamptz + (now() - now());
+RESET timescaledb.track_plan_exclusion;
+SELECT * FROM counters;
+
+-- chunk details in EXPLAIN ANALYZE VERBOSE
+CREATE FUNCTION explain_details(query text) RETURNS SETOF text LANGUAGE plpgsql AS
+$BODY$
+DECLARE
+    line text;
+BEGIN
+    FOR line IN EXECUTE 'EXPLAIN (analyze, verbose, costs off, timing off) ' || query
+    LOOP
+        IF line ~ '^\s*Chunk' AND line !~ 'catalog scans' THEN
+            RETURN NEXT trim(line);
+        END IF;
+    END LOOP;
+END
+$BODY$;
+SELECT * FROM explain_details($$SELECT count(*) FROM stats_test WHERE time < '2018-01-01 12:00'::timestamptz + (now() - now())$$);
+SELECT * FROM explain_details($$INSERT INTO stats_test VALUES ('2018-01-01 05:00', 1, 7.0), ('2018-01-03 01:00', 1, 8.0), ('2018-01-01 06:00', 1, 9.0)$$);
+DROP FUNCTION explain_details(text);
+DROP VIEW counters;
+DROP TABLE stats_test;
@@ -181,5 +181,45 @@ SELECT * FROM show_tablespaces('tspace_1dim');
 DROP TABLESPACE tablespace1;
 --after detaching we should now be able to drop the tablespace
 SELECT detach_tablespace('tablespace1', 'tspace_1dim');
+
+-- with balanced placement, a new chunk goes to the tablespace with the
+-- fewest chunks in its time slice instead of following its space
+-- partition. Insert into partitions 0, 1 and 2 on the first day and only
+-- into partitions 0 and 2 on the second day, which sticky placement puts
+-- in the same tablespace.
+CREATE TABLE tspace_sticky(time timestamp, temp float, device int);
+CREATE TABLE tspace_balanced(time timestamp, temp float, device int);
+SELECT create_hypertable('tspace_sticky', 'time', 'device', 4, chunk_time_interval => INTERVAL '1 day');
+SELECT create_hypertable('tspace_balanced', 'time', 'device', 4, chunk_time_interval => INTERVAL '1 day');
+SELECT attach_tablespace('tablespace1', 'tspace_sticky');
+SELECT attach_tablespace('tablespace2', 'tspace_sticky');
+SELECT attach_tablespace('tablespace1', 'tspace_balanced');
+SELECT attach_tablespace('tablespace2', 'tspace_balanced');
+CREATE VIEW partition_devices AS
+SELECT DISTINCT ON (partition) partition, device
+FROM (SELECT _timescaledb_internal.get_partition_hash(d) / 536870911 AS partition, d AS device
+      FROM generate_series(1, 100) d) AS devices
+ORDER BY partition, device;
+INSERT INTO tspace_sticky
+SELECT '2018-01-01', 1.0, device FROM partition_devices WHERE partition IN (0, 1, 2) ORDER BY partition;
+INSERT INTO tspace_sticky
+SELECT '2018-01-02', 1.0, device FROM partition_devices WHERE partition IN (0, 2) ORDER BY partition;
+SET timescaledb.tablespace_placement = 'balanced';
+INSERT INTO tspace_balanced
+SELECT '2018-01-01', 1.0, device FROM partition_devices WHERE partition IN (0, 1, 2) ORDER BY partition;
+INSERT INTO tspace_balanced
+SELECT '2018-01-02', 1.0, device FROM partition_devices WHERE partition IN (0, 2) ORDER BY partition;
+RESET timescaledb.tablespace_placement;
+SELECT h.time, _timescaledb_internal.get_partition_hash(h.device) / 536870911 AS partition, t.spcname
+FROM tspace_sticky h JOIN pg_class c ON (c.oid = h.tableoid)
+LEFT JOIN pg_tablespace t ON (t.oid = c.reltablespace)
+ORDER BY 1, 2;
+SELECT h.time, _timescaledb_internal.get_partition_hash(h.device) / 536870911 AS partition, t.spcname
+FROM tspace_balanced h JOIN pg_class c ON (c.oid = h.tableoid)
+LEFT JOIN pg_tablespace t ON (t.oid = c.reltablespace)
+ORDER BY 1, 2;
+DROP VIEW partition_devices;
+DROP TABLE tspace_sticky;
+DROP TABLE tspace_balanced;
 DROP TABLESPACE tablespace1;
 DROP TABLESPACE tablespace2;
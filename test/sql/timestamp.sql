@@ -590,6 +590,15 @@ FROM unnest(ARRAY[
     ]) AS time;
 \set ON_ERROR_STOP 1
 
+--bucket width and origin varying per row
+SELECT width, time_bucket(width, timestamp without time zone '2001-01-01 01:17:00')
+FROM unnest(ARRAY[INTERVAL '1 hour', INTERVAL '15 min', INTERVAL '1 day']) AS width;
+SELECT origin, time_bucket(INTERVAL '1 day', timestamp without time zone '2001-01-01 01:17:00', origin)
+FROM unnest(ARRAY[
+    timestamp without time zone '2000-01-01 00:30:00',
+    timestamp without time zone '2000-01-01 02:00:00'
+    ]) AS origin;
+
 -------------------------------------
 --- Test time input functions --
 -------------------------------------
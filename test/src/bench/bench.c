@@ -0,0 +1,432 @@
+/*
+ * This file and its contents are licensed under the Apache License 2.0.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-APACHE for a copy of the license.
+ */
+#include <postgres.h>
+#include <fmgr.h>
+#include <funcapi.h>
+#include <access/htup_details.h>
+#include <executor/spi.h>
+#include <portability/instr_time.h>
+#include <tcop/tcopprot.h>
+#include <utils/builtins.h>
+#include <utils/lsyscache.h>
+#include <utils/memutils.h>
+#include <utils/rel.h>
+
+#include "export.h"
+#include "compat.h"
+#include "cache.h"
+#include "chunk.h"
+#include "dimension.h"
+#include "hypertable.h"
+#include "hypertable_cache.h"
+#include "subspace_store.h"
+
+/*
+ * Microbenchmarks for the hot paths of inserts and planning.
+ *
+ * Each benchmark runs an operation in a loop and returns a single row with
+ * the number of iterations, the total time, the throughput and the latency
+ * percentiles. Most of the operations take less time than reading the clock,
+ * so they are timed in batches and the percentiles are computed over the
+ * average latency of the batches.
+ *
+ * The benchmarks that route tuples take a sample query that must return rows
+ * of the same shape as the hypertable. The sample is typically generated with
+ * generate_series() so that it does not have to scan the (potentially huge)
+ * hypertable.
+ */
+
+#define TS_BENCH_FN(name)                                                                          \
+	TS_FUNCTION_INFO_V1(name);                                                                     \
+	Datum name(PG_FUNCTION_ARGS)
+
+#define BENCH_BATCH_SIZE 100
+
+typedef struct BenchTimer
+{
+	int64 iterations;
+	int batch_size;
+	int num_batches;
+	double *batch_us;
+	instr_time total;
+	instr_time batch_start;
+	int batch_count;
+} BenchTimer;
+
+static inline void
+bench_timer_start_batch(BenchTimer *timer)
+{
+	INSTR_TIME_SET_CURRENT(timer->batch_start);
+}
+
+static void
+bench_timer_init(BenchTimer *timer, int64 iterations, int batch_size)
+{
+	if (iterations <= 0)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("number of iterations must be positive")));
+
+	timer->iterations = iterations;
+	timer->batch_size = batch_size;
+	timer->num_batches = 0;
+	timer->batch_us = palloc(sizeof(double) * (iterations / batch_size + 1));
+	timer->batch_count = 0;
+	INSTR_TIME_SET_ZERO(timer->total);
+	bench_timer_start_batch(timer);
+}
+
+static void
+bench_timer_end_batch(BenchTimer *timer)
+{
+	instr_time duration;
+
+	INSTR_TIME_SET_CURRENT(duration);
+	INSTR_TIME_SUBTRACT(duration, timer->batch_start);
+	INSTR_TIME_ADD(timer->total, duration);
+	timer->batch_us[timer->num_batches++] =
+		INSTR_TIME_GET_DOUBLE(duration) * 1000000.0 / timer->batch_count;
+	timer->batch_count = 0;
+}
+
+/*
+ * Account for one iteration. Returns true when a batch was completed, in
+ * which case the caller can clean up, e.g., reset memory contexts, before
+ * starting the next batch. The time between batches is not counted.
+ */
+static inline bool
+bench_timer_tick(BenchTimer *timer)
+{
+	if (++timer->batch_count < timer->batch_size)
+		return false;
+
+	bench_timer_end_batch(timer);
+	return true;
+}
+
+static int
+cmp_double(const void *left, const void *right)
+{
+	double l = *((const double *) left);
+	double r = *((const double *) right);
+
+	return (l > r) - (l < r);
+}
+
+static double
+bench_timer_percentile(BenchTimer *timer, double fraction)
+{
+	int index = (int) (fraction * (timer->num_batches - 1) + 0.5);
+
+	return timer->batch_us[index];
+}
+
+enum Anum_bench_result
+{
+	Anum_bench_result_name = 1,
+	Anum_bench_result_iterations,
+	Anum_bench_result_total_ms,
+	Anum_bench_result_ops_per_sec,
+	Anum_bench_result_p50_us,
+	Anum_bench_result_p95_us,
+	Anum_bench_result_p99_us,
+	Anum_bench_result_max_us,
+	_Anum_bench_result_max,
+};
+
+#define Natts_bench_result (_Anum_bench_result_max - 1)
+
+static Datum
+bench_timer_result(BenchTimer *timer, const char *name, FunctionCallInfo fcinfo)
+{
+	Datum values[Natts_bench_result];
+	bool nulls[Natts_bench_result] = { false };
+	TupleDesc tupdesc;
+	double total_ms;
+
+	if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("function returning record called in context "
+						"that cannot accept type record")));
+
+	if (timer->batch_count > 0)
+		bench_timer_end_batch(timer);
+
+	if (timer->num_batches == 0)
+		elog(ERROR, "benchmark \"%s\" did not run any iterations", name);
+
+	qsort(timer->batch_us, timer->num_batches, sizeof(double), cmp_double);
+	total_ms = INSTR_TIME_GET_MILLISEC(timer->total);
+
+	values[AttrNumberGetAttrOffset(Anum_bench_result_name)] = CStringGetTextDatum(name);
+	values[AttrNumberGetAttrOffset(Anum_bench_result_iterations)] =
+		Int64GetDatum(timer->iterations);
+	values[AttrNumberGetAttrOffset(Anum_bench_result_total_ms)] = Float8GetDatum(total_ms);
+	values[AttrNumberGetAttrOffset(Anum_bench_result_ops_per_sec)] =
+		Float8GetDatum(total_ms > 0 ? timer->iterations * 1000.0 / total_ms : 0);
+	values[AttrNumberGetAttrOffset(Anum_bench_result_p50_us)] =
+		Float8GetDatum(bench_timer_percentile(timer, 0.50));
+	values[AttrNumberGetAttrOffset(Anum_bench_result_p95_us)] =
+		Float8GetDatum(bench_timer_percentile(timer, 0.95));
+	values[AttrNumberGetAttrOffset(Anum_bench_result_p99_us)] =
+		Float8GetDatum(bench_timer_percentile(timer, 0.99));
+	values[AttrNumberGetAttrOffset(Anum_bench_result_max_us)] =
+		Float8GetDatum(timer->batch_us[timer->num_batches - 1]);
+
+	return HeapTupleGetDatum(heap_form_tuple(BlessTupleDesc(tupdesc), values, nulls));
+}
+
+typedef struct BenchSample
+{
+	Hypertable *ht;
+	int num_tuples;
+	HeapTuple *tuples;
+	TupleDesc tupdesc;
+	Point **points;
+} BenchSample;
+
+/*
+ * Run the sample query and keep the resulting tuples. The tuples must match
+ * the row type of the hypertable for the dimension columns to be found.
+ */
+static void
+bench_sample_init(BenchSample *sample, Cache *hcache, Oid relid, text *query)
+{
+	Relation rel;
+	MemoryContext mcxt = CurrentMemoryContext;
+	int i;
+
+	sample->ht = ts_hypertable_cache_get_entry(hcache, relid);
+
+	if (NULL == sample->ht)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("table \"%s\" is not a hypertable", get_rel_name(relid))));
+
+	if (SPI_connect() != SPI_OK_CONNECT)
+		elog(ERROR, "could not connect to SPI");
+
+	if (SPI_execute(text_to_cstring(query), true, 0) != SPI_OK_SELECT)
+		elog(ERROR, "sample query must be a SELECT");
+
+	if (SPI_processed == 0)
+		elog(ERROR, "sample query returned no rows");
+
+	rel = heap_open(relid, AccessShareLock);
+
+	for (i = 0; i < RelationGetDescr(rel)->natts; i++)
+	{
+		if (i >= SPI_tuptable->tupdesc->natts ||
+			TupleDescAttr(RelationGetDescr(rel), i)->atttypid !=
+				TupleDescAttr(SPI_tuptable->tupdesc, i)->atttypid)
+			ereport(ERROR,
+					(errcode(ERRCODE_DATATYPE_MISMATCH),
+					 errmsg("sample query does not return rows of the hypertable's type")));
+	}
+
+	heap_close(rel, AccessShareLock);
+
+	/* Copy the tuples out of the SPI memory context */
+	sample->num_tuples = SPI_processed;
+	sample->tuples = MemoryContextAlloc(mcxt, sizeof(HeapTuple) * sample->num_tuples);
+	sample->points = MemoryContextAlloc(mcxt, sizeof(Point *) * sample->num_tuples);
+	MemoryContextSwitchTo(mcxt);
+	sample->tupdesc = CreateTupleDescCopy(SPI_tuptable->tupdesc);
+
+	for (i = 0; i < sample->num_tuples; i++)
+	{
+		sample->tuples[i] = heap_copytuple(SPI_tuptable->vals[i]);
+		sample->points[i] =
+			ts_hyperspace_calculate_point(sample->ht->space, sample->tuples[i], sample->tupdesc);
+	}
+
+	SPI_finish();
+}
+
+/*
+ * Calculate the point in the hyperspace of the sampled tuples.
+ */
+TS_BENCH_FN(ts_bench_calculate_point)
+{
+	Oid relid = PG_GETARG_OID(0);
+	int64 iterations = PG_GETARG_INT64(2);
+	Cache *hcache = ts_hypertable_cache_pin();
+	MemoryContext bench_mcxt = AllocSetContextCreate(CurrentMemoryContext,
+													  "Benchmark",
+													  ALLOCSET_DEFAULT_SIZES);
+	MemoryContext old;
+	BenchSample sample;
+	BenchTimer timer;
+	Datum result;
+	int64 i;
+
+	bench_sample_init(&sample, hcache, relid, PG_GETARG_TEXT_P(1));
+	bench_timer_init(&timer, iterations, BENCH_BATCH_SIZE);
+	old = MemoryContextSwitchTo(bench_mcxt);
+
+	for (i = 0; i < iterations; i++)
+	{
+		ts_hyperspace_calculate_point(sample.ht->space,
+									  sample.tuples[i % sample.num_tuples],
+									  sample.tupdesc);
+
+		if (bench_timer_tick(&timer))
+		{
+			MemoryContextReset(bench_mcxt);
+			bench_timer_start_batch(&timer);
+		}
+	}
+
+	MemoryContextSwitchTo(old);
+	result = bench_timer_result(&timer, "calculate_point", fcinfo);
+	MemoryContextDelete(bench_mcxt);
+	ts_cache_release(hcache);
+
+	PG_RETURN_DATUM(result);
+}
+
+/*
+ * Look up the chunks of the sampled tuples in the catalog, like an insert
+ * does on a cache miss.
+ */
+TS_BENCH_FN(ts_bench_chunk_find)
+{
+	Oid relid = PG_GETARG_OID(0);
+	int64 iterations = PG_GETARG_INT64(2);
+	Cache *hcache = ts_hypertable_cache_pin();
+	MemoryContext bench_mcxt = AllocSetContextCreate(CurrentMemoryContext,
+													  "Benchmark",
+													  ALLOCSET_DEFAULT_SIZES);
+	MemoryContext old;
+	BenchSample sample;
+	BenchTimer timer;
+	Datum result;
+	int64 i;
+
+	bench_sample_init(&sample, hcache, relid, PG_GETARG_TEXT_P(1));
+	bench_timer_init(&timer, iterations, 1);
+	old = MemoryContextSwitchTo(bench_mcxt);
+
+	for (i = 0; i < iterations; i++)
+	{
+		ts_chunk_find(sample.ht->space, sample.points[i % sample.num_tuples]);
+
+		if (bench_timer_tick(&timer))
+		{
+			MemoryContextReset(bench_mcxt);
+			bench_timer_start_batch(&timer);
+		}
+	}
+
+	MemoryContextSwitchTo(old);
+	result = bench_timer_result(&timer, "chunk_find", fcinfo);
+	MemoryContextDelete(bench_mcxt);
+	ts_cache_release(hcache);
+
+	PG_RETURN_DATUM(result);
+}
+
+/*
+ * Look up the sampled points in a subspace store that holds the chunks of
+ * the sample, like the chunk insert state cache of an insert. With a
+ * max_items lower than the number of chunks in the sample, lookups will also
+ * miss and evict entries.
+ */
+TS_BENCH_FN(ts_bench_subspace_store_get)
+{
+	Oid relid = PG_GETARG_OID(0);
+	int64 iterations = PG_GETARG_INT64(2);
+	int32 max_items = PG_GETARG_INT32(3);
+	Cache *hcache = ts_hypertable_cache_pin();
+	SubspaceStore *store;
+	BenchSample sample;
+	BenchTimer timer;
+	Datum result;
+	int64 i;
+
+	if (max_items < 0 || max_items > PG_INT16_MAX)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("max_items must be between 0 and %d", PG_INT16_MAX)));
+
+	bench_sample_init(&sample, hcache, relid, PG_GETARG_TEXT_P(1));
+	store = ts_subspace_store_init(sample.ht->space, CurrentMemoryContext, max_items);
+	bench_timer_init(&timer, iterations, BENCH_BATCH_SIZE);
+
+	for (i = 0; i < iterations; i++)
+	{
+		Point *point = sample.points[i % sample.num_tuples];
+
+		if (NULL == ts_subspace_store_get(store, point))
+		{
+			Chunk *chunk = ts_chunk_find(sample.ht->space, point);
+
+			if (NULL != chunk)
+				ts_subspace_store_add(store, chunk->cube, chunk, NULL);
+		}
+
+		if (bench_timer_tick(&timer))
+			bench_timer_start_batch(&timer);
+	}
+
+	result = bench_timer_result(&timer, "subspace_store_get", fcinfo);
+	ts_subspace_store_free(store);
+	ts_cache_release(hcache);
+
+	PG_RETURN_DATUM(result);
+}
+
+/*
+ * Parse, analyze and plan a query. For queries on hypertables this includes
+ * finding the chunks that match the restrictions in the catalog and expanding
+ * the hypertable.
+ */
+TS_BENCH_FN(ts_bench_plan)
+{
+	char *query_string = text_to_cstring(PG_GETARG_TEXT_P(0));
+	int64 iterations = PG_GETARG_INT64(1);
+	MemoryContext bench_mcxt = AllocSetContextCreate(CurrentMemoryContext,
+													  "Benchmark",
+													  ALLOCSET_DEFAULT_SIZES);
+	MemoryContext old;
+	BenchTimer timer;
+	Datum result;
+	int64 i;
+
+	bench_timer_init(&timer, iterations, 1);
+	old = MemoryContextSwitchTo(bench_mcxt);
+
+	for (i = 0; i < iterations; i++)
+	{
+		List *parsetrees = pg_parse_query(query_string);
+		ListCell *lc;
+
+		foreach (lc, parsetrees)
+		{
+			List *querytrees;
+
+#if PG96
+			querytrees = pg_analyze_and_rewrite(lfirst(lc), query_string, NULL, 0);
+#else
+			querytrees = pg_analyze_and_rewrite(lfirst(lc), query_string, NULL, 0, NULL);
+#endif
+			pg_plan_queries(querytrees, 0, NULL);
+		}
+
+		if (bench_timer_tick(&timer))
+		{
+			MemoryContextReset(bench_mcxt);
+			bench_timer_start_batch(&timer);
+		}
+	}
+
+	MemoryContextSwitchTo(old);
+	result = bench_timer_result(&timer, "plan", fcinfo);
+	MemoryContextDelete(bench_mcxt);
+
+	PG_RETURN_DATUM(result);
+}
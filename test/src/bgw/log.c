@@ -118,6 +118,13 @@ emit_log_hook_callback(ErrorData *edata)
 void
 ts_register_emit_log_hook()
 {
+	/*
+	 * A job runner registers the hook for every job it runs. Chaining the
+	 * hook to itself would log every message more than once.
+	 */
+	if (emit_log_hook == emit_log_hook_callback)
+		return;
+
 	prev_emit_log_hook = emit_log_hook;
 	emit_log_hook = emit_log_hook_callback;
 }
@@ -26,6 +26,7 @@
 #include "log.h"
 #include "bgw/scheduler.h"
 #include "bgw/job.h"
+#include "bgw/job_runner.h"
 #include "bgw/job_stat.h"
 #include "timer_mock.h"
 #include "params.h"
@@ -35,6 +36,7 @@ TS_FUNCTION_INFO_V1(ts_bgw_db_scheduler_test_run);
 TS_FUNCTION_INFO_V1(ts_bgw_db_scheduler_test_wait_for_scheduler_finish);
 TS_FUNCTION_INFO_V1(ts_bgw_db_scheduler_test_main);
 TS_FUNCTION_INFO_V1(ts_bgw_job_execute_test);
+TS_FUNCTION_INFO_V1(ts_bgw_job_runner_execute_test);
 TS_FUNCTION_INFO_V1(ts_test_bgw_job_insert_relation);
 TS_FUNCTION_INFO_V1(ts_test_bgw_job_delete_by_id);
 
@@ -121,6 +123,7 @@ ts_bgw_db_scheduler_test_main(PG_FUNCTION_ARGS)
 	ts_timer_set(&ts_mock_timer);
 
 	ts_bgw_job_set_job_entrypoint_function_name("ts_bgw_job_execute_test");
+	ts_bgw_job_runner_set_entrypoint_function_name("ts_bgw_job_runner_execute_test");
 
 	pgstat_report_appname("DB Scheduler Test");
 
@@ -307,6 +310,15 @@ ts_bgw_job_execute_test(PG_FUNCTION_ARGS)
 	return ts_bgw_job_entrypoint(fcinfo);
 }
 
+Datum
+ts_bgw_job_runner_execute_test(PG_FUNCTION_ARGS)
+{
+	ts_timer_set(&ts_mock_timer);
+	ts_bgw_job_set_unknown_job_type_hook(test_job_dispatcher);
+
+	return ts_bgw_job_runner_entrypoint(fcinfo);
+}
+
 Datum
 ts_test_bgw_job_insert_relation(PG_FUNCTION_ARGS)
 {
@@ -0,0 +1,144 @@
+/*
+ * This file and its contents are licensed under the Timescale License.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-TIMESCALE for a copy of the license.
+ */
+
+#include <postgres.h>
+#include <utils/builtins.h>
+#include <utils/timestamp.h>
+#include <utils/lsyscache.h>
+
+#include <hypertable_cache.h>
+
+#include "bgw/job.h"
+#include "bgw_policy/deferred_indexes.h"
+#include "deferred_indexes_api.h"
+#include "errors.h"
+#include "hypertable.h"
+#include "license.h"
+#include "utils.h"
+
+/* Default scheduled interval for deferred_indexes jobs is currently 1 hour */
+#define DEFAULT_SCHEDULE_INTERVAL                                                                  \
+	DatumGetIntervalP(DirectFunctionCall7(make_interval,                                           \
+										  Int32GetDatum(0),                                        \
+										  Int32GetDatum(0),                                        \
+										  Int32GetDatum(0),                                        \
+										  Int32GetDatum(0),                                        \
+										  Int32GetDatum(1),                                        \
+										  Int32GetDatum(0),                                        \
+										  Float8GetDatum(0)))
+/* Default max runtime for a deferred_indexes job is unlimited, since it builds whole indexes */
+#define DEFAULT_MAX_RUNTIME                                                                        \
+	DatumGetIntervalP(DirectFunctionCall7(make_interval,                                           \
+										  Int32GetDatum(0),                                        \
+										  Int32GetDatum(0),                                        \
+										  Int32GetDatum(0),                                        \
+										  Int32GetDatum(0),                                        \
+										  Int32GetDatum(0),                                        \
+										  Int32GetDatum(0),                                        \
+										  Float8GetDatum(0)))
+/* Right now, there is an infinite number of retries for deferred_indexes jobs */
+#define DEFAULT_MAX_RETRIES -1
+/* Default retry period for deferred_indexes jobs is currently 1 hour */
+#define DEFAULT_RETRY_PERIOD DEFAULT_SCHEDULE_INTERVAL
+
+Datum
+deferred_indexes_add_policy(PG_FUNCTION_ARGS)
+{
+	NameData application_name;
+	NameData deferred_indexes_name;
+	int32 job_id;
+	BgwPolicyDeferredIndexes *existing;
+	Hypertable *hypertable;
+	Cache *hcache;
+	Oid ht_oid = PG_GETARG_OID(0);
+	bool if_not_exists = PG_GETARG_BOOL(1);
+	BgwPolicyDeferredIndexes policy = { .fd = { 0 } };
+
+	license_enforce_enterprise_enabled();
+	license_print_expiration_warning_if_needed();
+
+	hcache = ts_hypertable_cache_pin();
+	hypertable = ts_hypertable_cache_get_entry(hcache, ht_oid);
+	/* First verify that the hypertable corresponds to a valid table */
+	if (hypertable == NULL)
+		ereport(ERROR,
+				(errcode(ERRCODE_TS_HYPERTABLE_NOT_EXIST),
+				 errmsg("could not add deferred_indexes policy because \"%s\" is not a "
+						"hypertable",
+						get_rel_name(ht_oid))));
+
+	/* Make sure that an existing policy doesn't exist on this hypertable */
+	existing = ts_bgw_policy_deferred_indexes_find_by_hypertable(hypertable->fd.id);
+
+	if (existing != NULL)
+	{
+		ts_cache_release(hcache);
+
+		if (!if_not_exists)
+			ereport(ERROR,
+					(errcode(ERRCODE_DUPLICATE_OBJECT),
+					 errmsg("deferred indexes policy already exists for hypertable \"%s\"",
+							get_rel_name(ht_oid))));
+
+		/* The policy has no arguments, so the existing one is always the same */
+		ereport(NOTICE,
+				(errmsg("deferred indexes policy already exists on hypertable \"%s\", skipping",
+						get_rel_name(ht_oid))));
+		return -1;
+	}
+
+	policy.fd.hypertable_id = hypertable->fd.id;
+	ts_cache_release(hcache);
+
+	/* Next, insert a new job into jobs table */
+	namestrcpy(&application_name, "Deferred Indexes Background Job");
+	namestrcpy(&deferred_indexes_name, "deferred_indexes");
+	job_id = ts_bgw_job_insert_relation(&application_name,
+										&deferred_indexes_name,
+										DEFAULT_SCHEDULE_INTERVAL,
+										DEFAULT_MAX_RUNTIME,
+										DEFAULT_MAX_RETRIES,
+										DEFAULT_RETRY_PERIOD);
+
+	/* Now, insert a new row in the deferred_indexes args table */
+	policy.fd.job_id = job_id;
+	ts_bgw_policy_deferred_indexes_insert(&policy);
+
+	PG_RETURN_INT32(job_id);
+}
+
+Datum
+deferred_indexes_remove_policy(PG_FUNCTION_ARGS)
+{
+	Oid hypertable_oid = PG_GETARG_OID(0);
+	bool if_exists = PG_GETARG_BOOL(1);
+
+	/* Remove the job, then remove the policy */
+	int ht_id = ts_hypertable_relid_to_id(hypertable_oid);
+	BgwPolicyDeferredIndexes *policy = ts_bgw_policy_deferred_indexes_find_by_hypertable(ht_id);
+
+	license_enforce_enterprise_enabled();
+	license_print_expiration_warning_if_needed();
+
+	if (policy == NULL)
+	{
+		if (!if_exists)
+			ereport(ERROR,
+					(errcode(ERRCODE_UNDEFINED_OBJECT),
+					 errmsg("cannot remove deferred indexes policy, no such policy exists")));
+		else
+		{
+			ereport(NOTICE,
+					(errmsg("deferred indexes policy does not exist on hypertable \"%s\", skipping",
+							get_rel_name(hypertable_oid))));
+			PG_RETURN_NULL();
+		}
+	}
+
+	ts_bgw_job_delete_by_id(policy->fd.job_id);
+
+	PG_RETURN_NULL();
+}
@@ -10,18 +10,25 @@
 #include <access/xact.h>
 #include <catalog/namespace.h>
 #include <catalog/pg_type.h>
+#include <commands/tablespace.h>
 #include <utils/lsyscache.h>
+#include <utils/memutils.h>
+#include <miscadmin.h>
 
 #include "bgw/timer.h"
 #include "bgw/job_stat.h"
 #include "bgw_policy/chunk_stats.h"
+#include "bgw_policy/deferred_indexes.h"
 #include "bgw_policy/drop_chunks.h"
+#include "bgw_policy/move_chunks.h"
 
 #include "bgw_policy/reorder.h"
 #include "errors.h"
 #include "job.h"
 #include "hypertable.h"
 #include "chunk.h"
+#include "chunk_index.h"
+#include "chunk_statistics.h"
 #include "dimension.h"
 #include "dimension_slice.h"
 #include "dimension_vector.h"
@@ -35,15 +42,16 @@
 #define REORDER_SKIP_RECENT_DIM_SLICES_N 3
 
 /*
- * Returns the ID of a chunk to reorder. Eligible chunks must be at least the
- * 3rd newest chunk in the hypertable (not entirely exact because we use the number
- * of dimension slices as a proxy for the number of chunks) and hasn't been
- * reordered recently. For this version of automatic reordering, "not reordered
- * recently" means the chunk has not been reordered at all. This information
- * is available in the bgw_policy_chunk_stats metadata table.
+ * Returns the IDs of (at most) `limit` chunks to reorder, oldest first. Eligible
+ * chunks must be at least the 3rd newest chunk in the hypertable (not entirely
+ * exact because we use the number of dimension slices as a proxy for the number
+ * of chunks) and hasn't been reordered recently. For this version of automatic
+ * reordering, "not reordered recently" means the chunk has not been reordered at
+ * all. This information is available in the bgw_policy_chunk_stats metadata
+ * table.
  */
-static int
-get_chunk_id_to_reorder(int32 job_id, Hypertable *ht)
+static List *
+get_chunk_ids_to_reorder(int32 job_id, Hypertable *ht, int limit)
 {
 	Dimension *time_dimension = hyperspace_get_open_dimension(ht->space, 0);
 	DimensionSlice *nth_dimension =
@@ -51,27 +59,95 @@ get_chunk_id_to_reorder(int32 job_id, Hypertable *ht)
 											REORDER_SKIP_RECENT_DIM_SLICES_N);
 
 	if (!nth_dimension)
-		return -1;
+		return NIL;
 
 	Assert(time_dimension != NULL);
 
-	return ts_dimension_slice_oldest_chunk_without_executed_job(job_id,
-																time_dimension->fd.id,
-																BTLessEqualStrategyNumber,
-																nth_dimension->fd.range_start,
-																InvalidStrategy,
-																-1);
+	return ts_dimension_slice_oldest_chunks_without_executed_job(job_id,
+																 time_dimension->fd.id,
+																 BTLessEqualStrategyNumber,
+																 nth_dimension->fd.range_start,
+																 InvalidStrategy,
+																 -1,
+																 limit);
 }
 
+static void
+reorder_policy_chunk(BgwPolicyReorder *args, Hypertable *ht, int32 chunk_id, reorder_func reorder)
+{
+	Chunk *chunk = ts_chunk_get_by_id(chunk_id, 0, false);
+
+	/* The chunk could have been dropped since it was picked */
+	if (chunk == NULL)
+	{
+		elog(LOG, "chunk %d no longer exists, skipping reorder", chunk_id);
+		return;
+	}
+
+	/*
+	 * NOTE: We pass the Oid of the hypertable's index, and the true reorder
+	 * function should translate this to the Oid of the index on the specific
+	 * chunk.
+	 */
+	elog(LOG, "reordering chunk %s.%s", chunk->fd.schema_name.data, chunk->fd.table_name.data);
+	reorder(chunk->table_id,
+			get_relname_relid(NameStr(args->fd.hypertable_index_name),
+							  get_namespace_oid(NameStr(ht->fd.schema_name), false)),
+			false,
+			InvalidOid);
+	elog(LOG,
+		 "completed reordering chunk %s.%s",
+		 chunk->fd.schema_name.data,
+		 chunk->fd.table_name.data);
+
+	/* The chunk was rewritten, so its cached statistics are out of date */
+	ts_chunk_statistics_refresh(ht, chunk);
+
+	/* Now update chunk_stats table */
+	ts_bgw_policy_chunk_stats_record_job_run(args->fd.job_id,
+											 chunk_id,
+											 ts_timer_get_current_timestamp());
+}
+
+static BgwPolicyReorder *
+get_reorder_policy_args(int32 job_id)
+{
+	/* Get the arguments from the reorder_policy table */
+	BgwPolicyReorder *args = ts_bgw_policy_reorder_find_by_job(job_id);
+
+	if (args == NULL)
+		ereport(ERROR,
+				(errcode(ERRCODE_TS_INTERNAL_ERROR),
+				 errmsg("could not run reorder policy #%d because no args in policy table",
+						job_id)));
+
+	return args;
+}
+
+/*
+ * Run the reorder policy on the oldest chunks that have not been reordered.
+ *
+ * A policy with max_workers > 1 reorders up to max_workers chunks in one
+ * run. The chunks are picked here, in a single scan, and every additional
+ * chunk is handed to a helper background worker, so no two workers ever
+ * reorder the same chunk. Each worker records its own chunk in
+ * bgw_policy_chunk_stats when the reorder of that chunk commits, and this
+ * worker waits for all helpers before returning, so the next run of the
+ * policy sees the stats of all of them. Helpers are only started if a
+ * background worker slot is available; chunks that did not get a helper are
+ * left for the next run.
+ */
 bool
 execute_reorder_policy(BgwJob *job, reorder_func reorder, bool fast_continue)
 {
-	int chunk_id;
+	List *chunk_ids;
+	List *helpers = NIL;
+	ListCell *lc;
 	bool started = false;
 	BgwPolicyReorder *args;
 	Hypertable *ht;
-	Chunk *chunk;
 	int32 job_id = job->fd.id;
+	MemoryContext caller_mcxt = CurrentMemoryContext;
 
 	if (!IsTransactionOrTransactionBlock())
 	{
@@ -79,21 +155,16 @@ execute_reorder_policy(BgwJob *job, reorder_func reorder, bool fast_continue)
 		StartTransactionCommand();
 	}
 
-	/* Get the arguments from the reorder_policy table */
-	args = ts_bgw_policy_reorder_find_by_job(job_id);
-
-	if (args == NULL)
-		ereport(ERROR,
-				(errcode(ERRCODE_TS_INTERNAL_ERROR),
-				 errmsg("could not run reorder policy #%d because no args in policy table",
-						job_id)));
-
+	args = get_reorder_policy_args(job_id);
 	ht = ts_hypertable_get_by_id(args->fd.hypertable_id);
 
-	/* Find a chunk to reorder in the selected hypertable */
-	chunk_id = get_chunk_id_to_reorder(args->fd.job_id, ht);
+	/*
+	 * Find the chunks to reorder in the selected hypertable. One extra chunk
+	 * is looked up to know whether a fast continue is needed.
+	 */
+	chunk_ids = get_chunk_ids_to_reorder(args->fd.job_id, ht, args->fd.max_workers + 1);
 
-	if (chunk_id == -1)
+	if (chunk_ids == NIL)
 	{
 		elog(NOTICE,
 			 "no chunks need reordering for hypertable %s.%s",
@@ -103,28 +174,41 @@ execute_reorder_policy(BgwJob *job, reorder_func reorder, bool fast_continue)
 	}
 
 	/*
-	 * NOTE: We pass the Oid of the hypertable's index, and the true reorder
-	 * function should translate this to the Oid of the index on the specific
-	 * chunk.
+	 * Only policy runs from the scheduler dispatch helpers; callers running
+	 * the policy directly reorder a single chunk with the given reorder
+	 * function. The helper handles must survive the commit below.
 	 */
-	chunk = ts_chunk_get_by_id(chunk_id, 0, false);
-	elog(LOG, "reordering chunk %s.%s", chunk->fd.schema_name.data, chunk->fd.table_name.data);
-	reorder(chunk->table_id,
-			get_relname_relid(NameStr(args->fd.hypertable_index_name),
-							  get_namespace_oid(NameStr(ht->fd.schema_name), false)),
-			false,
-			InvalidOid);
-	elog(LOG,
-		 "completed reordering chunk %s.%s",
-		 chunk->fd.schema_name.data,
-		 chunk->fd.table_name.data);
+	if (IsBackgroundWorker && args->fd.max_workers > 1)
+	{
+		MemoryContext old = MemoryContextSwitchTo(caller_mcxt);
 
-	/* Now update chunk_stats table */
-	ts_bgw_policy_chunk_stats_record_job_run(args->fd.job_id,
-											 chunk_id,
-											 ts_timer_get_current_timestamp());
+		for (lc = lnext(list_head(chunk_ids));
+			 lc != NULL && list_length(helpers) < args->fd.max_workers - 1;
+			 lc = lnext(lc))
+		{
+			BackgroundWorkerHandle *handle = ts_bgw_job_start_helper(job, lfirst_int(lc));
+
+			if (handle == NULL)
+				break;
 
-	if (fast_continue && get_chunk_id_to_reorder(args->fd.job_id, ht) != -1)
+			helpers = lappend(helpers, handle);
+		}
+		MemoryContextSwitchTo(old);
+	}
+
+	PG_TRY();
+	{
+		reorder_policy_chunk(args, ht, linitial_int(chunk_ids), reorder);
+	}
+	PG_CATCH();
+	{
+		foreach (lc, helpers)
+			ts_bgw_job_terminate_helper(lfirst(lc));
+		PG_RE_THROW();
+	}
+	PG_END_TRY();
+
+	if (fast_continue && list_length(chunk_ids) > 1 + list_length(helpers))
 	{
 		BgwJobStat *job_stat = ts_bgw_job_stat_find(job->fd.id);
 
@@ -136,6 +220,32 @@ commit:
 	if (started)
 		CommitTransactionCommand();
 
+	/*
+	 * Wait for the helpers only after committing, so that the locks on the
+	 * chunk reordered here are not held while the other chunks are reordered.
+	 */
+	foreach (lc, helpers)
+		ts_bgw_job_wait_helper(lfirst(lc));
+
+	return true;
+}
+
+/*
+ * Reorder a single chunk in a helper worker. The chunk was picked by the
+ * policy's own worker in execute_reorder_policy.
+ */
+static bool
+execute_reorder_policy_chunk(BgwJob *job, int32 chunk_id, reorder_func reorder)
+{
+	BgwPolicyReorder *args;
+	Hypertable *ht;
+
+	StartTransactionCommand();
+	args = get_reorder_policy_args(job->fd.id);
+	ht = ts_hypertable_get_by_id(args->fd.hypertable_id);
+	reorder_policy_chunk(args, ht, chunk_id, reorder);
+	CommitTransactionCommand();
+
 	return true;
 }
 
@@ -174,6 +284,233 @@ execute_drop_chunks_policy(int32 job_id)
 	return true;
 }
 
+/*
+ * Move the oldest chunk that is older than the policy's older_than and not in
+ * the destination tablespace yet, reordering it on the policy's index if one
+ * is given. Like reorder, one chunk is rewritten per run, and the job is
+ * rescheduled immediately if there are more chunks to move.
+ */
+bool
+execute_move_chunks_policy(BgwJob *job, bool fast_continue)
+{
+	bool started = false;
+	BgwPolicyMoveChunks *args;
+	Hypertable *ht;
+	Chunk **chunks;
+	uint64 num_chunks = 0;
+	uint64 i;
+	Chunk *chunk = NULL;
+	bool more = false;
+	Oid destination_tablespace;
+	Oid destination_reltablespace;
+	Oid index_destination_tablespace;
+	Oid reorder_index = InvalidOid;
+
+	if (!IsTransactionOrTransactionBlock())
+	{
+		started = true;
+		StartTransactionCommand();
+	}
+
+	/* Get the arguments from the move_chunks_policy table */
+	args = ts_bgw_policy_move_chunks_find_by_job(job->fd.id);
+
+	if (args == NULL)
+		ereport(ERROR,
+				(errcode(ERRCODE_TS_INTERNAL_ERROR),
+				 errmsg("could not run move_chunks policy #%d because no args in policy table",
+						job->fd.id)));
+
+	ht = ts_hypertable_get_by_id(args->fd.hypertable_id);
+	destination_tablespace = get_tablespace_oid(NameStr(args->fd.destination_tablespace), false);
+	index_destination_tablespace =
+		get_tablespace_oid(NameStr(args->fd.index_destination_tablespace), false);
+
+	if (NameStr(args->fd.reorder_index_name)[0] != '\0')
+	{
+		reorder_index = get_relname_relid(NameStr(args->fd.reorder_index_name),
+										  get_namespace_oid(NameStr(ht->fd.schema_name), false));
+
+		/* Do not move chunks without reordering them if the index was dropped */
+		if (!OidIsValid(reorder_index))
+			ereport(ERROR,
+					(errcode(ERRCODE_UNDEFINED_OBJECT),
+					 errmsg("could not run move_chunks policy #%d because reorder index \"%s\" "
+							"does not exist",
+							job->fd.id,
+							NameStr(args->fd.reorder_index_name))));
+	}
+
+	chunks = ts_chunk_get_chunks_in_time_range(ht->main_table_relid,
+											   IntervalPGetDatum(&args->fd.older_than),
+											   0,
+											   INTERVALOID,
+											   InvalidOid,
+											   "move_chunks",
+											   CurrentMemoryContext,
+											   &num_chunks);
+
+	/* Chunks in the database's default tablespace have reltablespace 0 */
+	destination_reltablespace =
+		destination_tablespace == MyDatabaseTableSpace ? InvalidOid : destination_tablespace;
+
+	for (i = 0; i < num_chunks; i++)
+	{
+		if (get_rel_tablespace(chunks[i]->table_id) == destination_reltablespace)
+			continue;
+
+		if (chunk != NULL)
+		{
+			more = true;
+			break;
+		}
+		chunk = chunks[i];
+	}
+
+	if (chunk == NULL)
+	{
+		elog(NOTICE,
+			 "no chunks need moving for hypertable %s.%s",
+			 ht->fd.schema_name.data,
+			 ht->fd.table_name.data);
+		goto commit;
+	}
+
+	elog(LOG, "moving chunk %s.%s", chunk->fd.schema_name.data, chunk->fd.table_name.data);
+	move_chunk(chunk->table_id,
+			   destination_tablespace,
+			   index_destination_tablespace,
+			   reorder_index,
+			   false,
+			   InvalidOid);
+	elog(LOG,
+		 "completed moving chunk %s.%s",
+		 chunk->fd.schema_name.data,
+		 chunk->fd.table_name.data);
+
+	if (fast_continue && more)
+	{
+		BgwJobStat *job_stat = ts_bgw_job_stat_find(job->fd.id);
+
+		ts_bgw_job_stat_set_next_start(job, job_stat->fd.last_start);
+		elog(LOG, "Fast catchup enabled on move_chunks");
+	}
+
+commit:
+	if (started)
+		CommitTransactionCommand();
+	return true;
+}
+
+/*
+ * Returns the IDs of (at most) the two oldest chunks behind the write frontier
+ * that the deferred indexes policy has not processed yet. The second one is
+ * only used to know whether a fast continue is needed.
+ */
+static List *
+get_chunk_ids_without_deferred_indexes(int32 job_id, Hypertable *ht)
+{
+	Dimension *time_dimension = hyperspace_get_open_dimension(ht->space, 0);
+	DimensionSlice *frontier = ts_dimension_slice_write_frontier(time_dimension);
+
+	if (!frontier)
+		return NIL;
+
+	return ts_dimension_slice_oldest_chunks_without_executed_job(job_id,
+																 time_dimension->fd.id,
+																 BTLessStrategyNumber,
+																 frontier->fd.range_start,
+																 InvalidStrategy,
+																 -1,
+																 2);
+}
+
+/*
+ * Build the deferred indexes of the oldest chunk behind the write frontier
+ * that the policy has not processed yet. Chunks are recorded in
+ * bgw_policy_chunk_stats once processed; deferred indexes that are added
+ * later are built right away on the chunks behind the frontier, so a chunk
+ * never needs to be processed twice. Chunks that already have all indexes,
+ * e.g., backfilled ones, are only recorded. Like reorder, indexes are built on
+ * one chunk per run, and the job is rescheduled immediately if there are more
+ * chunks.
+ */
+bool
+execute_deferred_indexes_policy(BgwJob *job, bool fast_continue)
+{
+	bool started = false;
+	BgwPolicyDeferredIndexes *args;
+	Hypertable *ht;
+	List *chunk_ids;
+	int num_created = 0;
+
+	if (!IsTransactionOrTransactionBlock())
+	{
+		started = true;
+		StartTransactionCommand();
+	}
+
+	/* Get the arguments from the deferred_indexes_policy table */
+	args = ts_bgw_policy_deferred_indexes_find_by_job(job->fd.id);
+
+	if (args == NULL)
+		ereport(ERROR,
+				(errcode(ERRCODE_TS_INTERNAL_ERROR),
+				 errmsg("could not run deferred_indexes policy #%d because no args in policy "
+						"table",
+						job->fd.id)));
+
+	ht = ts_hypertable_get_by_id(args->fd.hypertable_id);
+
+	chunk_ids = get_chunk_ids_without_deferred_indexes(job->fd.id, ht);
+
+	while (chunk_ids != NIL)
+	{
+		Chunk *chunk = ts_chunk_get_by_id(linitial_int(chunk_ids), 0, true);
+
+		num_created = ts_chunk_index_create_deferred(ht, chunk);
+
+		if (num_created > 0)
+			elog(LOG,
+				 "built %d deferred indexes on chunk %s.%s",
+				 num_created,
+				 chunk->fd.schema_name.data,
+				 chunk->fd.table_name.data);
+
+		ts_bgw_policy_chunk_stats_record_job_run(job->fd.id,
+												 chunk->fd.id,
+												 ts_timer_get_current_timestamp());
+
+		/* The chunk is recorded, so this finds the next ones */
+		chunk_ids = get_chunk_ids_without_deferred_indexes(job->fd.id, ht);
+
+		if (num_created > 0)
+			break;
+	}
+
+	if (num_created == 0)
+	{
+		elog(NOTICE,
+			 "no chunks need deferred indexes for hypertable %s.%s",
+			 ht->fd.schema_name.data,
+			 ht->fd.table_name.data);
+		goto commit;
+	}
+
+	if (fast_continue && chunk_ids != NIL)
+	{
+		BgwJobStat *job_stat = ts_bgw_job_stat_find(job->fd.id);
+
+		ts_bgw_job_stat_set_next_start(job, job_stat->fd.last_start);
+		elog(LOG, "Fast catchup enabled on deferred_indexes");
+	}
+
+commit:
+	if (started)
+		CommitTransactionCommand();
+	return true;
+}
+
 bool
 tsl_bgw_policy_job_execute(BgwJob *job)
 {
@@ -186,6 +523,10 @@ tsl_bgw_policy_job_execute(BgwJob *job)
 			return execute_reorder_policy(job, reorder_chunk, true);
 		case JOB_TYPE_DROP_CHUNKS:
 			return execute_drop_chunks_policy(job->fd.id);
+		case JOB_TYPE_MOVE_CHUNKS:
+			return execute_move_chunks_policy(job, true);
+		case JOB_TYPE_DEFERRED_INDEXES:
+			return execute_deferred_indexes_policy(job, true);
 		default:
 			elog(ERROR,
 				 "scheduler tried to run an invalid enterprise job type: \"%s\"",
@@ -194,6 +535,23 @@ tsl_bgw_policy_job_execute(BgwJob *job)
 	pg_unreachable();
 }
 
+bool
+tsl_bgw_policy_job_execute_helper(BgwJob *job, int32 item)
+{
+	license_enforce_enterprise_enabled();
+
+	switch (job->bgw_type)
+	{
+		case JOB_TYPE_REORDER:
+			return execute_reorder_policy_chunk(job, item, reorder_chunk);
+		default:
+			elog(ERROR,
+				 "scheduler tried to run a helper for an invalid job type: \"%s\"",
+				 NameStr(job->fd.job_type));
+	}
+	pg_unreachable();
+}
+
 Datum
 bgw_policy_alter_job_schedule(PG_FUNCTION_ARGS)
 {
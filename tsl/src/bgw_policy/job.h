@@ -19,8 +19,11 @@ typedef void (*reorder_func)(Oid tableOid, Oid indexOid, bool verbose, Oid wait_
 /* Functions exposed only for testing */
 extern bool execute_reorder_policy(BgwJob *job, reorder_func reorder, bool fast_continue);
 extern bool execute_drop_chunks_policy(int32 job_id);
+extern bool execute_move_chunks_policy(BgwJob *job, bool fast_continue);
+extern bool execute_deferred_indexes_policy(BgwJob *job, bool fast_continue);
 
 extern bool tsl_bgw_policy_job_execute(BgwJob *job);
+extern bool tsl_bgw_policy_job_execute_helper(BgwJob *job, int32 item);
 extern Datum bgw_policy_alter_job_schedule(PG_FUNCTION_ARGS);
 
 #endif /* TIMESCALEDB_TSL_BGW_POLICY_JOB_H */
@@ -0,0 +1,241 @@
+/*
+ * This file and its contents are licensed under the Timescale License.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-TIMESCALE for a copy of the license.
+ */
+
+#include <postgres.h>
+#include <catalog/namespace.h>
+#include <catalog/pg_type.h>
+#include <commands/tablespace.h>
+#include <utils/builtins.h>
+#include <utils/timestamp.h>
+#include <utils/lsyscache.h>
+#include <utils/syscache.h>
+
+#include <hypertable_cache.h>
+
+#include "bgw/job.h"
+#include "bgw_policy/move_chunks.h"
+#include "move_chunks_api.h"
+#include "chunk_index.h"
+#include "errors.h"
+#include "hypertable.h"
+#include "license.h"
+#include "utils.h"
+
+/* Default scheduled interval for move_chunks jobs is currently 1 day (24 hours) */
+#define DEFAULT_SCHEDULE_INTERVAL                                                                  \
+	DatumGetIntervalP(DirectFunctionCall7(make_interval,                                           \
+										  Int32GetDatum(0),                                        \
+										  Int32GetDatum(0),                                        \
+										  Int32GetDatum(0),                                        \
+										  Int32GetDatum(1),                                        \
+										  Int32GetDatum(0),                                        \
+										  Int32GetDatum(0),                                        \
+										  Float8GetDatum(0)))
+/* Default max runtime for a move_chunks job is unlimited, since it rewrites whole chunks */
+#define DEFAULT_MAX_RUNTIME                                                                        \
+	DatumGetIntervalP(DirectFunctionCall7(make_interval,                                           \
+										  Int32GetDatum(0),                                        \
+										  Int32GetDatum(0),                                        \
+										  Int32GetDatum(0),                                        \
+										  Int32GetDatum(0),                                        \
+										  Int32GetDatum(0),                                        \
+										  Int32GetDatum(0),                                        \
+										  Float8GetDatum(0)))
+/* Right now, there is an infinite number of retries for move_chunks jobs */
+#define DEFAULT_MAX_RETRIES -1
+/* Default retry period for move_chunks jobs is currently 12 hours */
+#define DEFAULT_RETRY_PERIOD                                                                       \
+	DatumGetIntervalP(DirectFunctionCall7(make_interval,                                           \
+										  Int32GetDatum(0),                                        \
+										  Int32GetDatum(0),                                        \
+										  Int32GetDatum(0),                                        \
+										  Int32GetDatum(0),                                        \
+										  Int32GetDatum(12),                                       \
+										  Int32GetDatum(0),                                        \
+										  Float8GetDatum(0)))
+
+static void
+check_valid_reorder_index(Hypertable *ht, Name index_name)
+{
+	Oid index_oid;
+	HeapTuple idxtuple;
+	Form_pg_index indexForm;
+
+	index_oid = get_relname_relid(NameStr(*index_name),
+								  get_namespace_oid(NameStr(ht->fd.schema_name), false));
+	idxtuple = SearchSysCache1(INDEXRELID, ObjectIdGetDatum(index_oid));
+	if (!HeapTupleIsValid(idxtuple))
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("could not add move_chunks policy because the provided index is not a "
+						"valid relation")));
+
+	indexForm = (Form_pg_index) GETSTRUCT(idxtuple);
+	if (indexForm->indrelid != ht->main_table_relid)
+		elog(ERROR,
+			 "could not add move_chunks policy because the provided index is not a valid index on "
+			 "the hypertable");
+	ReleaseSysCache(idxtuple);
+
+	/* Deferred indexes are missing on the chunks at the write frontier */
+	if (ts_chunk_index_is_deferred(ht->fd.id, NameStr(*index_name)))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("could not add move_chunks policy because the provided index is deferred"),
+				 errhint("Use an index that is built on all chunks.")));
+}
+
+static bool
+move_chunks_policy_equal(BgwPolicyMoveChunks *p1, BgwPolicyMoveChunks *p2)
+{
+	return DatumGetBool(DirectFunctionCall2(interval_eq,
+											IntervalPGetDatum(&p1->fd.older_than),
+											IntervalPGetDatum(&p2->fd.older_than))) &&
+		   namestrcmp(&p1->fd.destination_tablespace, NameStr(p2->fd.destination_tablespace)) ==
+			   0 &&
+		   namestrcmp(&p1->fd.index_destination_tablespace,
+					  NameStr(p2->fd.index_destination_tablespace)) == 0 &&
+		   namestrcmp(&p1->fd.reorder_index_name, NameStr(p2->fd.reorder_index_name)) == 0;
+}
+
+Datum
+move_chunks_add_policy(PG_FUNCTION_ARGS)
+{
+	NameData application_name;
+	NameData move_chunks_name;
+	int32 job_id;
+	BgwPolicyMoveChunks *existing;
+	Hypertable *hypertable;
+	Cache *hcache;
+	Oid ht_oid = PG_ARGISNULL(0) ? InvalidOid : PG_GETARG_OID(0);
+	Name destination_tablespace = PG_ARGISNULL(2) ? NULL : PG_GETARG_NAME(2);
+	Name index_destination_tablespace = PG_ARGISNULL(3) ? NULL : PG_GETARG_NAME(3);
+	Name reorder_index_name = PG_ARGISNULL(4) ? NULL : PG_GETARG_NAME(4);
+	bool if_not_exists = PG_ARGISNULL(5) ? false : PG_GETARG_BOOL(5);
+	BgwPolicyMoveChunks policy = { .fd = { 0 } };
+
+	license_enforce_enterprise_enabled();
+	license_print_expiration_warning_if_needed();
+
+	if (!OidIsValid(ht_oid) || PG_ARGISNULL(1) || destination_tablespace == NULL)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("hypertable, older_than and destination_tablespace cannot be NULL")));
+
+	/* The tablespaces must exist, privileges are checked when chunks are moved */
+	get_tablespace_oid(NameStr(*destination_tablespace), false);
+	if (index_destination_tablespace != NULL)
+		get_tablespace_oid(NameStr(*index_destination_tablespace), false);
+
+	policy.fd.hypertable_id = ts_hypertable_relid_to_id(ht_oid);
+	policy.fd.older_than = *PG_GETARG_INTERVAL_P(1);
+	policy.fd.destination_tablespace = *destination_tablespace;
+	policy.fd.index_destination_tablespace =
+		index_destination_tablespace != NULL ? *index_destination_tablespace :
+											   *destination_tablespace;
+	if (reorder_index_name != NULL)
+		policy.fd.reorder_index_name = *reorder_index_name;
+
+	hcache = ts_hypertable_cache_pin();
+	hypertable = ts_hypertable_cache_get_entry(hcache, ht_oid);
+	/* First verify that the hypertable corresponds to a valid table */
+	if (hypertable == NULL)
+		ereport(ERROR,
+				(errcode(ERRCODE_TS_HYPERTABLE_NOT_EXIST),
+				 errmsg("could not add move_chunks policy because \"%s\" is not a hypertable",
+						get_rel_name(ht_oid))));
+
+	/* Now verify that the index is an actual index on that hypertable */
+	if (reorder_index_name != NULL)
+		check_valid_reorder_index(hypertable, reorder_index_name);
+
+	/* Make sure that an existing policy doesn't exist on this hypertable */
+	existing = ts_bgw_policy_move_chunks_find_by_hypertable(hypertable->fd.id);
+
+	if (existing != NULL)
+	{
+		if (!if_not_exists)
+		{
+			ts_cache_release(hcache);
+			ereport(ERROR,
+					(errcode(ERRCODE_DUPLICATE_OBJECT),
+					 errmsg("move chunks policy already exists for hypertable \"%s\"",
+							get_rel_name(ht_oid))));
+		}
+
+		if (!move_chunks_policy_equal(existing, &policy))
+		{
+			elog(WARNING,
+				 "could not add move_chunks policy due to existing policy on hypertable with "
+				 "different arguments");
+			ts_cache_release(hcache);
+			return -1;
+		}
+
+		/* If all arguments are the same, do nothing */
+		ereport(NOTICE,
+				(errmsg("move chunks policy already exists on hypertable \"%s\", skipping",
+						get_rel_name(ht_oid))));
+		ts_cache_release(hcache);
+		return -1;
+	}
+
+	/* validate that the open dimension uses a time type */
+	ts_dimension_open_typecheck(INTERVALOID,
+								hyperspace_get_open_dimension(hypertable->space, 0)->fd.column_type,
+								"add_move_chunks_policy");
+
+	ts_cache_release(hcache);
+
+	/* Next, insert a new job into jobs table */
+	namestrcpy(&application_name, "Move Chunks Background Job");
+	namestrcpy(&move_chunks_name, "move_chunks");
+	job_id = ts_bgw_job_insert_relation(&application_name,
+										&move_chunks_name,
+										DEFAULT_SCHEDULE_INTERVAL,
+										DEFAULT_MAX_RUNTIME,
+										DEFAULT_MAX_RETRIES,
+										DEFAULT_RETRY_PERIOD);
+
+	/* Now, insert a new row in the move_chunks args table */
+	policy.fd.job_id = job_id;
+	ts_bgw_policy_move_chunks_insert(&policy);
+
+	PG_RETURN_INT32(job_id);
+}
+
+Datum
+move_chunks_remove_policy(PG_FUNCTION_ARGS)
+{
+	Oid hypertable_oid = PG_GETARG_OID(0);
+	bool if_exists = PG_GETARG_BOOL(1);
+
+	/* Remove the job, then remove the policy */
+	int ht_id = ts_hypertable_relid_to_id(hypertable_oid);
+	BgwPolicyMoveChunks *policy = ts_bgw_policy_move_chunks_find_by_hypertable(ht_id);
+
+	license_enforce_enterprise_enabled();
+	license_print_expiration_warning_if_needed();
+
+	if (policy == NULL)
+	{
+		if (!if_exists)
+			ereport(ERROR,
+					(errcode(ERRCODE_UNDEFINED_OBJECT),
+					 errmsg("cannot remove move chunks policy, no such policy exists")));
+		else
+		{
+			ereport(NOTICE,
+					(errmsg("move chunks policy does not exist on hypertable \"%s\", skipping",
+							get_rel_name(hypertable_oid))));
+			PG_RETURN_NULL();
+		}
+	}
+
+	ts_bgw_job_delete_by_id(policy->fd.job_id);
+
+	PG_RETURN_NULL();
+}
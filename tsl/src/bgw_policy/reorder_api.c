@@ -16,6 +16,7 @@
 
 #include "bgw/job.h"
 #include "bgw_policy/reorder.h"
+#include "chunk_index.h"
 #include "errors.h"
 #include "hypertable.h"
 #include "license.h"
@@ -84,6 +85,13 @@ check_valid_index(Hypertable *ht, Name index_name)
 			 "could not add reorder policy because the provided index is not a valid index on the "
 			 "hypertable");
 	ReleaseSysCache(idxtuple);
+
+	/* Deferred indexes are missing on the chunks at the write frontier */
+	if (ts_chunk_index_is_deferred(ht->fd.id, NameStr(*index_name)))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("could not add reorder policy because the provided index is deferred"),
+				 errhint("Use an index that is built on all chunks.")));
 }
 
 Datum
@@ -99,12 +107,14 @@ reorder_add_policy(PG_FUNCTION_ARGS)
 	Oid ht_oid = PG_GETARG_OID(0);
 	Name index_name = PG_GETARG_NAME(1);
 	bool if_not_exists = PG_GETARG_BOOL(2);
+	int32 max_workers = PG_GETARG_INT32(3);
 	int32 hypertable_id = ts_hypertable_relid_to_id(ht_oid);
 	Hypertable *ht = ts_hypertable_get_by_id(hypertable_id);
 
 	BgwPolicyReorder policy = { .fd = {
 									.hypertable_id = hypertable_id,
 									.hypertable_index_name = *index_name,
+									.max_workers = max_workers,
 								} };
 
 	license_enforce_enterprise_enabled();
@@ -120,6 +130,11 @@ reorder_add_policy(PG_FUNCTION_ARGS)
 	/* Now verify that the index is an actual index on that hypertable */
 	check_valid_index(ht, index_name);
 
+	if (max_workers < 1)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("could not add reorder policy because max_workers must be at least 1")));
+
 	/* Make sure that an existing policy doesn't exist on this hypertable */
 	existing = ts_bgw_policy_reorder_find_by_hypertable(ts_hypertable_relid_to_id(ht_oid));
 
@@ -133,7 +148,8 @@ reorder_add_policy(PG_FUNCTION_ARGS)
 
 		if (!DatumGetBool(DirectFunctionCall2(nameeq,
 											  NameGetDatum(&existing->fd.hypertable_index_name),
-											  NameGetDatum(index_name))))
+											  NameGetDatum(index_name))) ||
+			existing->fd.max_workers != max_workers)
 		{
 			elog(WARNING,
 				 "could not add reorder policy due to existing policy on hypertable with different "
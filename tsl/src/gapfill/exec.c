@@ -715,9 +715,19 @@ gapfill_end(CustomScanState *node)
 static void
 gapfill_rescan(CustomScanState *node)
 {
+	GapFillState *state = (GapFillState *) node;
+	GapFillColumnStateUnion column;
+	int i;
+
 #if PG96
 	node->ss.ps.ps_TupFromTlist = false;
 #endif
+	foreach_column(column.base, i, state)
+	{
+		if (column.base->ctype == INTERPOLATE_COLUMN)
+			gapfill_interpolate_rescan(column.interpolate);
+	}
+
 	if (node->custom_ps != NIL)
 	{
 		ExecReScan(linitial(node->custom_ps));
@@ -1170,7 +1180,15 @@ gapfill_aggref_mutator(Node *node, void *context)
 Datum
 gapfill_exec_expr(GapFillState *state, Expr *expr, bool *isnull)
 {
-	ExprState *exprstate = ExecInitExpr(expr, &state->csstate.ss.ps);
+	return gapfill_exec_exprstate(state, ExecInitExpr(expr, &state->csstate.ss.ps), isnull);
+}
+
+/*
+ * Execute already initialized expression and return result of expression
+ */
+Datum
+gapfill_exec_exprstate(GapFillState *state, ExprState *exprstate, bool *isnull)
+{
 	ExprContext *exprcontext = GetPerTupleExprContext(state->csstate.ss.ps.state);
 
 	exprcontext->ecxt_scantuple = state->scanslot;
@@ -107,6 +107,7 @@ typedef struct GapFillState
 Node *gapfill_state_create(CustomScan *);
 Expr *gapfill_adjust_varnos(GapFillState *state, Expr *expr);
 Datum gapfill_exec_expr(GapFillState *state, Expr *expr, bool *isnull);
+Datum gapfill_exec_exprstate(GapFillState *state, ExprState *exprstate, bool *isnull);
 int64 gapfill_datum_get_internal(Datum, Oid);
 
 #endif /* TIMESCALEDB_GAPFILL_EXEC_H */
@@ -7,6 +7,8 @@
 #include <postgres.h>
 #include <access/htup_details.h>
 #include <catalog/pg_type.h>
+#include <optimizer/clauses.h>
+#include <optimizer/var.h>
 #include <utils/builtins.h>
 #include <utils/datum.h>
 #include <utils/typcache.h>
@@ -17,6 +19,21 @@
 
 #define INTERPOLATE(x, x0, x1, y0, y1) (((y0) * ((x1) - (x)) + (y1) * ((x) - (x0))) / ((x1) - (x0)))
 
+static GapFillInterpolateLookup *
+gapfill_lookup_create(GapFillState *state, Expr *expr)
+{
+	GapFillInterpolateLookup *lookup = palloc0(sizeof(GapFillInterpolateLookup));
+
+	expr = gapfill_adjust_varnos(state, expr);
+
+	lookup->correlated =
+		pull_var_clause((Node *) expr, 0) != NIL || contain_volatile_functions((Node *) expr);
+	lookup->exprstate = ExecInitExpr(expr, &state->csstate.ss.ps);
+	lookup->sample.isnull = true;
+
+	return lookup;
+}
+
 /*
  * gapfill_interpolate_initialize gets called when plan is initialized for every interpolate column
  */
@@ -28,10 +45,22 @@ gapfill_interpolate_initialize(GapFillInterpolateColumnState *interpolate, GapFi
 	interpolate->next.isnull = true;
 	if (list_length(((FuncExpr *) function)->args) > 1)
 		interpolate->lookup_before =
-			gapfill_adjust_varnos(state, lsecond(((FuncExpr *) function)->args));
+			gapfill_lookup_create(state, lsecond(((FuncExpr *) function)->args));
 	if (list_length(((FuncExpr *) function)->args) > 2)
 		interpolate->lookup_after =
-			gapfill_adjust_varnos(state, lthird(((FuncExpr *) function)->args));
+			gapfill_lookup_create(state, lthird(((FuncExpr *) function)->args));
+}
+
+/*
+ * gapfill_interpolate_rescan gets called when the gapfill node is rescanned
+ */
+void
+gapfill_interpolate_rescan(GapFillInterpolateColumnState *column)
+{
+	if (column->lookup_before)
+		column->lookup_before->valid = false;
+	if (column->lookup_after)
+		column->lookup_after->valid = false;
 }
 
 /*
@@ -41,6 +70,11 @@ void
 gapfill_interpolate_group_change(GapFillInterpolateColumnState *column, int64 time, Datum value,
 								 bool isnull)
 {
+	if (column->lookup_before && column->lookup_before->correlated)
+		column->lookup_before->valid = false;
+	if (column->lookup_after && column->lookup_after->correlated)
+		column->lookup_after->valid = false;
+
 	column->prev.isnull = true;
 	column->next.isnull = isnull;
 	if (!isnull)
@@ -86,18 +120,30 @@ gapfill_interpolate_tuple_returned(GapFillInterpolateColumnState *column, int64
  */
 static void
 gapfill_fetch_sample(GapFillState *state, GapFillInterpolateColumnState *column,
-					 GapFillInterpolateSample *sample, Expr *lookup)
+					 GapFillInterpolateSample *result, GapFillInterpolateLookup *lookup)
 {
+	GapFillInterpolateSample *sample = &lookup->sample;
 	HeapTupleHeader th;
 	HeapTupleData tuple;
 	TupleDesc tupdesc;
 	Datum value;
 	bool isnull;
-	Datum datum = gapfill_exec_expr(state, lookup, &isnull);
+	Datum datum;
+
+	/* reuse result of previous evaluation */
+	if (lookup->valid)
+	{
+		*result = *sample;
+		return;
+	}
+
+	lookup->valid = true;
+	datum = gapfill_exec_exprstate(state, lookup->exprstate, &isnull);
 
 	if (isnull)
 	{
 		sample->isnull = true;
+		*result = *sample;
 		return;
 	}
 
@@ -142,6 +188,8 @@ gapfill_fetch_sample(GapFillState *state, GapFillInterpolateColumnState *column,
 	}
 
 	DecrTupleDescRefCount(tupdesc);
+
+	*result = *sample;
 }
 
 /*
@@ -15,16 +15,30 @@ typedef struct GapFillInterpolateSample
 	bool isnull;
 } GapFillInterpolateSample;
 
+/*
+ * Out of bounds lookup for interpolation. The lookup is evaluated at most
+ * once per group. Lookups that do not reference any group column return
+ * the same sample for every group so they are only evaluated once per scan.
+ */
+typedef struct GapFillInterpolateLookup
+{
+	ExprState *exprstate;
+	bool correlated; /* references columns of the current group */
+	bool valid;		 /* sample holds the result of the lookup */
+	GapFillInterpolateSample sample;
+} GapFillInterpolateLookup;
+
 typedef struct GapFillInterpolateColumnState
 {
 	GapFillColumnState base;
-	Expr *lookup_before;
-	Expr *lookup_after;
+	GapFillInterpolateLookup *lookup_before;
+	GapFillInterpolateLookup *lookup_after;
 	GapFillInterpolateSample prev;
 	GapFillInterpolateSample next;
 } GapFillInterpolateColumnState;
 
 void gapfill_interpolate_initialize(GapFillInterpolateColumnState *, GapFillState *, FuncExpr *);
+void gapfill_interpolate_rescan(GapFillInterpolateColumnState *);
 void gapfill_interpolate_group_change(GapFillInterpolateColumnState *, int64, Datum, bool);
 void gapfill_interpolate_tuple_fetched(GapFillInterpolateColumnState *, int64, Datum, bool);
 void gapfill_interpolate_tuple_returned(GapFillInterpolateColumnState *, int64, Datum, bool);
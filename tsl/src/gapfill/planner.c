@@ -11,10 +11,15 @@
 #include <optimizer/pathnode.h>
 #include <optimizer/paths.h>
 #include <optimizer/planner.h>
+#include <optimizer/clauses.h>
+#include <optimizer/tlist.h>
 #include <utils/lsyscache.h>
+#include <utils/selfuncs.h>
 #include <parser/parse_func.h>
 
+#include "compat.h"
 #include "license.h"
+#include "planner_import.h"
 #include "gapfill/gapfill.h"
 #include "gapfill/planner.h"
 #include "gapfill/exec.h"
@@ -114,6 +119,46 @@ gapfill_correct_order(PlannerInfo *root, Path *subpath, FuncExpr *func)
 	return false;
 }
 
+/*
+ * Build the pathkeys for the order the GapFill node needs its input in:
+ * all the group columns in the order of the GROUP BY clause followed by
+ * time_bucket_gapfill ASC.
+ */
+static List *
+gapfill_sort_pathkeys(PlannerInfo *root, FuncExpr *func)
+{
+	List *new_order = NIL;
+	ListCell *lc;
+	PathKey *pk_func = NULL;
+
+	foreach (lc, root->group_pathkeys)
+	{
+		PathKey *pk = lfirst(lc);
+		EquivalenceMember *em = linitial(pk->pk_eclass->ec_members);
+
+		if (!pk_func && IsA(em->em_expr, FuncExpr) &&
+			((FuncExpr *) em->em_expr)->funcid == func->funcid)
+		{
+			if (BTLessStrategyNumber == pk->pk_strategy)
+				pk_func = pk;
+			else
+				pk_func = make_canonical_pathkey(root,
+												 pk->pk_eclass,
+												 pk->pk_opfamily,
+												 BTLessStrategyNumber,
+												 pk->pk_nulls_first);
+		}
+		else
+			new_order = lappend(new_order, pk);
+	}
+	if (!pk_func)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("no top level time_bucket_gapfill in group by clause")));
+
+	return lappend(new_order, pk_func);
+}
+
 /* Create a gapfill plan node in the form of a CustomScan node. The
  * purpose of this plan node is to insert tuples for missing groups.
  *
@@ -235,39 +280,12 @@ gapfill_path_create(PlannerInfo *root, Path *subpath, FuncExpr *func)
 
 	if (!gapfill_correct_order(root, subpath, func))
 	{
-		List *new_order = NIL;
-		ListCell *lc;
-		PathKey *pk_func = NULL;
-
 		/* subpath does not have correct order */
-		foreach (lc, root->group_pathkeys)
-		{
-			PathKey *pk = lfirst(lc);
-			EquivalenceMember *em = linitial(pk->pk_eclass->ec_members);
-
-			if (!pk_func && IsA(em->em_expr, FuncExpr) &&
-				((FuncExpr *) em->em_expr)->funcid == func->funcid)
-			{
-				if (BTLessStrategyNumber == pk->pk_strategy)
-					pk_func = pk;
-				else
-					pk_func = make_canonical_pathkey(root,
-													 pk->pk_eclass,
-													 pk->pk_opfamily,
-													 BTLessStrategyNumber,
-													 pk->pk_nulls_first);
-			}
-			else
-				new_order = lappend(new_order, pk);
-		}
-		if (!pk_func)
-			ereport(ERROR,
-					(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
-					 errmsg("no top level time_bucket_gapfill in group by clause")));
-
-		new_order = lappend(new_order, pk_func);
-		subpath = (Path *)
-			create_sort_path(root, subpath->parent, subpath, new_order, root->limit_tuples);
+		subpath = (Path *) create_sort_path(root,
+											subpath->parent,
+											subpath,
+											gapfill_sort_pathkeys(root, func),
+											root->limit_tuples);
 	}
 
 	path->cpath.path.startup_cost = subpath->startup_cost;
@@ -279,11 +297,119 @@ gapfill_path_create(PlannerInfo *root, Path *subpath, FuncExpr *func)
 	return &path->cpath.path;
 }
 
+/*
+ * Add a parallel aggregation path that produces its output in the order
+ * required by the GapFill node.
+ *
+ * The grouping paths postgres creates are ordered by the GROUP BY clause. If
+ * time_bucket_gapfill is not the last element of that order, the GapFill node
+ * has to sort the finalized aggregation result in the leader process. Sorting
+ * the input of the partial aggregation in gapfill order instead lets the
+ * workers do the sort and the leader only needs to merge:
+ *
+ * GapFill
+ *   ->  Finalize GroupAggregate
+ *         ->  Gather Merge
+ *               ->  Partial GroupAggregate
+ *                     ->  Sort (group columns, time_bucket_gapfill)
+ *                           ->  Parallel scan
+ *
+ * The GapFill node itself stays in the leader since workers do not see
+ * all the time buckets of a group.
+ */
+static void
+gapfill_add_parallel_path(PlannerInfo *root, RelOptInfo *input_rel, RelOptInfo *group_rel,
+						  FuncExpr *func)
+{
+#if !PG96
+	Query *parse = root->parse;
+	PathTarget *target = root->upper_targets[UPPERREL_GROUP_AGG];
+	PathTarget *partial_target;
+	AggClauseCosts agg_costs;
+	AggClauseCosts agg_partial_costs;
+	AggClauseCosts agg_final_costs;
+	List *pathkeys;
+	List *group_exprs;
+	Path *path;
+	double total_rows;
+	double d_num_groups;
+	double d_num_partial_groups;
+
+	if (input_rel == NULL || !group_rel->consider_parallel || input_rel->partial_pathlist == NIL ||
+		parse->groupingSets || !parse->hasAggs || !grouping_is_sortable(parse->groupClause))
+		return;
+
+	pathkeys = gapfill_sort_pathkeys(root, func);
+
+	/* postgres already created paths in this order */
+	if (compare_pathkeys(pathkeys, root->group_pathkeys) == PATHKEYS_EQUAL)
+		return;
+
+	MemSet(&agg_costs, 0, sizeof(AggClauseCosts));
+	get_agg_clause_costs(root, (Node *) target->exprs, AGGSPLIT_SIMPLE, &agg_costs);
+	get_agg_clause_costs(root, parse->havingQual, AGGSPLIT_SIMPLE, &agg_costs);
+
+	if (agg_costs.hasNonPartial || agg_costs.hasNonSerial || agg_costs.numOrderedAggs > 0)
+		return;
+
+	partial_target = ts_make_partial_grouping_target(root, target);
+
+	MemSet(&agg_partial_costs, 0, sizeof(AggClauseCosts));
+	MemSet(&agg_final_costs, 0, sizeof(AggClauseCosts));
+	get_agg_clause_costs(root,
+						 (Node *) partial_target->exprs,
+						 AGGSPLIT_INITIAL_SERIAL,
+						 &agg_partial_costs);
+	get_agg_clause_costs(root, (Node *) target->exprs, AGGSPLIT_FINAL_DESERIAL, &agg_final_costs);
+	get_agg_clause_costs(root, parse->havingQual, AGGSPLIT_FINAL_DESERIAL, &agg_final_costs);
+
+	path = linitial(input_rel->partial_pathlist);
+	group_exprs = get_sortgrouplist_exprs(parse->groupClause, parse->targetList);
+	d_num_partial_groups = estimate_num_groups(root, group_exprs, path->rows, NULL);
+	d_num_groups = estimate_num_groups(root, group_exprs, input_rel->rows, NULL);
+
+	if (!pathkeys_contained_in(pathkeys, path->pathkeys))
+		path = (Path *) create_sort_path(root, input_rel, path, pathkeys, -1.0);
+
+	path = (Path *) create_agg_path(root,
+									group_rel,
+									path,
+									partial_target,
+									AGG_SORTED,
+									AGGSPLIT_INITIAL_SERIAL,
+									parse->groupClause,
+									NIL,
+									&agg_partial_costs,
+									d_num_partial_groups);
+
+	total_rows = path->rows * path->parallel_workers;
+	path = (Path *) create_gather_merge_path(root,
+											 group_rel,
+											 path,
+											 partial_target,
+											 pathkeys,
+											 NULL,
+											 &total_rows);
+
+	add_path(group_rel,
+			 (Path *) create_agg_path(root,
+									  group_rel,
+									  path,
+									  target,
+									  AGG_SORTED,
+									  AGGSPLIT_FINAL_DESERIAL,
+									  parse->groupClause,
+									  (List *) parse->havingQual,
+									  &agg_final_costs,
+									  d_num_groups));
+#endif
+}
+
 /*
  * Prepend GapFill node to every group_rel path
  */
 void
-plan_add_gapfill(PlannerInfo *root, RelOptInfo *group_rel)
+plan_add_gapfill(PlannerInfo *root, RelOptInfo *input_rel, RelOptInfo *group_rel)
 {
 	ListCell *lc;
 	Query *parse = root->parse;
@@ -321,7 +447,11 @@ plan_add_gapfill(PlannerInfo *root, RelOptInfo *group_rel)
 
 	if (context.num_calls == 1)
 	{
-		List *copy = group_rel->pathlist;
+		List *copy;
+
+		gapfill_add_parallel_path(root, input_rel, group_rel, context.call);
+
+		copy = group_rel->pathlist;
 		group_rel->pathlist = NIL;
 		group_rel->cheapest_total_path = NULL;
 		group_rel->cheapest_startup_path = NULL;
@@ -9,7 +9,7 @@
 #include <postgres.h>
 #include <optimizer/planner.h>
 
-void plan_add_gapfill(PlannerInfo *, RelOptInfo *);
+void plan_add_gapfill(PlannerInfo *, RelOptInfo *, RelOptInfo *);
 
 typedef struct GapFillPath
 {
@@ -19,6 +19,8 @@
 #include "bgw_policy/job.h"
 #include "bgw_policy/reorder_api.h"
 #include "bgw_policy/drop_chunks_api.h"
+#include "bgw_policy/move_chunks_api.h"
+#include "bgw_policy/deferred_indexes_api.h"
 
 #ifdef PG_MODULE_MAGIC
 PG_MODULE_MAGIC;
@@ -53,10 +55,15 @@ CrossModuleFunctions tsl_cm_functions = {
 	.module_shutdown_hook = module_shutdown,
 	.add_tsl_license_info_telemetry = tsl_telemetry_add_license_info,
 	.bgw_policy_job_execute = tsl_bgw_policy_job_execute,
+	.bgw_policy_job_execute_helper = tsl_bgw_policy_job_execute_helper,
 	.add_drop_chunks_policy = drop_chunks_add_policy,
 	.add_reorder_policy = reorder_add_policy,
+	.add_move_chunks_policy = move_chunks_add_policy,
+	.add_deferred_indexes_policy = deferred_indexes_add_policy,
 	.remove_drop_chunks_policy = drop_chunks_remove_policy,
 	.remove_reorder_policy = reorder_remove_policy,
+	.remove_move_chunks_policy = move_chunks_remove_policy,
+	.remove_deferred_indexes_policy = deferred_indexes_remove_policy,
 	.create_upper_paths_hook = tsl_create_upper_paths_hook,
 	.gapfill_marker = gapfill_marker,
 	.gapfill_int16_time_bucket = gapfill_int16_time_bucket,
@@ -67,6 +74,7 @@ CrossModuleFunctions tsl_cm_functions = {
 	.gapfill_timestamptz_time_bucket = gapfill_timestamptz_time_bucket,
 	.alter_job_schedule = bgw_policy_alter_job_schedule,
 	.reorder_chunk = tsl_reorder_chunk,
+	.move_chunk = tsl_move_chunk,
 };
 
 TS_FUNCTION_INFO_V1(ts_module_init);
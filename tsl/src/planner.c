@@ -12,5 +12,5 @@ tsl_create_upper_paths_hook(PlannerInfo *root, UpperRelationKind stage, RelOptIn
 							RelOptInfo *output_rel)
 {
 	if (UPPERREL_GROUP_AGG == stage)
-		plan_add_gapfill(root, output_rel);
+		plan_add_gapfill(root, input_rel, output_rel);
 }
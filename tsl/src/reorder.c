@@ -17,6 +17,7 @@
 
 #include "access/amapi.h"
 #include "access/multixact.h"
+#include "access/parallel.h"
 #include "access/relscan.h"
 #include "access/rewriteheap.h"
 #include "access/transam.h"
@@ -30,17 +31,23 @@
 #include "catalog/index.h"
 #include "catalog/namespace.h"
 #include "catalog/objectaccess.h"
+#include "catalog/pg_tablespace.h"
 #include "catalog/toasting.h"
 #include "commands/cluster.h"
 #include "commands/tablecmds.h"
+#include "commands/tablespace.h"
 #include "commands/vacuum.h"
 #include "miscadmin.h"
 #include "nodes/pg_list.h"
 #include "optimizer/planner.h"
+#include "pgstat.h"
 #include "storage/bufmgr.h"
+#include "storage/condition_variable.h"
+#include "storage/dsm.h"
 #include "storage/lmgr.h"
 #include "storage/predicate.h"
 #include "storage/smgr.h"
+#include "storage/spin.h"
 #include "utils/acl.h"
 #include "utils/fmgroids.h"
 #include "utils/guc.h"
@@ -57,17 +64,62 @@
 #include <compat.h>
 #include <chunk.h>
 #include <chunk_index.h>
+#include <extension_constants.h>
+#include <guc.h>
 #include <hypertable_cache.h>
 #include <indexing.h>
 
 #include "license.h"
 #include "reorder.h"
 
-extern void timescale_reorder_rel(Oid tableOid, Oid indexOid, bool verbose, Oid wait_id);
+extern void timescale_reorder_rel(Oid tableOid, Oid indexOid, bool verbose, Oid wait_id,
+								  Oid destination_tablespace, Oid index_tablespace);
 
 #define REORDER_ACCESS_EXCLUSIVE_DEADLOCK_TIMEOUT "101000"
 
-static void timescale_rebuild_relation(Relation OldHeap, Oid indexOid, bool verbose, Oid wait_id);
+/* How long to poll for the lock needed for the final swap before waiting */
+#define REORDER_SWAP_LOCK_POLL_TIMEOUT_MS 1000
+#define REORDER_SWAP_LOCK_POLL_MAX_SLEEP_MS 50
+
+/*
+ * Vacuum-style cost-based delay of the copy, see
+ * timescaledb.reorder_cost_delay. While VacuumCostActive is set the buffer
+ * manager charges page accesses to VacuumCostBalance, using the
+ * vacuum_cost_page_* settings, and we sleep once the balance reaches
+ * vacuum_cost_limit. This is vacuum_delay_point with our own delay.
+ */
+static void
+reorder_cost_delay_begin(void)
+{
+	VacuumCostActive = (ts_guc_reorder_cost_delay > 0);
+	VacuumCostBalance = 0;
+}
+
+static void
+reorder_cost_delay_end(void)
+{
+	VacuumCostActive = false;
+}
+
+static void
+reorder_delay_point(void)
+{
+	if (VacuumCostActive && !InterruptPending && VacuumCostBalance >= VacuumCostLimit)
+	{
+		int msec = ts_guc_reorder_cost_delay * VacuumCostBalance / VacuumCostLimit;
+
+		if (msec > ts_guc_reorder_cost_delay * 4)
+			msec = ts_guc_reorder_cost_delay * 4;
+
+		pg_usleep(msec * 1000L);
+		VacuumCostBalance = 0;
+
+		CHECK_FOR_INTERRUPTS();
+	}
+}
+
+static void timescale_rebuild_relation(Relation OldHeap, Oid indexOid, bool verbose, Oid wait_id,
+									   Oid destination_tablespace, Oid index_tablespace);
 static void copy_heap_data(Oid OIDNewHeap, Oid OIDOldHeap, Oid OIDOldIndex, bool verbose,
 						   bool *pSwapToastByContent, TransactionId *pFreezeXid,
 						   MultiXactId *pCutoffMulti);
@@ -79,11 +131,15 @@ static void finish_heap_swaps(Oid OIDOldHeap, Oid OIDNewHeap, List *old_index_oi
 							  List *new_index_oids, bool swap_toast_by_content, bool is_internal,
 							  TransactionId frozenXid, MultiXactId cutoffMulti, Oid wait_id);
 
+static void reorder_lock_relation_for_swap(Oid relid);
+
 static void swap_relation_files(Oid r1, Oid r2, bool swap_toast_by_content, bool is_internal,
 								TransactionId frozenXid, MultiXactId cutoffMulti);
 
 static bool chunk_get_reorder_index(Hypertable *ht, Chunk *chunk, Oid index_relid,
 									ChunkIndexMapping *cim_out);
+static void reorder_chunk_internal(Oid chunk_id, Oid index_id, bool reorder, bool verbose,
+								   Oid wait_id, Oid destination_tablespace, Oid index_tablespace);
 
 Datum
 tsl_reorder_chunk(PG_FUNCTION_ARGS)
@@ -107,8 +163,111 @@ tsl_reorder_chunk(PG_FUNCTION_ARGS)
 	PG_RETURN_VOID();
 }
 
+Datum
+tsl_move_chunk(PG_FUNCTION_ARGS)
+{
+	Oid chunk_id = PG_ARGISNULL(0) ? InvalidOid : PG_GETARG_OID(0);
+	Oid destination_tablespace =
+		PG_ARGISNULL(1) ? InvalidOid : get_tablespace_oid(NameStr(*PG_GETARG_NAME(1)), false);
+	Oid index_destination_tablespace =
+		PG_ARGISNULL(2) ? InvalidOid : get_tablespace_oid(NameStr(*PG_GETARG_NAME(2)), false);
+	Oid index_id = PG_ARGISNULL(3) ? InvalidOid : PG_GETARG_OID(3);
+	bool verbose = PG_ARGISNULL(4) ? false : PG_GETARG_BOOL(4);
+
+	/* used for debugging purposes only see finish_heap_swaps */
+	Oid wait_id = PG_NARGS() < 6 || PG_ARGISNULL(5) ? InvalidOid : PG_GETARG_OID(5);
+
+	license_print_expiration_warning_if_needed();
+
+	/*
+	 * Allow move in transactions for testing purposes only
+	 */
+	if (!OidIsValid(wait_id))
+		PreventInTransactionBlock(true, "move");
+
+	move_chunk(chunk_id,
+			   destination_tablespace,
+			   index_destination_tablespace,
+			   index_id,
+			   verbose,
+			   wait_id);
+	PG_RETURN_VOID();
+}
+
 void
 reorder_chunk(Oid chunk_id, Oid index_id, bool verbose, Oid wait_id)
+{
+	reorder_chunk_internal(chunk_id, index_id, true, verbose, wait_id, InvalidOid, InvalidOid);
+}
+
+static void
+check_tablespace_for_move(Oid tablespace)
+{
+	AclResult aclresult;
+
+	if (tablespace == GLOBALTABLESPACE_OID)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("cannot move a chunk to tablespace \"%s\"",
+						get_tablespace_name(tablespace))));
+
+	/* The database's default tablespace is always usable */
+	if (tablespace == MyDatabaseTableSpace)
+		return;
+
+	aclresult = pg_tablespace_aclcheck(tablespace, GetUserId(), ACL_CREATE);
+
+	if (aclresult != ACLCHECK_OK)
+		aclcheck_error(aclresult,
+#if PG96 || PG10
+					   ACL_KIND_TABLESPACE,
+#else
+					   OBJECT_TABLESPACE,
+#endif
+					   get_tablespace_name(tablespace));
+}
+
+/*
+ * Move a chunk, and its indexes, to other tablespaces. The chunk is rewritten
+ * into a new heap in the destination tablespace and the new heap's files are
+ * swapped in at the end, the same way as in reorder, so the chunk stays
+ * readable while it is copied. If an index is given, the chunk is reordered
+ * on that index in the same pass. The indexes are moved to
+ * index_destination_tablespace, or to destination_tablespace if none is
+ * given.
+ */
+void
+move_chunk(Oid chunk_id, Oid destination_tablespace, Oid index_destination_tablespace,
+		   Oid index_id, bool verbose, Oid wait_id)
+{
+	if (!OidIsValid(destination_tablespace))
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("must provide a valid destination tablespace")));
+
+	if (!OidIsValid(index_destination_tablespace))
+		index_destination_tablespace = destination_tablespace;
+
+	check_tablespace_for_move(destination_tablespace);
+	if (index_destination_tablespace != destination_tablespace)
+		check_tablespace_for_move(index_destination_tablespace);
+
+	reorder_chunk_internal(chunk_id,
+						   index_id,
+						   OidIsValid(index_id),
+						   verbose,
+						   wait_id,
+						   destination_tablespace,
+						   index_destination_tablespace);
+}
+
+/*
+ * Rewrite a chunk, reordering it if reorder is set, and moving it if
+ * destination_tablespace is valid.
+ */
+static void
+reorder_chunk_internal(Oid chunk_id, Oid index_id, bool reorder, bool verbose, Oid wait_id,
+					   Oid destination_tablespace, Oid index_tablespace)
 {
 	Chunk *chunk;
 	Cache *hcache;
@@ -150,6 +309,18 @@ reorder_chunk(Oid chunk_id, Oid index_id, bool verbose, Oid wait_id)
 					   get_rel_name(main_table_relid));
 	}
 
+	if (!reorder)
+	{
+		timescale_reorder_rel(chunk_id,
+							  InvalidOid,
+							  verbose,
+							  wait_id,
+							  destination_tablespace,
+							  index_tablespace);
+		ts_cache_release(hcache);
+		return;
+	}
+
 	if (!chunk_get_reorder_index(ht, chunk, index_id, &cim))
 	{
 		ts_cache_release(hcache);
@@ -175,7 +346,12 @@ reorder_chunk(Oid chunk_id, Oid index_id, bool verbose, Oid wait_id)
 	 */
 	ts_chunk_index_mark_clustered(cim.chunkoid, cim.indexoid);
 	/* TODO allow users to set verbosity? */
-	timescale_reorder_rel(cim.chunkoid, cim.indexoid, verbose, wait_id);
+	timescale_reorder_rel(cim.chunkoid,
+						  cim.indexoid,
+						  verbose,
+						  wait_id,
+						  destination_tablespace,
+						  index_tablespace);
 	ts_cache_release(hcache);
 }
 
@@ -219,15 +395,21 @@ chunk_get_reorder_index(Hypertable *ht, Chunk *chunk, Oid index_relid, ChunkInde
  * the OID of the original table is preserved.
  *
  * Indexes are rebuilt in the same manner.
+ *
+ * If destination_tablespace is valid, the new table is created in that
+ * tablespace, which moves the table there, and its indexes are created in
+ * index_tablespace. An index is then optional: without one, the table is
+ * copied in physical order.
  */
 void
-timescale_reorder_rel(Oid tableOid, Oid indexOid, bool verbose, Oid wait_id)
+timescale_reorder_rel(Oid tableOid, Oid indexOid, bool verbose, Oid wait_id,
+					  Oid destination_tablespace, Oid index_tablespace)
 {
 	Relation OldHeap;
 	HeapTuple tuple;
 	Form_pg_index indexForm;
 
-	if (!OidIsValid(indexOid))
+	if (!OidIsValid(indexOid) && !OidIsValid(destination_tablespace))
 		elog(ERROR, "Reorder must specify an index.");
 
 	/* Check for user-requested abort. */
@@ -285,36 +467,41 @@ timescale_reorder_rel(Oid tableOid, Oid indexOid, bool verbose, Oid wait_id)
 				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
 				 errmsg("cannot reorder a table with OIDs.")));
 
-	/*
-	 * Check that the index still exists
-	 */
-	if (!SearchSysCacheExists1(RELOID, ObjectIdGetDatum(indexOid)))
+	if (OidIsValid(indexOid))
 	{
-		ereport(WARNING, (errcode(ERRCODE_WARNING), errmsg("index disappeared during reorder")));
-		relation_close(OldHeap, ExclusiveLock);
-		return;
-	}
+		/*
+		 * Check that the index still exists
+		 */
+		if (!SearchSysCacheExists1(RELOID, ObjectIdGetDatum(indexOid)))
+		{
+			ereport(WARNING,
+					(errcode(ERRCODE_WARNING), errmsg("index disappeared during reorder")));
+			relation_close(OldHeap, ExclusiveLock);
+			return;
+		}
 
-	/*
-	 * Check that the index is still the one with indisclustered set.
-	 */
-	tuple = SearchSysCache1(INDEXRELID, ObjectIdGetDatum(indexOid));
-	if (!HeapTupleIsValid(tuple)) /* probably can't happen */
-	{
-		ereport(WARNING, (errcode(ERRCODE_WARNING), errmsg("invalid index heap during reorder")));
-		relation_close(OldHeap, ExclusiveLock);
-		return;
-	}
-	indexForm = (Form_pg_index) GETSTRUCT(tuple);
+		/*
+		 * Check that the index is still the one with indisclustered set.
+		 */
+		tuple = SearchSysCache1(INDEXRELID, ObjectIdGetDatum(indexOid));
+		if (!HeapTupleIsValid(tuple)) /* probably can't happen */
+		{
+			ereport(WARNING,
+					(errcode(ERRCODE_WARNING), errmsg("invalid index heap during reorder")));
+			relation_close(OldHeap, ExclusiveLock);
+			return;
+		}
+		indexForm = (Form_pg_index) GETSTRUCT(tuple);
 
-	/*
-	 * We always mark indexes as clustered when we intercept a cluster
-	 * command, if it's not marked as such here, something has gone wrong
-	 */
-	if (!indexForm->indisclustered)
-		ereport(ERROR,
-				(errcode(ERRCODE_ASSERT_FAILURE), errmsg("invalid index heap during reorder")));
-	ReleaseSysCache(tuple);
+		/*
+		 * We always mark indexes as clustered when we intercept a cluster
+		 * command, if it's not marked as such here, something has gone wrong
+		 */
+		if (!indexForm->indisclustered)
+			ereport(ERROR,
+					(errcode(ERRCODE_ASSERT_FAILURE), errmsg("invalid index heap during reorder")));
+		ReleaseSysCache(tuple);
+	}
 
 	/*
 	 * Also check for active uses of the relation in the current transaction,
@@ -323,10 +510,16 @@ timescale_reorder_rel(Oid tableOid, Oid indexOid, bool verbose, Oid wait_id)
 	CheckTableNotInUse(OldHeap, "CLUSTER");
 
 	/* Check heap and index are valid to cluster on */
-	check_index_is_clusterable(OldHeap, indexOid, true, ExclusiveLock);
+	if (OidIsValid(indexOid))
+		check_index_is_clusterable(OldHeap, indexOid, true, ExclusiveLock);
 
 	/* timescale_rebuild_relation does all the dirty work */
-	timescale_rebuild_relation(OldHeap, indexOid, verbose, wait_id);
+	timescale_rebuild_relation(OldHeap,
+							   indexOid,
+							   verbose,
+							   wait_id,
+							   destination_tablespace,
+							   index_tablespace);
 
 	/* NB: timescale_rebuild_relation does heap_close() on OldHeap */
 }
@@ -336,14 +529,20 @@ timescale_reorder_rel(Oid tableOid, Oid indexOid, bool verbose, Oid wait_id)
  *
  * OldHeap: table to rebuild --- must be opened and exclusive-locked!
  * indexOid: index to cluster by, or InvalidOid to rewrite in physical order.
+ * destination_tablespace: tablespace of the rebuilt table, or InvalidOid to
+ * keep the current one.
+ * index_tablespace: tablespace of the rebuilt indexes, or InvalidOid to
+ * pick it like for any other chunk index.
  *
  * NB: this routine closes OldHeap at the right time; caller should not.
  */
 static void
-timescale_rebuild_relation(Relation OldHeap, Oid indexOid, bool verbose, Oid wait_id)
+timescale_rebuild_relation(Relation OldHeap, Oid indexOid, bool verbose, Oid wait_id,
+						   Oid destination_tablespace, Oid index_tablespace)
 {
 	Oid tableOid = RelationGetRelid(OldHeap);
-	Oid tableSpace = OldHeap->rd_rel->reltablespace;
+	Oid tableSpace = OidIsValid(destination_tablespace) ? destination_tablespace :
+														  OldHeap->rd_rel->reltablespace;
 	Oid OIDNewHeap;
 	List *old_index_oids;
 	List *new_index_oids;
@@ -353,7 +552,8 @@ timescale_rebuild_relation(Relation OldHeap, Oid indexOid, bool verbose, Oid wai
 	MultiXactId cutoffMulti;
 
 	/* Mark the correct index as clustered */
-	mark_index_clustered(OldHeap, indexOid, true);
+	if (OidIsValid(indexOid))
+		mark_index_clustered(OldHeap, indexOid, true);
 
 	/* Remember info about rel before closing OldHeap */
 	relpersistence = OldHeap->rd_rel->relpersistence;
@@ -365,16 +565,35 @@ timescale_rebuild_relation(Relation OldHeap, Oid indexOid, bool verbose, Oid wai
 	OIDNewHeap = make_new_heap(tableOid, tableSpace, relpersistence, ExclusiveLock);
 
 	/* Copy the heap data into the new table in the desired order */
-	copy_heap_data(OIDNewHeap,
-				   tableOid,
-				   indexOid,
-				   verbose,
-				   &swap_toast_by_content,
-				   &frozenXid,
-				   &cutoffMulti);
+	reorder_cost_delay_begin();
+	PG_TRY();
+	{
+		copy_heap_data(OIDNewHeap,
+					   tableOid,
+					   indexOid,
+					   verbose,
+					   &swap_toast_by_content,
+					   &frozenXid,
+					   &cutoffMulti);
+	}
+	PG_CATCH();
+	{
+		reorder_cost_delay_end();
+		PG_RE_THROW();
+	}
+	PG_END_TRY();
+	reorder_cost_delay_end();
 
-	/* Create versions of the tables indexes for the new table */
-	new_index_oids = ts_chunk_index_duplicate(tableOid, OIDNewHeap, &old_index_oids);
+	/*
+	 * Create versions of the tables indexes for the new table. Each index is
+	 * built with its own scan of the new heap (in parallel on PG11, subject
+	 * to max_parallel_maintenance_workers). The sorted output of
+	 * copy_heap_data cannot be fed to the btree loader of the clustering
+	 * index instead: the heap rewrite does not return the TIDs of the tuples
+	 * it writes, and the btree spool API is private since PG11.
+	 */
+	new_index_oids =
+		ts_chunk_index_duplicate(tableOid, OIDNewHeap, &old_index_oids, index_tablespace);
 
 	/*
 	 * Swap the physical files of the target and transient tables, then
@@ -391,6 +610,309 @@ timescale_rebuild_relation(Relation OldHeap, Oid indexOid, bool verbose, Oid wai
 					  wait_id);
 }
 
+#if PG11
+
+/*
+ * Parallel scan and sort of the old heap.
+ *
+ * When the chunk is reordered using a sort, the scan of the old heap and the
+ * sort can be done by parallel workers, the same way PostgreSQL builds a
+ * btree index in parallel (see nbtsort.c). Each worker scans a disjoint set
+ * of blocks of the old heap through a parallel heap scan, and sorts the
+ * tuples it sees into its own run of a parallel tuplesort. The leader merges
+ * the runs when it reads out the sorted tuples and writes them to the new
+ * heap. The new heap is still written by the leader only, since the heap
+ * rewrite module cannot be shared.
+ *
+ * The leader leaves parallel mode as soon as the workers are done, before it
+ * writes anything, since writing the new heap can insert into its TOAST
+ * table. The runs of the workers are therefore kept in a shared file set
+ * attached to a segment of its own, which outlives the parallel context.
+ *
+ * Dead tuples can be skipped by the workers without telling the rewrite
+ * module: with a sort, no tuple is written before the scan is complete, so
+ * rewrite_heap_dead_tuple() could never resolve anything during the scan.
+ */
+#define PARALLEL_KEY_REORDER_SHARED UINT64CONST(0xA000000000000001)
+
+typedef struct ReorderShared
+{
+	Oid heaprelid;
+	Oid indexrelid;
+	TransactionId oldest_xmin;
+	dsm_handle sortseg;
+
+	/*
+	 * Sort memory of each worker, set once it is known how many workers were
+	 * launched. Protected by the mutex, like the tuple counts of all workers.
+	 */
+	slock_t mutex;
+	ConditionVariable sortmem_cv;
+	int sortmem;
+	double num_tuples;
+	double tups_vacuumed;
+	double tups_recently_dead;
+
+	/* Must come last, since it has a variable-length snapshot */
+	ParallelHeapScanDescData heapdesc;
+} ReorderShared;
+
+typedef struct ReorderParallelState
+{
+	ParallelContext *pcxt;
+	ReorderShared *shared;
+	dsm_segment *sortseg;
+	SortCoordinate coordinate;
+	int nworkers_launched;
+} ReorderParallelState;
+
+extern PGDLLEXPORT void reorder_parallel_main(dsm_segment *seg, shm_toc *toc);
+
+/*
+ * Start the workers that scan and sort the old heap. Returns NULL if a
+ * parallel scan should not be used, or no worker could be launched, in which
+ * case the caller scans the old heap itself.
+ */
+static ReorderParallelState *
+reorder_begin_parallel(Relation OldHeap, Relation OldIndex, TransactionId OldestXmin)
+{
+	ParallelContext *pcxt;
+	ReorderShared *shared;
+	dsm_segment *sortseg;
+	Sharedsort *sharedsort;
+	ReorderParallelState *pstate;
+	Size estshared;
+	int nworkers;
+
+	nworkers = plan_create_index_workers(RelationGetRelid(OldHeap), RelationGetRelid(OldIndex));
+
+	if (nworkers <= 0)
+		return NULL;
+
+	sortseg = dsm_create(tuplesort_estimate_shared(nworkers), DSM_CREATE_NULL_IF_MAXSEGMENTS);
+
+	if (sortseg == NULL)
+		return NULL;
+
+	sharedsort = dsm_segment_address(sortseg);
+	tuplesort_initialize_shared(sharedsort, nworkers, sortseg);
+
+	EnterParallelMode();
+	pcxt = CreateParallelContext(TS_LIBDIR TSL_LIBRARY_NAME "-" TIMESCALEDB_VERSION_MOD,
+								 "reorder_parallel_main",
+								 nworkers,
+								 true);
+
+	estshared =
+		add_size(offsetof(ReorderShared, heapdesc), heap_parallelscan_estimate(SnapshotAny));
+	shm_toc_estimate_chunk(&pcxt->estimator, estshared);
+	shm_toc_estimate_keys(&pcxt->estimator, 1);
+
+	InitializeParallelDSM(pcxt);
+
+	shared = shm_toc_allocate(pcxt->toc, estshared);
+	shared->heaprelid = RelationGetRelid(OldHeap);
+	shared->indexrelid = RelationGetRelid(OldIndex);
+	shared->oldest_xmin = OldestXmin;
+	shared->sortseg = dsm_segment_handle(sortseg);
+	SpinLockInit(&shared->mutex);
+	ConditionVariableInit(&shared->sortmem_cv);
+	shared->sortmem = 0;
+	shared->num_tuples = 0;
+	shared->tups_vacuumed = 0;
+	shared->tups_recently_dead = 0;
+	heap_parallelscan_initialize(&shared->heapdesc, OldHeap, SnapshotAny);
+
+	shm_toc_insert(pcxt->toc, PARALLEL_KEY_REORDER_SHARED, shared);
+
+	LaunchParallelWorkers(pcxt);
+
+	if (pcxt->nworkers_launched == 0)
+	{
+		DestroyParallelContext(pcxt);
+		ExitParallelMode();
+		dsm_detach(sortseg);
+		return NULL;
+	}
+
+	/*
+	 * Split maintenance_work_mem between the workers that were actually
+	 * launched and the merge done by the leader.
+	 */
+	SpinLockAcquire(&shared->mutex);
+	shared->sortmem = maintenance_work_mem / (pcxt->nworkers_launched + 1);
+	SpinLockRelease(&shared->mutex);
+	ConditionVariableBroadcast(&shared->sortmem_cv);
+
+	pstate = palloc0(sizeof(ReorderParallelState));
+	pstate->pcxt = pcxt;
+	pstate->shared = shared;
+	pstate->sortseg = sortseg;
+	pstate->nworkers_launched = pcxt->nworkers_launched;
+	pstate->coordinate = palloc0(sizeof(SortCoordinateData));
+	pstate->coordinate->isWorker = false;
+	pstate->coordinate->nParticipants = pcxt->nworkers_launched;
+	pstate->coordinate->sharedsort = sharedsort;
+
+	return pstate;
+}
+
+/*
+ * Wait for all workers to finish their scan and sort, add up their tuple
+ * counts and leave parallel mode. The leader's tuplesort can only be
+ * completed after this.
+ */
+static void
+reorder_wait_parallel(ReorderParallelState *pstate, double *num_tuples, double *tups_vacuumed,
+					  double *tups_recently_dead)
+{
+	WaitForParallelWorkersToFinish(pstate->pcxt);
+
+	*num_tuples += pstate->shared->num_tuples;
+	*tups_vacuumed += pstate->shared->tups_vacuumed;
+	*tups_recently_dead += pstate->shared->tups_recently_dead;
+
+	DestroyParallelContext(pstate->pcxt);
+	pstate->pcxt = NULL;
+	pstate->shared = NULL;
+	ExitParallelMode();
+}
+
+/*
+ * The workers' sorted runs are removed when the last process detaches from
+ * their segment, so it must only be detached after the leader's tuplesort has
+ * ended.
+ */
+static void
+reorder_end_parallel(ReorderParallelState *pstate)
+{
+	dsm_detach(pstate->sortseg);
+}
+
+void
+reorder_parallel_main(dsm_segment *seg, shm_toc *toc)
+{
+	ReorderShared *shared;
+	dsm_segment *sortseg;
+	Sharedsort *sharedsort;
+	SortCoordinate coordinate;
+	Relation heap;
+	Relation index;
+	HeapScanDesc scan;
+	Tuplesortstate *tuplesort;
+	HeapTuple tuple;
+	int sortmem;
+	double num_tuples = 0, tups_vacuumed = 0, tups_recently_dead = 0;
+
+	shared = shm_toc_lookup(toc, PARALLEL_KEY_REORDER_SHARED, false);
+
+	sortseg = dsm_attach(shared->sortseg);
+	if (sortseg == NULL)
+		ereport(ERROR,
+				(errcode(ERRCODE_OBJECT_NOT_IN_PREREQUISITE_STATE),
+				 errmsg("could not map dynamic shared memory segment")));
+	sharedsort = dsm_segment_address(sortseg);
+	tuplesort_attach_shared(sharedsort, sortseg);
+
+	/* Wait for the leader to tell how much sort memory this worker gets */
+	ConditionVariablePrepareToSleep(&shared->sortmem_cv);
+	for (;;)
+	{
+		SpinLockAcquire(&shared->mutex);
+		sortmem = shared->sortmem;
+		SpinLockRelease(&shared->mutex);
+
+		if (sortmem > 0)
+			break;
+
+		ConditionVariableSleep(&shared->sortmem_cv, WAIT_EVENT_PARALLEL_CREATE_INDEX_SCAN);
+	}
+	ConditionVariableCancelSleep();
+
+	/* The leader holds an ExclusiveLock, which is shared with its workers */
+	heap = heap_open(shared->heaprelid, AccessShareLock);
+	index = index_open(shared->indexrelid, AccessShareLock);
+
+	coordinate = palloc0(sizeof(SortCoordinateData));
+	coordinate->isWorker = true;
+	coordinate->nParticipants = -1;
+	coordinate->sharedsort = sharedsort;
+
+	tuplesort =
+		tuplesort_begin_cluster(RelationGetDescr(heap), index, sortmem, coordinate, false);
+
+	scan = heap_beginscan_parallel(heap, &shared->heapdesc);
+
+	/* The cost delay settings are synced from the leader */
+	reorder_cost_delay_begin();
+
+	while ((tuple = heap_getnext(scan, ForwardScanDirection)) != NULL)
+	{
+		Buffer buf = scan->rs_cbuf;
+		bool isdead = false;
+
+		CHECK_FOR_INTERRUPTS();
+		reorder_delay_point();
+
+		LockBuffer(buf, BUFFER_LOCK_SHARE);
+
+		switch (HeapTupleSatisfiesVacuum(tuple, shared->oldest_xmin, buf))
+		{
+			case HEAPTUPLE_DEAD:
+				isdead = true;
+				break;
+			case HEAPTUPLE_RECENTLY_DEAD:
+				tups_recently_dead += 1;
+				break;
+			case HEAPTUPLE_LIVE:
+				break;
+			case HEAPTUPLE_INSERT_IN_PROGRESS:
+				elog(ERROR,
+					 "concurrent insert in progress within table \"%s\"",
+					 RelationGetRelationName(heap));
+				break;
+			case HEAPTUPLE_DELETE_IN_PROGRESS:
+				elog(ERROR,
+					 "concurrent delete in progress within table \"%s\"",
+					 RelationGetRelationName(heap));
+				break;
+			default:
+				elog(ERROR, "unexpected HeapTupleSatisfiesVacuum result");
+				break;
+		}
+
+		LockBuffer(buf, BUFFER_LOCK_UNLOCK);
+
+		if (isdead)
+		{
+			tups_vacuumed += 1;
+			continue;
+		}
+
+		num_tuples += 1;
+		tuplesort_putheaptuple(tuplesort, tuple);
+	}
+
+	heap_endscan(scan);
+	reorder_cost_delay_end();
+
+	/* Write this worker's sorted run for the leader to merge */
+	tuplesort_performsort(tuplesort);
+	tuplesort_end(tuplesort);
+
+	SpinLockAcquire(&shared->mutex);
+	shared->num_tuples += num_tuples;
+	shared->tups_vacuumed += tups_vacuumed;
+	shared->tups_recently_dead += tups_recently_dead;
+	SpinLockRelease(&shared->mutex);
+
+	index_close(index, AccessShareLock);
+	heap_close(heap, AccessShareLock);
+	dsm_detach(sortseg);
+}
+
+#endif /* PG11 */
+
 /*
  * Do the physical copying of heap data.
  *
@@ -425,6 +947,9 @@ copy_heap_data(Oid OIDNewHeap, Oid OIDOldHeap, Oid OIDOldIndex, bool verbose,
 	BlockNumber num_pages;
 	int elevel = verbose ? INFO : DEBUG2;
 	PGRUsage ru0;
+#if PG11
+	ReorderParallelState *pstate = NULL;
+#endif
 
 	pg_rusage_init(&ru0);
 
@@ -557,13 +1082,19 @@ copy_heap_data(Oid OIDNewHeap, Oid OIDOldHeap, Oid OIDOldIndex, bool verbose,
 	else
 		use_sort = false;
 
+#if PG11
+	/* Let parallel workers scan and sort the OldHeap if possible */
+	if (use_sort)
+		pstate = reorder_begin_parallel(OldHeap, OldIndex, OldestXmin);
+#endif
+
 	/* Set up sorting if wanted */
 	if (use_sort)
 		tuplesort = tuplesort_begin_cluster(oldTupDesc,
 											OldIndex,
 											maintenance_work_mem,
 #if PG11
-											NULL,
+											pstate != NULL ? pstate->coordinate : NULL,
 #endif
 											false);
 	else
@@ -580,6 +1111,14 @@ copy_heap_data(Oid OIDNewHeap, Oid OIDOldHeap, Oid OIDOldIndex, bool verbose,
 		indexScan = index_beginscan(OldHeap, OldIndex, SnapshotAny, 0, 0);
 		index_rescan(indexScan, NULL, 0, NULL, 0);
 	}
+#if PG11
+	else if (pstate != NULL)
+	{
+		/* The workers scan the OldHeap */
+		heapScan = NULL;
+		indexScan = NULL;
+	}
+#endif
 	else
 	{
 		heapScan = heap_beginscan(OldHeap, SnapshotAny, 0, (ScanKey) NULL);
@@ -593,14 +1132,23 @@ copy_heap_data(Oid OIDNewHeap, Oid OIDOldHeap, Oid OIDOldIndex, bool verbose,
 						get_namespace_name(RelationGetNamespace(OldHeap)),
 						RelationGetRelationName(OldHeap),
 						RelationGetRelationName(OldIndex))));
+#if PG11
+	else if (pstate != NULL)
+		ereport(elevel,
+				(errmsg("reordering \"%s.%s\" using parallel sequential scan and sort with %d "
+						"workers",
+						get_namespace_name(RelationGetNamespace(OldHeap)),
+						RelationGetRelationName(OldHeap),
+						pstate->nworkers_launched)));
+#endif
 	else if (tuplesort != NULL)
 		ereport(elevel,
 				(errmsg("reordering \"%s.%s\" using sequential scan and sort",
 						get_namespace_name(RelationGetNamespace(OldHeap)),
 						RelationGetRelationName(OldHeap))));
 	else
-		ereport(ERROR,
-				(errmsg("tried to use a reorder without an index \"%s.%s\"",
+		ereport(elevel,
+				(errmsg("copying \"%s.%s\" using sequential scan",
 						get_namespace_name(RelationGetNamespace(OldHeap)),
 						RelationGetRelationName(OldHeap))));
 
@@ -608,15 +1156,17 @@ copy_heap_data(Oid OIDNewHeap, Oid OIDOldHeap, Oid OIDOldIndex, bool verbose,
 	 * Scan through the OldHeap, either in OldIndex order or sequentially;
 	 * copy each tuple into the NewHeap, or transiently to the tuplesort
 	 * module.  Note that we don't bother sorting dead tuples (they won't get
-	 * to the new table anyway).
+	 * to the new table anyway). In parallel mode, the workers have already
+	 * done this.
 	 */
-	for (;;)
+	while (indexScan != NULL || heapScan != NULL)
 	{
 		HeapTuple tuple;
 		Buffer buf;
 		bool isdead;
 
 		CHECK_FOR_INTERRUPTS();
+		reorder_delay_point();
 
 		if (indexScan != NULL)
 		{
@@ -717,6 +1267,10 @@ copy_heap_data(Oid OIDNewHeap, Oid OIDOldHeap, Oid OIDOldIndex, bool verbose,
 	 */
 	if (tuplesort != NULL)
 	{
+#if PG11
+		if (pstate != NULL)
+			reorder_wait_parallel(pstate, &num_tuples, &tups_vacuumed, &tups_recently_dead);
+#endif
 		tuplesort_performsort(tuplesort);
 
 		for (;;)
@@ -727,6 +1281,7 @@ copy_heap_data(Oid OIDNewHeap, Oid OIDOldHeap, Oid OIDOldIndex, bool verbose,
 #endif
 
 			CHECK_FOR_INTERRUPTS();
+			reorder_delay_point();
 
 			tuple = tuplesort_getheaptuple(tuplesort,
 										   /* forward= */ true
@@ -746,6 +1301,11 @@ copy_heap_data(Oid OIDNewHeap, Oid OIDOldHeap, Oid OIDOldIndex, bool verbose,
 		}
 
 		tuplesort_end(tuplesort);
+
+#if PG11
+		if (pstate != NULL)
+			reorder_end_parallel(pstate);
+#endif
 	}
 
 	/* Write out any remaining tuples, and fsync if needed */
@@ -800,6 +1360,43 @@ copy_heap_data(Oid OIDNewHeap, Oid OIDOldHeap, Oid OIDOldIndex, bool verbose,
 	CommandCounterIncrement();
 }
 
+/*
+ * Acquire the AccessExclusiveLock needed to swap in the reordered relation.
+ *
+ * The table data is copied while holding an ExclusiveLock, so readers are
+ * only blocked by the final swap. However, waiting for the AccessExclusiveLock
+ * in the lock queue blocks every new reader of the chunk until the readers
+ * that are already running have finished, which can take a long time if there
+ * is a long-running query. Instead we repeatedly try to get the lock without
+ * waiting, so readers can proceed until there is a moment when the chunk is
+ * not in use.
+ *
+ * Nobody can detect a deadlock involving a lock that we are only polling for,
+ * so after a while we fall back to waiting in the lock queue. Note that a
+ * transaction that started waiting on us while we were polling has already
+ * run its deadlock check, so such a deadlock is resolved by aborting the
+ * reorder rather than the other transaction.
+ */
+static void
+reorder_lock_relation_for_swap(Oid relid)
+{
+	long waited_ms = 0;
+	long sleep_ms = 1;
+
+	while (waited_ms < REORDER_SWAP_LOCK_POLL_TIMEOUT_MS)
+	{
+		if (ConditionalLockRelationOid(relid, AccessExclusiveLock))
+			return;
+
+		CHECK_FOR_INTERRUPTS();
+		pg_usleep(sleep_ms * 1000L);
+		waited_ms += sleep_ms;
+		sleep_ms = Min(sleep_ms * 2, REORDER_SWAP_LOCK_POLL_MAX_SLEEP_MS);
+	}
+
+	LockRelationOid(relid, AccessExclusiveLock);
+}
+
 /*
  * Remove the transient table that was built by make_new_heap, and finish
  * cleaning up (including rebuilding all indexes on the old heap).
@@ -864,7 +1461,8 @@ finish_heap_swaps(Oid OIDOldHeap, Oid OIDNewHeap, List *old_index_oids, List *ne
 				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
 				 errmsg("could not set deadlock_timeout guc.")));
 
-	oldHeapRel = heap_open(OIDOldHeap, AccessExclusiveLock);
+	reorder_lock_relation_for_swap(OIDOldHeap);
+	oldHeapRel = heap_open(OIDOldHeap, NoLock);
 
 	/*
 	 * All predicate locks on the tuples or pages are about to be made
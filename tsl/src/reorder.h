@@ -15,5 +15,8 @@
 
 extern Datum tsl_reorder_chunk(PG_FUNCTION_ARGS);
 extern void reorder_chunk(Oid chunk_id, Oid index_id, bool verbose, Oid wait_id);
+extern Datum tsl_move_chunk(PG_FUNCTION_ARGS);
+extern void move_chunk(Oid chunk_id, Oid destination_tablespace, Oid index_destination_tablespace,
+					   Oid index_id, bool verbose, Oid wait_id);
 
 #endif /* TIMESCALEDB_TSL_REORDER_H */
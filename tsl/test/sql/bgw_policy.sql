@@ -19,6 +19,11 @@ RETURNS VOID
 AS :TSL_MODULE_PATHNAME, 'ts_test_auto_drop_chunks'
 LANGUAGE C VOLATILE STRICT;
 
+CREATE OR REPLACE FUNCTION test_move_chunks(job_id INTEGER)
+RETURNS VOID
+AS :TSL_MODULE_PATHNAME, 'ts_test_auto_move_chunks'
+LANGUAGE C VOLATILE STRICT;
+
 \c :TEST_DBNAME :ROLE_DEFAULT_PERM_USER
 
 CREATE FUNCTION check_chunk_oid(chunk_id REGCLASS, chunk_oid REGCLASS) RETURNS BOOLEAN LANGUAGE PLPGSQL AS
@@ -223,3 +228,61 @@ SELECT create_hypertable('test_table_int', 'time', chunk_time_interval => 1);
 -- we cannot add a drop_chunks policy on a table whose open dimension is not time
 select add_drop_chunks_policy('test_table_int', INTERVAL '4 months', true);
 \set ON_ERROR_STOP 1
+
+-- Now simulate the move_chunks policy running automatically
+\c :TEST_DBNAME :ROLE_SUPERUSER
+SET client_min_messages = ERROR;
+DROP TABLESPACE IF EXISTS tablespace1;
+SET client_min_messages = NOTICE;
+CREATE TABLESPACE tablespace1 OWNER :ROLE_DEFAULT_PERM_USER LOCATION :TEST_TABLESPACE1_PATH;
+\c :TEST_DBNAME :ROLE_DEFAULT_PERM_USER
+
+CREATE TABLE test_table_move(time timestamptz, location int);
+SELECT create_hypertable('test_table_move', 'time', chunk_time_interval => INTERVAL '1 day');
+CREATE INDEX ON test_table_move (location);
+INSERT INTO test_table_move VALUES
+    ('2018-01-01 01:00', 3),
+    ('2018-01-01 02:00', 1),
+    ('2018-01-01 03:00', 2),
+    ('2018-01-02 01:00', 2),
+    (now(), 1);
+
+CREATE VIEW test_table_move_tablespaces AS
+SELECT c.id, t.spcname FROM _timescaledb_catalog.chunk c
+INNER JOIN _timescaledb_catalog.hypertable h ON (c.hypertable_id = h.id)
+INNER JOIN pg_class pgc ON (pgc.oid = format('%I.%I', c.schema_name, c.table_name)::regclass)
+LEFT JOIN pg_tablespace t ON (pgc.reltablespace = t.oid)
+WHERE h.table_name = 'test_table_move';
+
+SELECT format('%I.%I', c.schema_name, c.table_name) AS chunk
+FROM _timescaledb_catalog.chunk c
+INNER JOIN _timescaledb_catalog.hypertable h ON (c.hypertable_id = h.id)
+WHERE h.table_name = 'test_table_move'
+ORDER BY c.id LIMIT 1 \gset oldest_
+
+select add_move_chunks_policy('test_table_move', INTERVAL '1 month', 'tablespace1', reorder_index_name => 'test_table_move_location_idx') as move_job_id \gset
+
+-- Each call moves one of the two chunks older than a month
+select test_move_chunks(:move_job_id);
+SELECT spcname, count(*) FROM test_table_move_tablespaces GROUP BY spcname ORDER BY spcname;
+select test_move_chunks(:move_job_id);
+SELECT spcname, count(*) FROM test_table_move_tablespaces GROUP BY spcname ORDER BY spcname;
+
+-- The chunks were reordered on the policy's index when they were moved
+SELECT ctid, location FROM :oldest_chunk ORDER BY ctid;
+
+-- Should not move anything, because the remaining chunk is too new
+select test_move_chunks(:move_job_id);
+
+-- Should fail rather than move the chunk without reordering it when the
+-- reorder index no longer exists
+SELECT move_chunk(:'oldest_chunk', 'pg_default');
+DROP INDEX test_table_move_location_idx;
+\set ON_ERROR_STOP 0
+select test_move_chunks(:move_job_id);
+\set ON_ERROR_STOP 1
+SELECT spcname, count(*) FROM test_table_move_tablespaces GROUP BY spcname ORDER BY spcname;
+
+DROP TABLE test_table_move;
+\c :TEST_DBNAME :ROLE_SUPERUSER
+DROP TABLESPACE tablespace1;
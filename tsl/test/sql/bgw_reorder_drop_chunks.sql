@@ -284,3 +284,60 @@ SELECT show_chunks('test_drop_chunks_table');
 --test that views work
 SELECT * FROM timescaledb_information.drop_chunks_policies;
 SELECT * FROM timescaledb_information.policy_stats;
+
+\c :TEST_DBNAME :ROLE_SUPERUSER
+TRUNCATE bgw_log;
+TRUNCATE _timescaledb_internal.bgw_job_stat;
+DELETE FROM _timescaledb_config.bgw_job;
+SELECT ts_bgw_params_reset_time();
+\c :TEST_DBNAME :ROLE_DEFAULT_PERM_USER
+
+--------------------------------------------------
+-- test reorder policy runs with helper workers --
+--------------------------------------------------
+
+CREATE TABLE test_reorder_helpers_table(time int, chunk_id int);
+SELECT create_hypertable('test_reorder_helpers_table', 'time', chunk_time_interval => 1);
+
+-- These inserts should create 4 different chunks
+INSERT INTO test_reorder_helpers_table SELECT t, t FROM generate_series(1, 4) t;
+
+-- the job reorders the first chunk itself and hands the next two to helpers
+select add_reorder_policy('test_reorder_helpers_table', 'test_reorder_helpers_table_time_idx', max_workers => 3) as reorder_helpers_job_id \gset
+
+select * from _timescaledb_config.bgw_policy_reorder where job_id=:reorder_helpers_job_id;
+
+SELECT ts_bgw_db_scheduler_test_run_and_wait_for_scheduler_finish(25);
+
+SELECT * FROM sorted_bgw_log;
+
+-- job ran once, successfully
+SELECT job_id, last_run_success, total_runs, total_successes, total_failures, total_crashes
+    FROM _timescaledb_internal.bgw_job_stat
+    where job_id=:reorder_helpers_job_id;
+
+-- three chunks clustered, each recorded by the worker that reordered it
+SELECT indexrelid::regclass, indisclustered
+    FROM pg_index
+    WHERE indisclustered = true AND indrelid IN (SELECT show_chunks('test_reorder_helpers_table')::oid)
+    ORDER BY 1;
+
+SELECT chunk_id, num_times_job_run
+    FROM _timescaledb_internal.bgw_policy_chunk_stats
+    WHERE job_id=:reorder_helpers_job_id
+    ORDER BY chunk_id;
+
+-- the helpers gave back their worker slots, so the catchup run can start and
+-- reorder the last chunk
+SELECT ts_bgw_db_scheduler_test_run_and_wait_for_scheduler_finish(25, 25);
+
+SELECT * FROM sorted_bgw_log;
+
+SELECT job_id, last_run_success, total_runs, total_successes, total_failures, total_crashes
+    FROM _timescaledb_internal.bgw_job_stat
+    where job_id=:reorder_helpers_job_id;
+
+SELECT indexrelid::regclass, indisclustered
+    FROM pg_index
+    WHERE indisclustered = true AND indrelid IN (SELECT show_chunks('test_reorder_helpers_table')::oid)
+    ORDER BY 1;
@@ -0,0 +1,91 @@
+-- This file and its contents are licensed under the Timescale License.
+-- Please see the included NOTICE for copyright information and
+-- LICENSE-TIMESCALE for a copy of the license.
+
+\c :TEST_DBNAME :ROLE_SUPERUSER
+CREATE OR REPLACE FUNCTION test_deferred_indexes(job_id INTEGER)
+RETURNS VOID
+AS :TSL_MODULE_PATHNAME, 'ts_test_auto_deferred_indexes'
+LANGUAGE C VOLATILE STRICT;
+\c :TEST_DBNAME :ROLE_DEFAULT_PERM_USER
+
+CREATE TABLE deferred_test(time timestamptz NOT NULL, device int, temp float);
+SELECT create_hypertable('deferred_test', 'time', chunk_time_interval => INTERVAL '1 day');
+INSERT INTO deferred_test VALUES
+    ('2018-01-01 01:00', 1, 1.0),
+    ('2018-01-02 01:00', 2, 2.0);
+
+CREATE VIEW chunk_indexes AS
+SELECT c.relname AS chunk, i.relname AS index
+FROM pg_index x
+INNER JOIN pg_class c ON (c.oid = x.indrelid)
+INNER JOIN pg_class i ON (i.oid = x.indexrelid)
+WHERE c.relnamespace = '_timescaledb_internal'::regnamespace
+ORDER BY c.relname, i.relname;
+
+-- deferred indexes are not built on the chunks at the write frontier
+CREATE INDEX deferred_test_device_idx ON deferred_test (device) WITH (timescaledb.deferred);
+SELECT * FROM _timescaledb_catalog.deferred_index;
+SELECT * FROM chunk_indexes;
+
+-- nor on new chunks at the frontier, while backfilled chunks get all indexes
+INSERT INTO deferred_test VALUES ('2018-01-03 01:00', 3, 3.0);
+INSERT INTO deferred_test VALUES ('2017-12-30 01:00', 4, 4.0);
+SELECT * FROM chunk_indexes;
+
+\set ON_ERROR_STOP 0
+CREATE UNIQUE INDEX ON deferred_test (time, device) WITH (timescaledb.deferred);
+\set ON_ERROR_STOP 1
+
+-- deferred_indexes policies
+SELECT add_deferred_indexes_policy('deferred_test') AS job_id \gset
+-- Noop for duplicate policy
+SELECT add_deferred_indexes_policy('deferred_test', if_not_exists => true);
+\set ON_ERROR_STOP 0
+SELECT add_deferred_indexes_policy('deferred_test');
+SELECT add_deferred_indexes_policy('chunk_indexes');
+\set ON_ERROR_STOP 1
+SELECT * FROM timescaledb_information.deferred_indexes_policies;
+SELECT application_name, job_type, schedule_interval, max_runtime, max_retries, retry_period
+FROM _timescaledb_config.bgw_job WHERE job_type = 'deferred_indexes';
+
+-- the policy builds the deferred indexes on the chunks behind the frontier
+SELECT test_deferred_indexes(:job_id);
+SELECT * FROM chunk_indexes;
+SELECT chunk_id, num_times_job_run FROM _timescaledb_config.bgw_policy_chunk_stats ORDER BY chunk_id;
+SELECT test_deferred_indexes(:job_id);
+
+-- once the frontier moves on, the previous frontier chunk gets them too
+INSERT INTO deferred_test VALUES ('2018-01-04 01:00', 5, 5.0);
+SELECT test_deferred_indexes(:job_id);
+SELECT * FROM chunk_indexes;
+
+-- rows far in the future do not move the frontier away from the current time
+INSERT INTO deferred_test VALUES ('2100-01-01 01:00', 6, 6.0);
+SELECT test_deferred_indexes(:job_id);
+SELECT * FROM chunk_indexes WHERE chunk IN ('_hyper_1_5_chunk', '_hyper_1_6_chunk');
+
+-- deferred indexes are missing on some chunks, so they cannot reorder chunks
+\set ON_ERROR_STOP 0
+SELECT add_reorder_policy('deferred_test', 'deferred_test_device_idx');
+SELECT add_move_chunks_policy('deferred_test', INTERVAL '1 day', 'pg_default',
+    reorder_index_name => 'deferred_test_device_idx');
+\set ON_ERROR_STOP 1
+
+-- renamed and dropped indexes are kept in sync
+ALTER INDEX deferred_test_device_idx RENAME TO deferred_test_dev_idx;
+SELECT * FROM _timescaledb_catalog.deferred_index;
+DROP INDEX deferred_test_dev_idx;
+SELECT * FROM _timescaledb_catalog.deferred_index;
+
+SELECT remove_deferred_indexes_policy('deferred_test');
+SELECT count(*) FROM _timescaledb_config.bgw_job WHERE job_type = 'deferred_indexes';
+SELECT remove_deferred_indexes_policy('deferred_test', if_exists => true);
+
+-- deferred indexes and policies are removed with the hypertable
+CREATE INDEX ON deferred_test (temp) WITH (timescaledb.deferred);
+SELECT add_deferred_indexes_policy('deferred_test');
+DROP VIEW chunk_indexes;
+DROP TABLE deferred_test;
+SELECT count(*) FROM _timescaledb_catalog.deferred_index;
+SELECT count(*) FROM _timescaledb_config.bgw_policy_deferred_indexes;
@@ -525,6 +525,14 @@ SELECT
 FROM (VALUES (5,1,0),(5,2,0)) as v(time,device,v1)
 GROUP BY 1,2 ORDER BY 2,1;
 
+-- test interpolate with correlated lookup returning NULL for some groups
+SELECT
+  time_bucket_gapfill(5,time,0,21),
+  device,
+  interpolate(min(v1),next=>(SELECT (20,10) WHERE device = 1))
+FROM (VALUES (5,1,0),(5,2,0)) as v(time,device,v1)
+GROUP BY 1,2 ORDER BY 2,1;
+
 -- test interpolate with correlated subquery
 SELECT
   time_bucket_gapfill(5,time,0,11) AS time,
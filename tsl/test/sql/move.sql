@@ -0,0 +1,89 @@
+-- This file and its contents are licensed under the Timescale License.
+-- Please see the included NOTICE for copyright information and
+-- LICENSE-TIMESCALE for a copy of the license.
+
+\c :TEST_DBNAME :ROLE_SUPERUSER
+SET client_min_messages = ERROR;
+DROP TABLESPACE IF EXISTS tablespace1;
+DROP TABLESPACE IF EXISTS tablespace2;
+SET client_min_messages = NOTICE;
+CREATE TABLESPACE tablespace1 OWNER :ROLE_DEFAULT_PERM_USER LOCATION :TEST_TABLESPACE1_PATH;
+CREATE TABLESPACE tablespace2 OWNER :ROLE_DEFAULT_PERM_USER LOCATION :TEST_TABLESPACE2_PATH;
+\c :TEST_DBNAME :ROLE_DEFAULT_PERM_USER
+
+CREATE TABLE move_test(time timestamptz, temp float, location int);
+SELECT create_hypertable('move_test', 'time', chunk_time_interval => INTERVAL '1 day');
+CREATE INDEX ON move_test (location);
+INSERT INTO move_test VALUES
+    ('2018-01-01 01:00', 23.4, 3),
+    ('2018-01-01 02:00', 21.4, 1),
+    ('2018-01-01 03:00', 24.4, 2),
+    ('2018-01-02 01:00', 25.1, 2);
+
+CREATE VIEW chunk_tablespaces AS
+SELECT c.relname, t.spcname FROM pg_class c
+LEFT JOIN pg_tablespace t ON (c.reltablespace = t.oid)
+WHERE c.relnamespace = '_timescaledb_internal'::regnamespace AND c.relname LIKE '\_hyper%'
+ORDER BY c.relname;
+
+-- move_chunks policies
+SELECT add_move_chunks_policy('move_test', INTERVAL '1 month', 'tablespace1') AS job_id \gset
+-- Noop for duplicate policy
+SELECT add_move_chunks_policy('move_test', INTERVAL '1 month', 'tablespace1', if_not_exists => true);
+SELECT add_move_chunks_policy('move_test', INTERVAL '1 month', 'tablespace2', if_not_exists => true);
+
+\set ON_ERROR_STOP 0
+SELECT add_move_chunks_policy('move_test', INTERVAL '1 month', 'tablespace2');
+SELECT add_move_chunks_policy('move_test', INTERVAL '1 month', 'no_such_tablespace');
+SELECT add_move_chunks_policy('move_test', INTERVAL '1 month', NULL);
+SELECT add_move_chunks_policy('move_test', INTERVAL '1 month', 'tablespace1', reorder_index_name => 'bad_index');
+\set ON_ERROR_STOP 1
+
+SELECT hypertable, older_than, destination_tablespace, index_destination_tablespace, reorder_index_name, job_id
+FROM timescaledb_information.move_chunks_policies;
+SELECT remove_move_chunks_policy('move_test');
+SELECT count(*) FROM _timescaledb_config.bgw_job WHERE job_type = 'move_chunks';
+SELECT remove_move_chunks_policy('move_test', if_exists => true);
+
+-- indexes can go to their own tablespace, and chunks can be reordered when they are moved
+SELECT add_move_chunks_policy('move_test', INTERVAL '1 month', 'tablespace1', 'tablespace2', 'move_test_location_idx');
+SELECT hypertable, older_than, destination_tablespace, index_destination_tablespace, reorder_index_name, job_id
+FROM timescaledb_information.move_chunks_policies;
+SELECT application_name, job_type, schedule_interval, max_runtime, max_retries, retry_period
+FROM _timescaledb_config.bgw_job WHERE job_type = 'move_chunks';
+
+-- move a chunk and its indexes
+SELECT * FROM chunk_tablespaces;
+SELECT move_chunk('_timescaledb_internal._hyper_1_1_chunk', 'tablespace1');
+SELECT * FROM chunk_tablespaces;
+
+-- move the chunk again, reordering it, with the indexes in another tablespace
+SELECT move_chunk('_timescaledb_internal._hyper_1_1_chunk', 'tablespace2', 'tablespace1', 'move_test_location_idx');
+SELECT * FROM chunk_tablespaces;
+SELECT ctid, location FROM _timescaledb_internal._hyper_1_1_chunk ORDER BY ctid;
+SELECT * FROM move_test ORDER BY time;
+
+-- move the chunk back to the default tablespace
+SELECT move_chunk('_timescaledb_internal._hyper_1_1_chunk', 'pg_default', verbose => true);
+SELECT * FROM chunk_tablespaces;
+SELECT * FROM move_test ORDER BY time;
+
+\set ON_ERROR_STOP 0
+SELECT move_chunk('_timescaledb_internal._hyper_1_2_chunk', NULL);
+SELECT move_chunk('_timescaledb_internal._hyper_1_2_chunk', 'no_such_tablespace');
+SELECT move_chunk('_timescaledb_internal._hyper_1_2_chunk', 'pg_global');
+SELECT move_chunk(NULL, 'tablespace1');
+SELECT move_chunk('move_test', 'tablespace1');
+-- cannot move within a transaction
+BEGIN;
+SELECT move_chunk('_timescaledb_internal._hyper_1_2_chunk', 'tablespace1');
+ROLLBACK;
+\set ON_ERROR_STOP 1
+
+-- dropping the hypertable drops its policy
+DROP TABLE move_test;
+SELECT * FROM _timescaledb_config.bgw_policy_move_chunks;
+
+\c :TEST_DBNAME :ROLE_SUPERUSER
+DROP TABLESPACE tablespace1;
+DROP TABLESPACE tablespace2;
@@ -0,0 +1,49 @@
+-- This file and its contents are licensed under the Timescale License.
+-- Please see the included NOTICE for copyright information and
+-- LICENSE-TIMESCALE for a copy of the license.
+
+-- Parallel reorder (PG11 and later). The values are stored inline
+-- when inserted and moved to the TOAST table when the chunk is
+-- rewritten, so the leader has to insert TOAST values while writing
+-- the new heap. That is only allowed outside of parallel mode.
+CREATE TABLE reorder_parallel(time INTEGER, location INTEGER, value TEXT);
+ALTER TABLE reorder_parallel ALTER COLUMN value SET STORAGE PLAIN;
+SELECT create_hypertable('reorder_parallel', 'time', chunk_time_interval => 100);
+INSERT INTO reorder_parallel
+SELECT t, t % 10, repeat('x', 3000) FROM generate_series(0, 199) t;
+ALTER TABLE reorder_parallel ALTER COLUMN value SET STORAGE EXTERNAL;
+
+SELECT pg_relation_size(reltoastrelid) > 0 AS has_toast_data
+FROM pg_class WHERE oid = '_timescaledb_internal._hyper_1_1_chunk'::regclass;
+
+-- number of workers computed from the size of the chunk
+SET max_parallel_maintenance_workers TO 2;
+SET min_parallel_table_scan_size TO 0;
+SET maintenance_work_mem TO '128MB';
+SELECT reorder_chunk('_timescaledb_internal._hyper_1_1_chunk', 'reorder_parallel_time_idx', verbose => TRUE);
+
+SELECT pg_relation_size(reltoastrelid) > 0 AS has_toast_data
+FROM pg_class WHERE oid = '_timescaledb_internal._hyper_1_1_chunk'::regclass;
+SELECT time, location, length(value), pg_column_size(value)
+FROM _timescaledb_internal._hyper_1_1_chunk LIMIT 3;
+SELECT count(*), sum(length(value)) FROM _timescaledb_internal._hyper_1_1_chunk;
+
+-- number of workers set with the parallel_workers storage parameter
+RESET min_parallel_table_scan_size;
+ALTER TABLE reorder_parallel SET (parallel_workers = 1);
+SELECT reorder_chunk('_timescaledb_internal._hyper_1_2_chunk', 'reorder_parallel_time_idx', verbose => TRUE);
+
+SELECT time, location, length(value), pg_column_size(value)
+FROM _timescaledb_internal._hyper_1_2_chunk LIMIT 3;
+SELECT count(*), sum(length(value)) FROM _timescaledb_internal._hyper_1_2_chunk;
+
+-- no workers requested, the chunk is reordered serially using the
+-- previously clustered index
+SET max_parallel_maintenance_workers TO 0;
+SELECT reorder_chunk('_timescaledb_internal._hyper_1_1_chunk', verbose => TRUE);
+SELECT count(*), sum(length(value)) FROM reorder_parallel;
+
+ALTER TABLE reorder_parallel RESET (parallel_workers);
+RESET max_parallel_maintenance_workers;
+RESET maintenance_work_mem;
+DROP TABLE reorder_parallel;
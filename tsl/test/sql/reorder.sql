@@ -301,3 +301,13 @@ SELECT reorder_chunk('_timescaledb_internal._hyper_3_5_chunk', 'coids_time_idx',
 SELECT indexrelid::regclass, indisclustered
 FROM pg_index
 WHERE indisclustered = true ORDER BY 1;
+
+-- reorder with a cost-based delay like vacuum_cost_delay. A cost limit of 1
+-- makes reorder sleep for every page it touches.
+SET timescaledb.reorder_cost_delay TO 1;
+SET vacuum_cost_limit TO 1;
+SELECT reorder_chunk('_timescaledb_internal._hyper_1_1_chunk', verbose => TRUE);
+RESET vacuum_cost_limit;
+RESET timescaledb.reorder_cost_delay;
+SELECT ctid, time, temp, location
+FROM _timescaledb_internal._hyper_1_1_chunk ORDER BY ctid;
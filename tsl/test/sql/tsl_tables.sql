@@ -29,12 +29,14 @@ select add_reorder_policy('test_table', 'test_table_time_idx') as job_id \gset
 select add_reorder_policy('test_table', 'test_table_time_idx', true);
 select add_reorder_policy('test_table', 'second_index', true);
 select add_reorder_policy('test_table', 'third_index', true);
+select add_reorder_policy('test_table', 'test_table_time_idx', true, max_workers => 2);
 
 \set ON_ERROR_STOP 0
 -- Error whenever incorrect arguments are applied (must have table and index)
 select add_reorder_policy('test_table', 'bad_index');
 select add_reorder_policy('test_table', '');
 select add_reorder_policy('test_table');
+select add_reorder_policy('test_table', 'test_table_time_idx', max_workers => 0);
 
 select add_reorder_policy('test_table', 'second_index');
 select add_reorder_policy('test_table', 'third_index');
@@ -46,7 +48,8 @@ select * from _timescaledb_config.bgw_policy_reorder where job_id=:job_id;
 -- Should be 1/2 default chunk interval length
 CREATE TABLE test_table2(time timestamptz, junk int);
 SELECT create_hypertable('test_table2', 'time', chunk_time_interval=>INTERVAL '1 day');
-select add_reorder_policy('test_table2', 'test_table2_time_idx');
+select add_reorder_policy('test_table2', 'test_table2_time_idx', max_workers => 4);
+select max_workers from _timescaledb_config.bgw_policy_reorder where hypertable_id = 2;
 
 select * from _timescaledb_config.bgw_job where job_type IN ('drop_chunks', 'reorder');
 
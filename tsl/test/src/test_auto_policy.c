@@ -18,6 +18,8 @@
 
 TS_FUNCTION_INFO_V1(ts_test_auto_reorder);
 TS_FUNCTION_INFO_V1(ts_test_auto_drop_chunks);
+TS_FUNCTION_INFO_V1(ts_test_auto_move_chunks);
+TS_FUNCTION_INFO_V1(ts_test_auto_deferred_indexes);
 
 static Oid chunk_oid;
 static Oid index_oid;
@@ -66,3 +68,25 @@ ts_test_auto_drop_chunks(PG_FUNCTION_ARGS)
 
 	PG_RETURN_NULL();
 }
+
+/* Call the real move_chunks policy, without fast continue */
+Datum
+ts_test_auto_move_chunks(PG_FUNCTION_ARGS)
+{
+	BgwJob job = { .fd = { .id = PG_GETARG_INT32(0) } };
+
+	execute_move_chunks_policy(&job, false);
+
+	PG_RETURN_NULL();
+}
+
+/* Call the real deferred_indexes policy, without fast continue */
+Datum
+ts_test_auto_deferred_indexes(PG_FUNCTION_ARGS)
+{
+	BgwJob job = { .fd = { .id = PG_GETARG_INT32(0) } };
+
+	execute_deferred_indexes_policy(&job, false);
+
+	PG_RETURN_NULL();
+}